@@ -58,6 +58,11 @@ protected:
      * all OperationNodes created by CG<Base> objects
      */
     std::vector<Node*> _codeBlocks;
+    /**
+     * memory used by the OperationNodes created by this code handler
+     * (nodes with custom classes are allocated independently)
+     */
+    OperationNodePool<Base> _nodePool;
     /**
      * All CodeHandlerVector associated with this code handler
      */
@@ -104,6 +109,15 @@ protected:
      * maps dependencies between variables in _variableOrder
      */
     std::vector<std::set<Node*>> _variableDependencies;
+    /**
+     * the position in _variableOrder where each task starts
+     * (empty if the variables were not partitioned into tasks)
+     */
+    std::vector<size_t> _taskStart;
+    /**
+     * the tasks which must be completed before each task can start
+     */
+    std::vector<std::set<size_t>> _taskDependencies;
     /**
      * the order for the variable creation in the source code
      * (each level represents a different variable scope)
@@ -141,6 +155,14 @@ protected:
     bool _used;
     // a flag indicating whether or not to reuse the IDs of destroyed variables
     bool _reuseIDs;
+    // a flag indicating whether or not to merge identical operations before generating source code
+    bool _cse;
+    // a flag indicating whether or not to replace expensive operations with cheaper equivalent ones
+    bool _reduceStrength;
+    // a flag indicating whether or not the cheaper operations must produce the exact same results
+    bool _strictFloatingPoint;
+    // the approximate number of tasks used to evaluate the variables in parallel (0 or 1 means no tasks)
+    size_t _parallelTasks;
     // scope color/index counter
     ScopeIDType _scopeColorCount;
     // the current scope color/index counter
@@ -197,6 +219,94 @@ public:
      */
     inline bool isReuseVariableIDs() const;
 
+    /**
+     * Defines whether or not identical operations (same operation type,
+     * information, and arguments) should be merged into a single operation
+     * before generating source code (common subexpression elimination).
+     * Commutative operations (additions and multiplications) are compared
+     * regardless of the order of their arguments.
+     *
+     * @warning This modifies the operation graph: operations which use a
+     *          duplicated operation are changed to use its first occurrence
+     *          instead.
+     *
+     * @param eliminate whether or not to eliminate common subexpressions
+     */
+    inline void setEliminateCommonSubexpressions(bool eliminate);
+
+    /**
+     * Whether or not identical operations are merged into a single
+     * operation before generating source code.
+     */
+    inline bool isEliminateCommonSubexpressions() const;
+
+    /**
+     * Defines whether or not expensive operations should be replaced with
+     * cheaper equivalent ones before generating source code (strength
+     * reduction).
+     * For instance, pow(x, 2) becomes x * x and x / 4 becomes x * 0.25.
+     * Operations inside loops are not changed.
+     *
+     * @warning This modifies the operation graph.
+     *
+     * @param reduce whether or not to reduce the strength of operations
+     * @see setStrictFloatingPoint()
+     */
+    inline void setReduceOperationStrength(bool reduce);
+
+    /**
+     * Whether or not expensive operations are replaced with cheaper
+     * equivalent ones before generating source code.
+     */
+    inline bool isReduceOperationStrength() const;
+
+    /**
+     * Defines whether or not the strength reduction must preserve the
+     * IEEE 754 results of the original operations.
+     * When enabled (the default) only replacements which produce the same
+     * results are performed: pow(x, 2) to x * x, pow(x, -1) to 1 / x, and
+     * divisions by powers of two to multiplications.
+     * When disabled, pow() with small integer exponents is replaced with
+     * multiplications, pow(x, 0.5) with sqrt(x), all divisions by
+     * constants with multiplications by their reciprocal, and
+     * exp(a) * exp(b) with exp(a + b), which can change the last digits
+     * of the results and the results for special values (e.g. -0 and
+     * infinity).
+     *
+     * @param strict whether or not to preserve the results of the original
+     *               operations
+     */
+    inline void setStrictFloatingPoint(bool strict);
+
+    /**
+     * Whether or not the strength reduction must preserve the IEEE 754
+     * results of the original operations.
+     */
+    inline bool isStrictFloatingPoint() const;
+
+    /**
+     * Defines the approximate number of tasks (groups of variable
+     * assignments with a similar number of operations) used to evaluate
+     * the operation graph.
+     * Tasks which do not depend on each other can be evaluated at the same
+     * time if the language supports it (see
+     * Language::supportsParallelTasks()).
+     * The variable IDs are not reused when tasks are created.
+     * Operation graphs with loops, conditional scopes, atomic functions,
+     * arrays, or dependents which must be zeroed are not partitioned.
+     *
+     * @param tasks the approximate number of tasks (0 or 1 for a single
+     *              sequence of variable assignments)
+     */
+    inline void setParallelTasks(size_t tasks);
+
+    /**
+     * Provides the approximate number of tasks used to evaluate the
+     * operation graph (0 or 1 for a single sequence of variable
+     * assignments).
+     */
+    inline size_t getParallelTasks() const;
+
     /**
      * Marks the provided variables as being independent variables.
      *
@@ -618,6 +728,18 @@ protected:
 
     virtual Node* manageOperationNode(Node* code);
 
+    /**
+     * Creates a new OperationNode using memory from the node pool.
+     */
+    template<class... Args>
+    inline Node* allocateNode(Args&&... args);
+
+    /**
+     * Destroys an OperationNode and releases its memory (either to the
+     * node pool or to the heap).
+     */
+    inline void deleteNode(Node* node);
+
     inline void addVector(CodeHandlerVectorSync<Base>* v);
 
     inline void removeVector(CodeHandlerVectorSync<Base>* v);
@@ -697,6 +819,36 @@ protected:
 
     inline void reduceTemporaryVariables(ArrayView<CGB>& dependent);
 
+    /**
+     * Merges identical operations used by the dependent variables so that
+     * each one is only evaluated once (common subexpression elimination).
+     * Operations inside loops are not modified.
+     * Dependents which are duplicates of other operations are redirected
+     * to the operation which is kept.
+     *
+     * @param dependent The vector of dependent variable values
+     * @return the number of removed operations
+     */
+    inline size_t eliminateCommonSubexpressions(ArrayView<CGB>& dependent);
+
+    /**
+     * Replaces expensive operations used by the dependent variables with
+     * cheaper equivalent ones (strength reduction).
+     * Operations inside loops are not modified.
+     * Dependents which are duplicates of other operations are redirected
+     * to the operation which is kept.
+     *
+     * @param dependent The vector of dependent variable values
+     * @return the number of replaced operations
+     */
+    inline size_t reduceOperationStrength(ArrayView<CGB>& dependent);
+
+    /**
+     * Whether or not an operation has no side effects and only depends on
+     * its operation type, information, and arguments.
+     */
+    static inline bool isPureOperation(const Node& node);
+
     /**
      * Change operation order so that the total number of temporary variables is
      * reduced.
@@ -726,6 +878,19 @@ protected:
      */
     inline void determineLastTempVarUsage(Node& node);
 
+    /**
+     * Splits the variable assignments into tasks with a similar number of
+     * operations and reorders _variableOrder so that the assignments of
+     * each task are contiguous and the tasks are in a valid evaluation
+     * order.
+     * Each variable is assigned to the task of the variables which use it
+     * (processed in reverse evaluation order), so that the dependencies
+     * between tasks always point to tasks with a higher index.
+     *
+     * @return whether or not the variables were partitioned into tasks
+     */
+    inline bool partitionTasks();
+
     /**
      * Determines relations between variables with an ID
      */
@@ -38,6 +38,10 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _atomicFunctionsOrder(nullptr),
         _used(false),
         _reuseIDs(true),
+        _cse(false),
+        _reduceStrength(false),
+        _strictFloatingPoint(true),
+        _parallelTasks(0),
         _scopeColorCount(0),
         _currentScopeColor(0),
         _lang(nullptr),
@@ -72,6 +76,46 @@ inline bool CodeHandler<Base>::isReuseVariableIDs() const {
     return _reuseIDs;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::setEliminateCommonSubexpressions(bool eliminate) {
+    _cse = eliminate;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isEliminateCommonSubexpressions() const {
+    return _cse;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setReduceOperationStrength(bool reduce) {
+    _reduceStrength = reduce;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isReduceOperationStrength() const {
+    return _reduceStrength;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setStrictFloatingPoint(bool strict) {
+    _strictFloatingPoint = strict;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isStrictFloatingPoint() const {
+    return _strictFloatingPoint;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setParallelTasks(size_t tasks) {
+    _parallelTasks = tasks;
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::getParallelTasks() const {
+    return _parallelTasks;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::makeVariables(std::vector<AD<CGB> >& variables) {
     for (auto& v : variables) {
@@ -296,6 +340,13 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     _scopes.reserve(4);
     _scopes.resize(1);
     _alteredNodes.clear();
+    /**
+     * replace expensive operations (might create new nodes)
+     */
+    if (_reduceStrength) {
+        reduceOperationStrength(dependent);
+    }
+
     _evaluationOrder.adjustSize();
     _lastUsageOrder.adjustSize();
     _totalUseCount.adjustSize();
@@ -314,6 +365,13 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     }
     _used = true;
 
+    /**
+     * merge identical operations
+     */
+    if (_cse) {
+        eliminateCommonSubexpressions(dependent);
+    }
+
     /**
      * the first variable IDs are for the independent variables
      */
@@ -396,10 +454,20 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
         dependentAdded2EvaluationQueue(arg);
     }
 
+    /**
+     * Independent groups of variables (the IDs must not be shared by tasks)
+     */
+    _taskStart.clear();
+    _taskDependencies.clear();
+    bool tasks = false;
+    if (_parallelTasks > 1 && lang.supportsParallelTasks()) {
+        tasks = partitionTasks();
+    }
+
     /**
      * Reuse temporary variables
      */
-    if (_reuseIDs) {
+    if (_reuseIDs && !tasks) {
         reduceTemporaryVariables(dependent);
     }
 
@@ -436,10 +504,11 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
 
     std::unique_ptr<LanguageGenerationData<Base> > _info(new LanguageGenerationData<Base>(_independentVariables, dependent,
                                                                                           _minTemporaryVarID, _varId, _variableOrder, _variableDependencies,
+                                                                                          _taskStart, _taskDependencies,
                                                                                           nameGen,
                                                                                           atomicFunctionId2Index, atomicFunctionId2Name,
                                                                                           _atomicFunctionsMaxForward, _atomicFunctionsMaxReverse,
-                                                                                          _reuseIDs,
+                                                                                          _reuseIDs && !tasks,
                                                                                           _loops.indexes, _loops.indexRandomPatterns,
                                                                                           _loops.dependentIndexPatterns, _loops.independentIndexPatterns,
                                                                                           _totalUseCount, _scope, *_auxIterationIndexOp,
@@ -493,9 +562,10 @@ size_t CodeHandler<Base>::getTemporarySparseArraySize() const {
 template<class Base>
 void CodeHandler<Base>::reset() {
     for (Node* n : _codeBlocks) {
-        delete n;
+        deleteNode(n);
     }
     _codeBlocks.clear();
+    _nodePool.clear();
     _independentVariables.clear();
     _idCount = 1;
     _idArrayCount = 1;
@@ -523,38 +593,38 @@ inline void CodeHandler<Base>::resetNodes() {
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::cloneNode(const Node& n) {
-    return manageOperationNode(new Node(n));
+    return manageOperationNode(allocateNode(n));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op) {
-    return manageOperationNode(new Node(this, op));
+    return manageOperationNode(allocateNode(this, op));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         const Arg& arg) {
-    return manageOperationNode(new Node(this, op, arg));
+    return manageOperationNode(allocateNode(this, op, arg));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         std::vector<Arg>&& args) {
-    return manageOperationNode(new Node(this, op, std::move(args)));
+    return manageOperationNode(allocateNode(this, op, std::move(args)));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         std::vector<size_t>&& info,
                                                         std::vector<Arg>&& args) {
-    return manageOperationNode(new Node(this, op, std::move(info), std::move(args)));
+    return manageOperationNode(allocateNode(this, op, std::move(info), std::move(args)));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         const std::vector<size_t>& info,
                                                         const std::vector<Arg>& args) {
-    return manageOperationNode(new Node(this, op, info, args));
+    return manageOperationNode(allocateNode(this, op, info, args));
 }
 
 template<class Base>
@@ -633,7 +703,7 @@ inline IndexAssignOperationNode<Base>* CodeHandler<Base>::makeIndexAssignNode(No
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeIndexDclrNode(const std::string& name) {
     CPPADCG_ASSERT_KNOWN(!name.empty(), "index name cannot be empty")
-    auto* n = manageOperationNode(new Node(this, CGOpCode::IndexDeclaration));
+    auto* n = manageOperationNode(allocateNode(this, CGOpCode::IndexDeclaration));
     n->setName(name);
     return n;
 }
@@ -657,7 +727,7 @@ inline void CodeHandler<Base>::deleteManagedNodes(size_t start, size_t end) {
     end = std::min<size_t>(end, _codeBlocks.size());
 
     for (size_t i = start; i < end; ++i) {
-        delete _codeBlocks[i];
+        deleteNode(_codeBlocks[i]);
     }
     _codeBlocks.erase(_codeBlocks.begin() + start, _codeBlocks.begin() + end);
 
@@ -725,6 +795,28 @@ OperationNode<Base>* CodeHandler<Base>::manageOperationNode(Node* code) {
     return code;
 }
 
+template<class Base>
+template<class... Args>
+inline OperationNode<Base>* CodeHandler<Base>::allocateNode(Args&&... args) {
+    void* mem = _nodePool.allocate();
+    try {
+        return new(mem) Node(std::forward<Args>(args)...);
+    } catch (...) {
+        _nodePool.deallocate(mem);
+        throw;
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::deleteNode(Node* node) {
+    if (_nodePool.contains(node)) {
+        node->~Node();
+        _nodePool.deallocate(node);
+    } else {
+        delete node;
+    }
+}
+
 template<class Base>
 inline void CodeHandler<Base>::addVector(CodeHandlerVectorSync<Base>* v) {
     _managedVectors.insert(v);
@@ -1633,6 +1725,368 @@ inline void CodeHandler<Base>::addToEvaluationQueue(Node& arg) {
     varOrder.push_back(&arg);
 }
 
+template<class Base>
+inline bool CodeHandler<Base>::isPureOperation(const Node& node) {
+    switch (node.getOperationType()) {
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::eliminateCommonSubexpressions(ArrayView<CGB>& dependent) {
+
+    auto argHash = [](const Arg& a) -> size_t {
+        if (a.getOperation() != nullptr)
+            return std::hash<const Node*>()(a.getOperation());
+        return 0x9e3779b9; // all parameters share the same hash (they are compared by value)
+    };
+
+    auto argEqual = [](const Arg& a1, const Arg& a2) {
+        if (a1.getOperation() != nullptr || a2.getOperation() != nullptr)
+            return a1.getOperation() == a2.getOperation();
+        // parameters are compared by their bit pattern so that 0.0 and -0.0
+        // are not merged and identical NaNs are
+        return a1.getParameter() != nullptr && a2.getParameter() != nullptr &&
+               memcmp(a1.getParameter(), a2.getParameter(), sizeof(Base)) == 0;
+    };
+
+    auto isCommutative = [](const Node& n) {
+        CGOpCode op = n.getOperationType();
+        return (op == CGOpCode::Add || op == CGOpCode::Mul) && n.getArguments().size() == 2;
+    };
+
+    /**
+     * structural hash (operation type, information, and arguments)
+     */
+    auto nodeHash = [&](const Node* n) {
+        size_t h = std::hash<int>()(int(n->getOperationType()));
+        for (size_t i : n->getInfo()) {
+            h = h * 31 + i;
+        }
+        if (isCommutative(*n)) {
+            h = h * 31 + argHash(n->getArguments()[0]) + argHash(n->getArguments()[1]);
+        } else {
+            for (const Arg& a : n->getArguments()) {
+                h = h * 31 + argHash(a);
+            }
+        }
+        return h;
+    };
+
+    auto nodeEqual = [&](const Node* n1, const Node* n2) {
+        if (n1->getOperationType() != n2->getOperationType() ||
+            n1->getInfo() != n2->getInfo())
+            return false;
+
+        const auto& args1 = n1->getArguments();
+        const auto& args2 = n2->getArguments();
+        if (args1.size() != args2.size())
+            return false;
+
+        bool sameOrder = true;
+        for (size_t i = 0; i < args1.size() && sameOrder; ++i) {
+            sameOrder = argEqual(args1[i], args2[i]);
+        }
+        if (sameOrder)
+            return true;
+
+        return isCommutative(*n1) &&
+               argEqual(args1[0], args2[1]) && argEqual(args1[1], args2[0]);
+    };
+
+    std::unordered_set<Node*, decltype(nodeHash), decltype(nodeEqual)> unique(_codeBlocks.size(), nodeHash, nodeEqual);
+
+    // the node which replaces each node (null if it was not replaced)
+    std::vector<Node*> replacement(_codeBlocks.size(), nullptr);
+    size_t removed = 0;
+
+    auto replaceArgument = [&](OperationStackData<Base>& stackEl, Node& rep) {
+        stackEl.parent().getArguments()[stackEl.argumentIndex()] = Arg(rep);
+    };
+
+    auto nodeAnalysis = [&](OperationStackData<Base>& stackEl,
+                            OperationStack<Base>& stack) {
+        Node& node = stackEl.node();
+
+        if (isVisited(node)) {
+            Node* rep = replacement[node.getHandlerPosition()];
+            if (rep != nullptr)
+                replaceArgument(stackEl, *rep);
+            return false;
+        }
+        markVisited(node);
+
+        if (node.getOperationType() == CGOpCode::LoopEnd) {
+            return false; // operations inside loops are not changed
+        }
+
+        stack.pushNodeArguments(node, stackEl.parentNodeScope);
+        return true;
+    };
+
+    auto nodePostProcess = [&](OperationStackData<Base>& stackEl) {
+        Node& node = stackEl.node();
+
+        if (!isPureOperation(node) || node.getName() != nullptr)
+            return;
+
+        Node* rep = *unique.insert(&node).first;
+        if (rep != &node) {
+            replacement[node.getHandlerPosition()] = rep;
+            replaceArgument(stackEl, *rep);
+            removed++;
+        }
+    };
+
+    startNewOperationTreeVisit();
+
+    for (size_t i = 0; i < dependent.size(); ++i) {
+        Node* node = dependent[i].getOperationNode();
+        if (node != nullptr && !isVisited(*node)) {
+            depthFirstGraphNavigation(*node, 0, nodeAnalysis, nodePostProcess, true);
+        }
+    }
+
+    // dependents can also be duplicates of other operations
+    for (size_t i = 0; i < dependent.size(); ++i) {
+        Node* node = dependent[i].getOperationNode();
+        if (node != nullptr) {
+            Node* rep = replacement[node->getHandlerPosition()];
+            if (rep != nullptr)
+                dependent[i] = CGB(*rep);
+        }
+    }
+
+    return removed;
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::reduceOperationStrength(ArrayView<CGB>& dependent) {
+    // the largest integer exponent of pow() replaced with multiplications
+    const size_t maxIntegerExponent = 16;
+
+    /**
+     * determine the number of times each operation is used and an order
+     * where the arguments appear before the operations which use them
+     */
+    std::vector<size_t> uses(_codeBlocks.size(), 0);
+    std::vector<Node*> order;
+
+    auto addUse = [&](const Arg& a) {
+        Node* n = a.getOperation();
+        if (n == nullptr)
+            return;
+        if (n->getHandlerPosition() >= uses.size())
+            uses.resize(_codeBlocks.size(), 0);
+        uses[n->getHandlerPosition()]++;
+    };
+
+    auto nodeAnalysis = [&](OperationStackData<Base>& stackEl,
+                            OperationStack<Base>& stack) {
+        Node& node = stackEl.node();
+        uses[node.getHandlerPosition()]++;
+
+        if (isVisited(node))
+            return false;
+        markVisited(node);
+
+        if (node.getOperationType() == CGOpCode::LoopEnd) {
+            return false; // operations inside loops are not changed
+        }
+
+        stack.pushNodeArguments(node, stackEl.parentNodeScope);
+        return true;
+    };
+
+    auto nodePostProcess = [&](OperationStackData<Base>& stackEl) {
+        order.push_back(&stackEl.node());
+    };
+
+    startNewOperationTreeVisit();
+
+    for (size_t i = 0; i < dependent.size(); ++i) {
+        Node* node = dependent[i].getOperationNode();
+        if (node == nullptr)
+            continue;
+        if (isVisited(*node)) {
+            uses[node->getHandlerPosition()]++;
+        } else {
+            depthFirstGraphNavigation(*node, 0, nodeAnalysis, nodePostProcess, true);
+        }
+    }
+
+    /**
+     * utilities
+     */
+    auto constant = [](const Arg& a) -> const Base* {
+        if (a.getOperation() != nullptr)
+            return nullptr;
+        return a.getParameter();
+    };
+
+    auto isPowerOfTwo = [](const Base& c) {
+        int e;
+        Base mantissa = std::frexp(c, &e);
+        return mantissa == Base(0.5) || mantissa == Base(-0.5);
+    };
+
+    auto makeMul = [&](const Arg& a1, const Arg& a2) {
+        addUse(a1);
+        addUse(a2);
+        return Arg(*makeNode(CGOpCode::Mul, {a1, a2}));
+    };
+
+    // the two factors of x^k (k > 1) using multiplications
+    std::function<std::vector<Arg>(const Arg&, size_t)> powerFactors;
+
+    auto power = [&](const Arg& x, size_t k) {
+        if (k == 1)
+            return x;
+        std::vector<Arg> f = powerFactors(x, k);
+        return makeMul(f[0], f[1]);
+    };
+
+    powerFactors = [&](const Arg& x, size_t k) {
+        if (k % 2 == 0) {
+            Arg half = power(x, k / 2);
+            return std::vector<Arg>{half, half};
+        } else {
+            return std::vector<Arg>{power(x, k - 1), x};
+        }
+    };
+
+    /**
+     * The number of uses only considers the current dependents (other
+     * dependents and loops may also use the same nodes).
+     * It is only used to avoid creating additional exponentials and,
+     * therefore, operand nodes are never changed.
+     */
+    auto isSingleUseExp = [&](const Arg& a) {
+        Node* n = a.getOperation();
+        return n != nullptr && n->getOperationType() == CGOpCode::Exp && n->getName() == nullptr &&
+               n->getHandlerPosition() < uses.size() && uses[n->getHandlerPosition()] == 1;
+    };
+
+    /**
+     * replace operations
+     */
+    size_t replaced = 0;
+
+    for (Node* node : order) {
+        CGOpCode op = node->getOperationType();
+        std::vector<Arg>& args = node->getArguments();
+
+        if (op == CGOpCode::Pow) {
+            const Base* c = constant(args[1]);
+            if (c == nullptr)
+                continue;
+            Arg x = args[0];
+            const Base& e = *c;
+
+            if (e == Base(1.0)) {
+                node->makeAlias(x);
+            } else if (e == Base(2.0)) {
+                addUse(x);
+                node->setOperation(CGOpCode::Mul, {x, x});
+            } else if (e == Base(-1.0)) {
+                node->setOperation(CGOpCode::Div, {Arg(Base(1.0)), x});
+            } else if (_strictFloatingPoint) {
+                continue;
+            } else if (e == Base(0.5)) {
+                node->setOperation(CGOpCode::Sqrt, {x});
+            } else if (e == Base(-0.5)) {
+                node->setOperation(CGOpCode::Div, {Arg(Base(1.0)), Arg(*makeNode(CGOpCode::Sqrt, x))});
+            } else if (e >= -Base(maxIntegerExponent) && e <= Base(maxIntegerExponent) && Base(int(e)) == e) {
+                int k = int(e);
+                if (k > 0) {
+                    node->setOperation(CGOpCode::Mul, powerFactors(x, size_t(k)));
+                } else if (k < 0) {
+                    node->setOperation(CGOpCode::Div, {Arg(Base(1.0)), power(x, size_t(-k))});
+                } else {
+                    continue; // not common
+                }
+            } else {
+                continue;
+            }
+            replaced++;
+
+        } else if (op == CGOpCode::Div) {
+            const Base* c = constant(args[1]);
+            if (c != nullptr) {
+                // division by a constant
+                const Base& d = *c;
+                Base r = Base(1.0) / d;
+                if (d == Base(0.0) || !std::isfinite(d) || !std::isnormal(r))
+                    continue;
+                if (_strictFloatingPoint && !isPowerOfTwo(d))
+                    continue; // the reciprocal is not exact
+                node->setOperation(CGOpCode::Mul, {args[0], Arg(r)});
+                replaced++;
+
+            } else if (!_strictFloatingPoint && isSingleUseExp(args[0]) && isSingleUseExp(args[1]) &&
+                       args[0].getOperation() != args[1].getOperation()) {
+                // exp(a) / exp(b) = exp(a - b)
+                Arg a = args[0].getOperation()->getArguments()[0];
+                Arg b = args[1].getOperation()->getArguments()[0];
+                addUse(a);
+                addUse(b);
+                Node* e = makeNode(CGOpCode::Sub, {a, b});
+                node->setOperation(CGOpCode::Exp, {Arg(*e)});
+                replaced++;
+            }
+
+        } else if (op == CGOpCode::Mul && args.size() == 2) {
+            if (!_strictFloatingPoint && isSingleUseExp(args[0]) && isSingleUseExp(args[1]) &&
+                args[0].getOperation() != args[1].getOperation()) {
+                // exp(a) * exp(b) = exp(a + b)
+                Arg a = args[0].getOperation()->getArguments()[0];
+                Arg b = args[1].getOperation()->getArguments()[0];
+                addUse(a);
+                addUse(b);
+                Node* e = makeNode(CGOpCode::Add, {a, b});
+                node->setOperation(CGOpCode::Exp, {Arg(*e)});
+                replaced++;
+            }
+        }
+    }
+
+    return replaced;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependent) {
 
@@ -2009,6 +2463,134 @@ inline void CodeHandler<Base>::updateEvaluationQueueOrder(Node& root,
     depthFirstGraphNavigation(root, analyse, true);
 }
 
+template<class Base>
+inline bool CodeHandler<Base>::partitionTasks() {
+    const size_t nVars = _variableOrder.size();
+    if (_zeroDependents || !_loops.endNodes.empty() || nVars < 2 * _parallelTasks)
+        return false;
+
+    auto isSupported = [](const Node& node) {
+        CGOpCode op = node.getOperationType();
+        return isPureOperation(node) || op == CGOpCode::Assign || op == CGOpCode::Alias;
+    };
+
+    /**
+     * the variables which use each variable and the number of operations
+     * required to evaluate each variable
+     */
+    std::vector<std::vector<size_t> > users(nVars);
+    std::vector<size_t> cost(nVars, 1);
+    std::vector<Node*> stack;
+
+    for (size_t i = 0; i < nVars; i++) {
+        Node& var = *_variableOrder[i];
+        if (!isSupported(var))
+            return false;
+
+        startNewOperationTreeVisit();
+        stack.push_back(&var);
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            for (const Arg& a : node->getArguments()) {
+                Node* arg = a.getOperation();
+                if (arg == nullptr || isVisited(*arg) || isIndependent(*arg))
+                    continue;
+                markVisited(*arg);
+
+                if (_varId[*arg] != 0) {
+                    size_t pos = getEvaluationOrder(*arg);
+                    if (pos == 0 || pos > i)
+                        return false; // not a variable assignment which is evaluated before
+                    users[pos - 1].push_back(i);
+                } else if (isSupported(*arg)) {
+                    cost[i]++;
+                    stack.push_back(arg);
+                } else {
+                    return false;
+                }
+            }
+        }
+    }
+
+    size_t totalCost = 0;
+    for (size_t c : cost)
+        totalCost += c;
+    const size_t maxTaskCost = (totalCost + _parallelTasks - 1) / _parallelTasks;
+
+    /**
+     * assign the variables to tasks (in reverse order)
+     */
+    const size_t none = (std::numeric_limits<size_t>::max)();
+    std::vector<size_t> task(nVars, none);
+    std::vector<size_t> taskCost;
+    std::vector<size_t> userTasks;
+
+    for (size_t i = nVars; i-- > 0;) {
+        userTasks.clear();
+        for (size_t u : users[i])
+            userTasks.push_back(task[u]);
+        std::sort(userTasks.begin(), userTasks.end());
+        userTasks.erase(std::unique(userTasks.begin(), userTasks.end()), userTasks.end());
+
+        size_t t = none;
+        if (userTasks.size() == 1 && taskCost[userTasks[0]] < maxTaskCost) {
+            t = userTasks[0]; // only used by a single task
+        } else if (!taskCost.empty() && taskCost.back() < maxTaskCost &&
+                   (userTasks.empty() || userTasks.back() < taskCost.size() - 1)) {
+            t = taskCost.size() - 1; // the last task does not use this variable
+        } else {
+            t = taskCost.size();
+            taskCost.push_back(0);
+        }
+
+        task[i] = t;
+        taskCost[t] += cost[i];
+    }
+
+    const size_t nTasks = taskCost.size();
+    if (nTasks < 2)
+        return false;
+
+    /**
+     * the tasks created last must be evaluated first
+     */
+    for (size_t& t : task)
+        t = nTasks - 1 - t;
+
+    _taskDependencies.resize(nTasks);
+    for (size_t i = 0; i < nVars; i++) {
+        for (size_t u : users[i]) {
+            if (task[u] != task[i])
+                _taskDependencies[task[u]].insert(task[i]);
+        }
+    }
+
+    std::vector<size_t> taskSize(nTasks, 0);
+    for (size_t t : task)
+        taskSize[t]++;
+
+    _taskStart.resize(nTasks);
+    size_t start = 0;
+    for (size_t t = 0; t < nTasks; t++) {
+        _taskStart[t] = start;
+        start += taskSize[t];
+    }
+
+    std::vector<Node*> order(nVars);
+    std::vector<size_t> next(_taskStart);
+    for (size_t i = 0; i < nVars; i++) {
+        order[next[task[i]]++] = _variableOrder[i];
+    }
+    _variableOrder.swap(order);
+
+    for (size_t p = 0; p < nVars; p++) {
+        setEvaluationOrder(*_variableOrder[p], p + 1);
+    }
+
+    return true;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::findVariableDependencies() {
     _variableDependencies.resize(_variableOrder.size());
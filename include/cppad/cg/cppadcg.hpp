@@ -23,6 +23,8 @@
 #include <array>
 #include <assert.h>
 #include <cstddef>
+#include <cstdint>
+#include <ctime>
 #include <errno.h>
 #include <fstream>
 #include <iomanip>
@@ -37,6 +39,7 @@
 #include <deque>
 #include <forward_list>
 #include <set>
+#include <unordered_set>
 #include <stddef.h>
 #include <stdexcept>
 #include <stdio.h>
@@ -46,7 +49,13 @@
 #include <string.h>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <type_traits>
+#include <random>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -87,6 +96,7 @@
 #include <cppad/cg/smart_containers.hpp>
 #include <cppad/cg/ostream_config_restore.hpp>
 #include <cppad/cg/array_view.hpp>
+#include <cppad/cg/sha256.hpp>
 
 // ---------------------------------------------------------------------------
 // indexes
@@ -104,6 +114,7 @@
 #include <cppad/cg/debug.hpp>
 #include <cppad/cg/argument.hpp>
 #include <cppad/cg/operation_node.hpp>
+#include <cppad/cg/operation_node_pool.hpp>
 #include <cppad/cg/operation_stack.hpp>
 #include <cppad/cg/nodes/index_operation_node.hpp>
 #include <cppad/cg/nodes/index_assign_operation_node.hpp>
@@ -118,6 +129,7 @@
 #include <cppad/cg/atomic_dependency_locator.hpp>
 #include <cppad/cg/variable_name_generator.hpp>
 #include <cppad/cg/job_timer.hpp>
+#include <cppad/cg/source_file_sink.hpp>
 #include <cppad/cg/lang/language.hpp>
 #include <cppad/cg/lang/lang_stream_stack.hpp>
 #include <cppad/cg/scope_path_element.hpp>
@@ -195,6 +207,7 @@
 #include <cppad/cg/lang/c/language_c_index_patterns.hpp>
 #include <cppad/cg/lang/c/language_c_double.hpp>
 #include <cppad/cg/lang/c/language_c_float.hpp>
+#include <cppad/cg/lang/c/language_c_lanes.hpp>
 #include <cppad/cg/lang/c/language_c_loops.hpp>
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
@@ -202,16 +215,24 @@
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
+// ---------------------------------------------------------------------------
+// bytecode generation (interpreted evaluation)
+#include <cppad/cg/lang/bytecode/bytecode_program.hpp>
+#include <cppad/cg/lang/bytecode/language_bytecode.hpp>
+
 //
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
+#include <cppad/cg/model/threadpool/thread_pool_affinity.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
 #include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
 #include <cppad/cg/model/model_library_processor.hpp>
 #include <cppad/cg/model/model_library.hpp>
+#include <cppad/cg/model/generic_model_workspace.hpp>
 #include <cppad/cg/model/generic_model.hpp>
 #include <cppad/cg/model/functor_generic_model.hpp>
+#include <cppad/cg/model/interpreted_generic_model.hpp>
 #include <cppad/cg/model/functor_model_library.hpp>
 #include <cppad/cg/model/save_files_model_library_processor.hpp>
 
@@ -241,6 +262,8 @@
 #include <cppad/cg/model/model_c_source_gen_rev2.hpp>
 #include <cppad/cg/model/model_c_source_gen_jac.hpp>
 #include <cppad/cg/model/model_c_source_gen_hes.hpp>
+#include <cppad/cg/model/model_c_source_gen_shared.hpp>
+#include <cppad/cg/model/model_c_source_gen_parallel.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for0.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for1.hpp>
@@ -254,6 +277,7 @@
 
 // automated dynamic library creation
 #include <cppad/cg/model/dynamic_lib/dynamiclib.hpp>
+#include <cppad/cg/model/dynamic_lib/dynamic_library_cache.hpp>
 #include <cppad/cg/model/dynamic_lib/dynamic_library_processor.hpp>
 
 // ---------------------------------------------------------------------------
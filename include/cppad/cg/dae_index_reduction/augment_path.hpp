@@ -50,6 +50,20 @@ public:
      */
     virtual bool augmentPath(Enode<Base>& i) = 0;
 
+    /**
+     * Assigns variables to several equations before they are processed
+     * individually with augmentPath().
+     * Existing assignments must be preserved or only exchanged along
+     * augmenting paths.
+     * By default nothing is assigned.
+     *
+     * @param equations The equation nodes
+     * @return the number of newly assigned equations
+     */
+    virtual size_t assignEquations(const std::vector<Enode<Base>*>& equations) {
+        return 0;
+    }
+
     inline void setLogger(SimpleLogger& logger) {
         logger_ = &logger;
     }
@@ -0,0 +1,306 @@
+#ifndef CPPAD_CG_AUGMENTPATHHOPCROFTKARP_INCLUDED
+#define CPPAD_CG_AUGMENTPATHHOPCROFTKARP_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/augment_path.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An augment path algorithm based on the Hopcroft-Karp maximum matching
+ * algorithm.
+ *
+ * Individual equations are assigned with a breadth-first search for the
+ * shortest augmenting path which, unlike the recursive depth-first search,
+ * does not require a call stack proportional to the size of the model.
+ * The visited nodes are colored in the same way as in
+ * AugmentPathDepthLookahead, so that the structurally singular subsets can
+ * be determined when no path is found.
+ *
+ * Several equations can also be assigned at once using Hopcroft-Karp phases
+ * (assignEquations()) starting from the current assignments.
+ */
+template<class Base>
+class AugmentPathHopcroftKarp : public AugmentPath<Base> {
+protected:
+    using CGBase = CppAD::cg::CG<Base>;
+    using ADCG = CppAD::AD<CGBase>;
+
+    /**
+     * Search information for an equation (indexed by the equation index)
+     */
+    struct EquationSearch {
+        // the variable through which the equation was reached
+        Vnode<Base>* parent;
+        // the layer of the equation in a Hopcroft-Karp phase
+        size_t layer;
+        // the position of the next variable to visit in a Hopcroft-Karp phase
+        size_t next;
+
+        inline EquationSearch() :
+                parent(nullptr),
+                layer((std::numeric_limits<size_t>::max)()),
+                next(0) {
+        }
+    };
+protected:
+    // the equations reached by the last search (in breadth-first order)
+    std::vector<Enode<Base>*> queue_;
+    // the equations in the current depth-first search of a Hopcroft-Karp phase
+    std::vector<Enode<Base>*> stack_;
+    // search information of each equation
+    std::vector<EquationSearch> eqSearch_;
+    // the equation from which each variable was reached (by variable index)
+    std::vector<Enode<Base>*> varParent_;
+    // the layer of the equations with the shortest augmenting paths
+    size_t lastLayer_;
+public:
+
+    inline AugmentPathHopcroftKarp() :
+            lastLayer_(0) {
+    }
+
+    bool augmentPath(Enode<Base>& i) override final {
+        std::ostream& out = this->logger_->log();
+        Verbosity verbosity = this->logger_->getVerbosity();
+
+        i.color(out, verbosity);
+        search(i).parent = nullptr;
+
+        queue_.clear();
+        queue_.push_back(&i);
+
+        for (size_t q = 0; q < queue_.size(); ++q) {
+            Enode<Base>& e = *queue_[q];
+
+            Vnode<Base>* free = findUnassigned(e);
+            if (free != nullptr) {
+                flipPath(e, *free);
+                return true;
+            }
+
+            for (Vnode<Base>* jj : e.variables()) {
+                if (!jj->isColored()) {
+                    jj->color(out, verbosity);
+
+                    Enode<Base>& k = *jj->assignmentEquation(); // all variables are assigned to another equation
+                    if (!k.isColored()) {
+                        k.color(out, verbosity);
+                        search(k).parent = jj;
+                        parent(*jj) = &e;
+                        queue_.push_back(&k);
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Assigns as many of the provided equations as possible using the
+     * Hopcroft-Karp algorithm.
+     * The current assignments are used as the initial matching and they are
+     * never removed (only exchanged along augmenting paths).
+     * Nodes are not colored.
+     *
+     * @param equations The equation nodes to assign
+     * @return the number of newly assigned equations
+     */
+    size_t assignEquations(const std::vector<Enode<Base>*>& equations) override {
+        size_t assigned = 0;
+
+        while (buildLayers(equations)) {
+            for (Enode<Base>* e : equations) {
+                if (!isAssigned(*e) && search(*e).layer == 0) {
+                    if (augmentLayered(*e))
+                        assigned++;
+                }
+            }
+        }
+
+        clearLayers();
+
+        return assigned;
+    }
+
+protected:
+
+    /**
+     * Determines the layers of the equations reachable through alternating
+     * paths from the unassigned equations (a breadth-first search).
+     *
+     * @return true if there is at least one augmenting path
+     */
+    inline bool buildLayers(const std::vector<Enode<Base>*>& equations) {
+        const size_t unreached = (std::numeric_limits<size_t>::max)();
+
+        clearLayers();
+
+        for (Enode<Base>* e : equations) {
+            EquationSearch& s = search(*e);
+            if (!isAssigned(*e) && s.layer != 0) {
+                s.layer = 0;
+                s.parent = nullptr;
+                queue_.push_back(e);
+            }
+        }
+
+        lastLayer_ = unreached;
+
+        for (size_t q = 0; q < queue_.size(); ++q) {
+            Enode<Base>& e = *queue_[q];
+            size_t layer = search(e).layer;
+            if (layer >= lastLayer_)
+                break; // only the shortest augmenting paths are used
+
+            for (Vnode<Base>* jj : e.variables()) {
+                Enode<Base>* k = jj->assignmentEquation();
+                if (k == nullptr) {
+                    lastLayer_ = layer;
+                } else {
+                    EquationSearch& sk = search(*k);
+                    if (sk.layer == unreached) {
+                        sk.layer = layer + 1;
+                        queue_.push_back(k);
+                    }
+                }
+            }
+        }
+
+        return lastLayer_ != unreached;
+    }
+
+    /**
+     * Resets the layers of the equations reached by the last search.
+     */
+    inline void clearLayers() {
+        for (Enode<Base>* e : queue_) {
+            EquationSearch& s = search(*e);
+            s.layer = (std::numeric_limits<size_t>::max)();
+            s.next = 0;
+        }
+        queue_.clear();
+    }
+
+    /**
+     * Looks for an augmenting path from an equation which only goes through
+     * consecutive layers (a non-recursive depth-first search).
+     *
+     * @param root An unassigned equation in the first layer
+     * @return true if the equation was assigned
+     */
+    inline bool augmentLayered(Enode<Base>& root) {
+        stack_.clear();
+        stack_.push_back(&root);
+
+        while (!stack_.empty()) {
+            Enode<Base>& e = *stack_.back();
+            EquationSearch& s = search(e);
+            const std::vector<Vnode<Base>*>& vars = e.variables();
+
+            if (s.next == vars.size()) {
+                // dead end for the remainder of this phase
+                s.layer = (std::numeric_limits<size_t>::max)();
+                stack_.pop_back();
+                continue;
+            }
+
+            Vnode<Base>* jj = vars[s.next++];
+            const size_t layer = s.layer; // s might be invalidated by search()
+
+            Enode<Base>* k = jj->assignmentEquation();
+            if (k == nullptr) {
+                if (layer == lastLayer_) {
+                    flipPath(e, *jj);
+                    return true;
+                }
+            } else {
+                EquationSearch& sk = search(*k);
+                if (sk.layer == layer + 1) {
+                    sk.parent = jj;
+                    parent(*jj) = &e;
+                    stack_.push_back(k);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Prefers unassigned derivative variables over unassigned algebraic
+     * variables.
+     *
+     * @return an unassigned variable of the equation or nullptr
+     */
+    static inline Vnode<Base>* findUnassigned(const Enode<Base>& e) {
+        Vnode<Base>* algebraic = nullptr;
+        for (Vnode<Base>* jj : e.variables()) {
+            if (jj->assignmentEquation() == nullptr) {
+                if (jj->antiDerivative() != nullptr)
+                    return jj;
+                else if (algebraic == nullptr)
+                    algebraic = jj;
+            }
+        }
+        return algebraic;
+    }
+
+    /**
+     * Assigns a variable to the last equation in a path and then each
+     * variable in the path to the equation from which it was reached.
+     */
+    inline void flipPath(Enode<Base>& e,
+                         Vnode<Base>& j) {
+        std::ostream& out = this->logger_->log();
+        Verbosity verbosity = this->logger_->getVerbosity();
+
+        Enode<Base>* ee = &e;
+        Vnode<Base>* jj = &j;
+        while (true) {
+            Vnode<Base>* previous = search(*ee).parent;
+            jj->setAssignmentEquation(*ee, out, verbosity);
+            if (previous == nullptr)
+                break;
+            ee = parent(*previous);
+            jj = previous;
+        }
+    }
+
+    static inline bool isAssigned(const Enode<Base>& e) {
+        return e.assignmentVariable() != nullptr && !e.assignmentVariable()->isDeleted();
+    }
+
+    inline EquationSearch& search(const Enode<Base>& e) {
+        if (e.index() >= eqSearch_.size())
+            eqSearch_.resize(e.index() + 1);
+        return eqSearch_[e.index()];
+    }
+
+    inline Enode<Base>*& parent(const Vnode<Base>& j) {
+        if (j.index() >= varParent_.size())
+            varParent_.resize(j.index() + 1, nullptr);
+        return varParent_[j.index()];
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -37,6 +37,8 @@ class DummyDerivatives : public DaeIndexReduction<Base> {
     using VectorB = Eigen::Matrix<Base, Eigen::Dynamic, 1>;
     using VectorCB = Eigen::Matrix<std::complex<Base>, Eigen::Dynamic, 1>;
     using MatrixB = Eigen::Matrix<Base, Eigen::Dynamic, Eigen::Dynamic>;
+    using SparseMatrixB = Eigen::SparseMatrix<Base, Eigen::ColMajor>;
+    using JacobianIterator = typename Eigen::SparseMatrix<Base, Eigen::RowMajor>::InnerIterator;
 protected:
     /**
      * Method used to identify the structural index
@@ -98,6 +100,12 @@ protected:
      * Avoid using these variables as dummy derivatives
      */
     std::set<std::string> avoidAsDummy_;
+    /**
+     * The minimum number of equations in a subset of the Jacobian for which
+     * a sparse QR decomposition is used to select dummy derivatives
+     * (zero if it is never used)
+     */
+    size_t sparseQRMinSize_;
 public:
 
     /**
@@ -125,7 +133,8 @@ public:
             reduceEquations_(true),
             generateSemiExplicitDae_(false),
             reorder_(true),
-            avoidConvertAlg2DifVars_(true) {
+            avoidConvertAlg2DifVars_(true),
+            sparseQRMinSize_(0) {
 
         for (Vnode<Base>* jj : idxIdentify.getGraph().variables()) {
             if (jj->antiDerivative() != nullptr) {
@@ -236,6 +245,40 @@ public:
         return avoidAsDummy_;
     }
 
+    /**
+     * The minimum number of equations in a subset of the Jacobian for which
+     * a sparse QR decomposition (with a COLAMD column ordering) is used to
+     * select dummy derivatives.
+     *
+     * @return the minimum number of equations (zero if the sparse QR
+     *         decomposition is never used)
+     */
+    inline size_t getSparseQRMinSize() const {
+        return sparseQRMinSize_;
+    }
+
+    /**
+     * Defines the minimum number of equations in a subset of the Jacobian
+     * for which a sparse QR decomposition (with a COLAMD column ordering) is
+     * used to select dummy derivatives.
+     * A dense QR decomposition with column pivoting is used for smaller
+     * subsets, whose cost grows with the cube of the number of equations.
+     * The sparse QR decomposition is disabled by default.
+     *
+     * The two methods can select different dummy derivatives.
+     * The sparse QR decomposition only uses threshold pivoting (it does not
+     * select the columns with the largest norms) and therefore it can
+     * select dummy derivatives which lead to a worse conditioned system.
+     * It is also slower for subsets with many more variables than
+     * equations since each linearly dependent column is moved to the end.
+     *
+     * @param minSize the minimum number of equations (zero to never use
+     *                the sparse QR decomposition)
+     */
+    inline void setSparseQRMinSize(size_t minSize) {
+        sparseQRMinSize_ = minSize;
+    }
+
     inline std::unique_ptr<ADFun<CG<Base>>> reduceIndex(std::vector<DaeVarInfo>& newVarInfo,
                                                         std::vector<DaeEquationInfo>& newEqInfo) override {
 
@@ -1403,20 +1446,26 @@ protected:
         /**
          * Determine the columns/variables that must be removed
          */
-        std::set<size_t> excludeCols;
-        std::set<size_t> avoidCols;
+        // the column of each variable in the Jacobian subset (or -1)
+        std::vector<int> var2Col(jacobian_.cols(), -1);
         for (size_t j = 0; j < vars.size(); j++) {
-            Vnode<Base>* jj = vars[j];
-            bool notZero = false;
-            for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                if (val != Base(0.0)) {
-                    notZero = true;
-                    break;
+            var2Col[vars[j]->index() - diffVarStart_] = int(j);
+        }
+
+        std::vector<bool> notZero(vars.size(), false);
+        for (Enode<Base>* ii : eqs) {
+            for (JacobianIterator it(jacobian_, ii->index() - diffEqStart_); it; ++it) {
+                int j = var2Col[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    notZero[j] = true;
                 }
             }
-            if (!notZero) {
+        }
+
+        std::set<size_t> excludeCols;
+        std::set<size_t> avoidCols;
+        for (size_t j = 0; j < vars.size(); j++) {
+            if (!notZero[j]) {
                 // all zeros: must not choose this column/variable
                 excludeCols.insert(j);
             } else if (avoidAsDummy_.find(vars[j]->name()) != avoidAsDummy_.end()) {
@@ -1434,62 +1483,26 @@ protected:
         }
 
         std::vector<Vnode<Base>* > varsLocal;
-
-        Eigen::ColPivHouseholderQR<MatrixB> qr;
+        std::vector<size_t> colOrder; // the column order determined by the QR decomposition
+        size_t rank = 0;
 
         auto orderColumns = [&]() {
             varsLocal.reserve(vars.size() - excludeCols.size());
+            std::fill(var2Col.begin(), var2Col.end(), -1);
             for (size_t j = 0; j < vars.size(); j++) {
                 if (excludeCols.find(j) == excludeCols.end()) {
+                    var2Col[vars[j]->index() - diffVarStart_] = int(varsLocal.size());
                     varsLocal.push_back(vars[j]);
                 }
             }
 
-
-            work.setZero(eqs.size(), varsLocal.size());
-
-            // determine the rows that only contain a single nonzero (a single column)
-            for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                for (size_t j = 0; j < varsLocal.size(); j++) {
-                    const Vnode<Base>* jj = varsLocal[j];
-                    Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                    if (val != Base(0.0)) {
-                        work(i, j) = val;
-                    }
-                }
-            }
-
-            if (this->verbosity_ >= Verbosity::High)
-                log() << "subset Jac:\n" << work << "\n";
-
-            qr.compute(work);
-
-            if (qr.info() != Eigen::Success) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "QR decomposition of a submatrix of the Jacobian failed!");
-            } else if (qr.rank() < work.rows()) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "The resulting system is probably singular for the provided data.");
-            }
-
-            using PermutationMatrix = typename Eigen::ColPivHouseholderQR<MatrixB>::PermutationType;
-            using Indices = typename PermutationMatrix::IndicesType;
-
-            const PermutationMatrix& p = qr.colsPermutation();
-            const Indices& indices = p.indices();
-
-            if (this->verbosity_ >= Verbosity::High) {
-                log() << "## matrix Q:\n";
-                MatrixB q = qr.matrixQ();
-                log() << q << "\n";
-                log() << "## matrix R:\n";
-                MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
-                log() << r << "\n";
-                log() << "## matrix P: " << indices.transpose() << "\n";
+            if (sparseQRMinSize_ > 0 && eqs.size() >= sparseQRMinSize_) {
+                orderColumnsSparseQR(eqs, varsLocal, var2Col, colOrder, rank);
+            } else {
+                orderColumnsDenseQR(eqs, varsLocal, var2Col, work, colOrder, rank);
             }
 
-            if (indices.size() < work.rows()) {
+            if (rank < eqs.size() || colOrder.size() < eqs.size()) {
                 throw CGException("Failed to select dummy derivatives! "
                                   "The resulting system is probably singular for the provided data.");
             }
@@ -1514,17 +1527,14 @@ protected:
             orderColumns();
         }
 
-        const auto& p = qr.colsPermutation();
-        const auto& indices = p.indices();
-
         std::vector<Vnode<Base>* > newDummies;
         if (avoidConvertAlg2DifVars_) {
             auto& graph = idxIdentify_->getGraph();
             const auto& varInfo = graph.getOriginalVariableInfo();
 
             // add algebraic first
-            for (int i = 0; newDummies.size() < size_t(work.rows()) && i < qr.rank(); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
+            for (size_t i = 0; newDummies.size() < eqs.size() && i < rank; i++) {
+                Vnode<Base>* v = varsLocal[colOrder[i]];
                 CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
                 size_t tape = v->originalVariable()->tapeIndex();
                 CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
@@ -1534,8 +1544,8 @@ protected:
                 }
             }
             // add remaining
-            for (int i = 0; newDummies.size() < size_t(work.rows()); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
+            for (size_t i = 0; newDummies.size() < eqs.size(); i++) {
+                Vnode<Base>* v = varsLocal[colOrder[i]];
                 CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
                 size_t tape = v->originalVariable()->tapeIndex();
                 CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
@@ -1546,9 +1556,9 @@ protected:
             }
 
         } else {
-            // use order provided by the householder column pivoting
-            for (int i = 0; i < work.rows(); i++) {
-                newDummies.push_back(varsLocal[indices(i)]);
+            // use order provided by the column pivoting
+            for (size_t i = 0; i < eqs.size(); i++) {
+                newDummies.push_back(varsLocal[colOrder[i]]);
             }
         }
 
@@ -1567,6 +1577,114 @@ protected:
         dummyD_.insert(dummyD_.end(), newDummies.begin(), newDummies.end());
     }
 
+    /**
+     * Orders the columns of a subset of the Jacobian using a dense QR
+     * decomposition with column pivoting.
+     *
+     * @param eqs the equations (rows)
+     * @param vars the variables (columns)
+     * @param var2Col the column of each variable in the Jacobian subset
+     * @param work the matrix used to hold the Jacobian subset
+     * @param colOrder the column order (the first rank columns are linearly
+     *                 independent)
+     * @param rank the rank of the Jacobian subset
+     */
+    inline void orderColumnsDenseQR(const std::vector<Enode<Base>* >& eqs,
+                                    const std::vector<Vnode<Base>* >& vars,
+                                    const std::vector<int>& var2Col,
+                                    MatrixB& work,
+                                    std::vector<size_t>& colOrder,
+                                    size_t& rank) {
+        work.setZero(eqs.size(), vars.size());
+
+        for (size_t i = 0; i < eqs.size(); i++) {
+            for (JacobianIterator it(jacobian_, eqs[i]->index() - diffEqStart_); it; ++it) {
+                int j = var2Col[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    work(i, j) = it.value();
+                }
+            }
+        }
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac:\n" << work << "\n";
+
+        Eigen::ColPivHouseholderQR<MatrixB> qr(work);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "QR decomposition of a submatrix of the Jacobian failed!");
+        }
+
+        const auto& indices = qr.colsPermutation().indices();
+
+        if (this->verbosity_ >= Verbosity::High) {
+            log() << "## matrix Q:\n";
+            MatrixB q = qr.matrixQ();
+            log() << q << "\n";
+            log() << "## matrix R:\n";
+            MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
+            log() << r << "\n";
+            log() << "## matrix P: " << indices.transpose() << "\n";
+        }
+
+        rank = qr.rank();
+        colOrder.assign(indices.data(), indices.data() + indices.size());
+    }
+
+    /**
+     * Orders the columns of a subset of the Jacobian using a sparse QR
+     * decomposition with a fill-reducing (COLAMD) column ordering.
+     * The cost depends on the number of non-zeros instead of the size of
+     * the Jacobian subset.
+     *
+     * @param eqs the equations (rows)
+     * @param vars the variables (columns)
+     * @param var2Col the column of each variable in the Jacobian subset
+     * @param colOrder the column order (the first rank columns are linearly
+     *                 independent)
+     * @param rank the rank of the Jacobian subset
+     */
+    inline void orderColumnsSparseQR(const std::vector<Enode<Base>* >& eqs,
+                                     const std::vector<Vnode<Base>* >& vars,
+                                     const std::vector<int>& var2Col,
+                                     std::vector<size_t>& colOrder,
+                                     size_t& rank) {
+        std::vector<Eigen::Triplet<Base> > elements;
+
+        for (size_t i = 0; i < eqs.size(); i++) {
+            for (JacobianIterator it(jacobian_, eqs[i]->index() - diffEqStart_); it; ++it) {
+                int j = var2Col[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    elements.emplace_back(int(i), j, it.value());
+                }
+            }
+        }
+
+        SparseMatrixB mat(eqs.size(), vars.size());
+        mat.setFromTriplets(elements.begin(), elements.end());
+        mat.makeCompressed();
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac:\n" << mat << "\n";
+
+        Eigen::SparseQR<SparseMatrixB, Eigen::COLAMDOrdering<int> > qr(mat);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "Sparse QR decomposition of a submatrix of the Jacobian failed!");
+        }
+
+        const auto& indices = qr.colsPermutation().indices();
+
+        if (this->verbosity_ >= Verbosity::High) {
+            log() << "## matrix P: " << indices.transpose() << "\n";
+        }
+
+        rank = qr.rank();
+        colOrder.assign(indices.data(), indices.data() + indices.size());
+    }
+
     inline static void printModel(std::ostream& out,
                                   CodeHandler<Base>& handler,
                                   const std::vector<CGBase>& res,
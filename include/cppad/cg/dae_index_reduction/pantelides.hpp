@@ -18,6 +18,7 @@
 
 #include <cppad/cg/dae_index_reduction/dae_structural_index_reduction.hpp>
 #include <cppad/cg/dae_index_reduction/augment_path_depth_lookahead.hpp>
+#include <cppad/cg/dae_index_reduction/augment_path_hopcroft_karp.hpp>
 
 namespace CppAD {
 namespace cg {
@@ -72,7 +73,13 @@ public:
         return *augmentPath_;
     }
 
-    void setAugmentPath(AugmentPath<Base>& a) const {
+    /**
+     * Defines the algorithm used to assign equations to variables.
+     * Algorithms which implement AugmentPath::assignEquations() (e.g.
+     * AugmentPathHopcroftKarp) are also used to assign the original
+     * equations before they are processed one at a time.
+     */
+    void setAugmentPath(AugmentPath<Base>& a) {
         augmentPath_ = &a;
     }
 
@@ -117,24 +124,32 @@ protected:
             graph_.printDot(this->log());
 
         size_t Ndash = enodes.size();
+
+        /**
+         * initial assignment (warm start for the equation loop)
+         */
+        deleteDifferentiatedVariables();
+
+        const std::vector<Enode<Base>*> original(enodes.begin(), enodes.end());
+        size_t nAssigned = augmentPath_->assignEquations(original);
+
+        if (this->verbosity_ >= Verbosity::High && nAssigned > 0)
+            log() << "Initial assignment of " << nAssigned << " equations\n";
+
         for (size_t k = 0; k < Ndash; k++) {
             Enode<Base>* i = enodes[k];
 
+            // the equation might have already been differentiated
+            while (i->derivative() != nullptr)
+                i = i->derivative();
+
             if (this->verbosity_ >= Verbosity::High)
                 log() << "Outer loop: equation k = " << *i << "\n";
 
-            bool pathfound = false;
+            bool pathfound = i->assignmentVariable() != nullptr && !i->assignmentVariable()->isDeleted();
             while (!pathfound) {
 
-                /**
-                 * delete all V-nodes with A!=0 and their incident edges
-                 * from the graph
-                 */
-                for (Vnode<Base>* jj : vnodes) {
-                    if (!jj->isDeleted() && jj->derivative() != nullptr) {
-                        jj->deleteNode(log(), this->verbosity_);
-                    }
-                }
+                deleteDifferentiatedVariables();
 
                 graph_.uncolorAll();
 
@@ -195,6 +210,17 @@ protected:
 
     }
 
+    /**
+     * delete all V-nodes with A!=0 and their incident edges from the graph
+     */
+    inline void deleteDifferentiatedVariables() {
+        for (Vnode<Base>* jj : graph_.variables()) {
+            if (!jj->isDeleted() && jj->derivative() != nullptr) {
+                jj->deleteNode(log(), this->verbosity_);
+            }
+        }
+    }
+
 };
 
 } // END cg namespace
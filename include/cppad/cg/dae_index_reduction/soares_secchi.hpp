@@ -83,7 +83,7 @@ public:
         return *augmentPath_;
     }
 
-    void setAugmentPath(AugmentPath<Base>& a) const {
+    void setAugmentPath(AugmentPath<Base>& a) {
         augmentPath_ = &a;
     }
 
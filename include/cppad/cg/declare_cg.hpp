@@ -71,6 +71,8 @@ class BidirGraph;
 template<class Base>
 class ScopePathElement;
 
+class SparsityPattern;
+
 /***************************************************************************
  * Nodes
  **************************************************************************/
@@ -134,18 +136,30 @@ class LangCDefaultVariableNameGenerator;
 template<class Base>
 class LangCCustomVariableNameGenerator;
 
+template<class Base>
+class BytecodeProgram;
+
+template<class Base>
+class LanguageBytecode;
+
 /***************************************************************************
  * Models
  **************************************************************************/
 template<class Base>
 class GenericModel;
 
+template<class Base>
+class GenericModelWorkspace;
+
 template<class Base>
 class ModelLibraryProcessor;
 
 template<class Base>
 class FunctorGenericModel;
 
+template<class Base>
+class InterpretedGenericModel;
+
 /***************************************************************************
  * Dynamic model compilation
  **************************************************************************/
@@ -36,15 +36,20 @@ class EvaluatorBase;
  * pattern (CRTP). Therefore the default behaviour can be overridden without
  * the use of virtual methods.
  *
- * This class should not be instantiated directly.
+ * By default the operation graph is traversed recursively, starting from
+ * the dependent variables.
+ * An iterative evaluation can be used instead (see setIterative()) which
+ * does not have any stack limit issues and avoids the allocation of memory
+ * for each node.
  *
- * @todo implement nonrecursive algorithm (so that there will never be any stack limit issues)
+ * This class should not be instantiated directly.
  */
 template<class ScalarIn, class ScalarOut, class ActiveOut, class FinalEvaluatorType>
 class EvaluatorBase {
     friend FinalEvaluatorType;
 protected:
     using SourceCodePath = typename CodeHandler<ScalarIn>::SourceCodePath;
+    using NodeIn = OperationNode<ScalarIn>;
 protected:
     CodeHandler<ScalarIn>& handler_;
     const ActiveOut* indep_;
@@ -54,6 +59,34 @@ protected:
     bool underEval_;
     size_t depth_;
     SourceCodePath path_;
+    /**
+     * Whether or not the nodes are evaluated iteratively using a
+     * topological order (instead of recursively)
+     */
+    bool iterative_;
+    /**
+     * The evaluation results of each node (only used in the iterative mode)
+     */
+    CodeHandlerVector<ScalarIn, ActiveOut> values_;
+    /**
+     * Whether or not a node was already evaluated (only used in the
+     * iterative mode)
+     */
+    CodeHandlerVector<ScalarIn, bool> evaluated_;
+    /**
+     * The nodes in the order they are evaluated (arguments always come
+     * before the nodes which use them)
+     */
+    std::vector<NodeIn*> order_;
+    /**
+     * The dependent variable nodes used to determine order_
+     */
+    std::vector<const NodeIn*> orderDeps_;
+    /**
+     * The number of nodes managed by the code handler when order_ was
+     * determined
+     */
+    size_t orderNodeCount_;
 public:
 
     /**
@@ -64,7 +97,11 @@ public:
         indep_(nullptr),
         evals_(handler),
         underEval_(false),
-        depth_(0) { // not really required (but it avoids warnings)
+        depth_(0), // not really required (but it avoids warnings)
+        iterative_(false),
+        values_(handler),
+        evaluated_(handler),
+        orderNodeCount_(0) {
     }
 
     inline virtual ~EvaluatorBase() {
@@ -78,6 +115,54 @@ public:
         return underEval_;
     }
 
+    /**
+     * @return true if the nodes are evaluated iteratively following a
+     *         topological order
+     */
+    inline bool isIterative() const {
+        return iterative_;
+    }
+
+    /**
+     * Defines whether or not the nodes should be evaluated iteratively
+     * following a topological order instead of recursively.
+     *
+     * The order is determined in the first evaluation and reused in
+     * following evaluations with the same dependent variables, therefore
+     * the same evaluator can be used to efficiently evaluate an operation
+     * graph for several sets of independent variables.
+     * The results are saved in a contiguous array indexed by the node
+     * position in the code handler which is also reused.
+     *
+     * It should not be used by evaluators which depend on the path of
+     * nodes from the dependent variables (e.g. EvaluatorCloneSolve).
+     *
+     * @param iterative true to use an iterative evaluation
+     */
+    inline void setIterative(bool iterative) {
+        if (underEval_) {
+            throw CGException("Unable to change the evaluation mode during an evaluation");
+        }
+
+        iterative_ = iterative;
+        if (!iterative) {
+            resetEvaluationOrder();
+            values_.clear();
+            evaluated_.clear();
+        }
+    }
+
+    /**
+     * Discards the evaluation order determined for the iterative mode.
+     * It must be called if the operation graph is changed without changing
+     * the number of nodes managed by the code handler.
+     */
+    inline void resetEvaluationOrder() {
+        order_.clear();
+        orderDeps_.clear();
+        orderNodeCount_ = 0;
+    }
+
     /**
      * Performs all the operations required to calculate the dependent
      * variables with a (potentially) new data type
@@ -152,7 +237,11 @@ public:
         underEval_ = true;
 
         clear(); // clean-up from any previous call that might have failed
-        evals_.adjustSize();
+        if (iterative_) {
+            prepareIterativeEvaluation(depOld, depSize);
+        } else {
+            evals_.adjustSize();
+        }
 
         depth_ = 0;
         path_.clear();
@@ -169,6 +258,10 @@ public:
             indep_ = indepNew;
             thisOps.analyzeOutIndeps(indep_, indepSize);
 
+            if (iterative_) {
+                evalOrder();
+            }
+
             for (size_t i = 0; i < depSize; i++) {
                 CPPADCG_ASSERT_UNKNOWN(depth_ == 0);
                 depNew[i] = evalCG(depOld[i]);
@@ -212,6 +305,113 @@ protected:
         // empty
     }
 
+    /**
+     * Prepares the data structures used by the iterative evaluation.
+     * The evaluation order is only determined again if the dependent
+     * variables or the number of nodes in the code handler changed.
+     */
+    inline void prepareIterativeEvaluation(const CG<ScalarIn>* depOld,
+                                           size_t depSize) {
+        bool sameOrder = orderNodeCount_ == handler_.getManagedNodesCount() && orderDeps_.size() == depSize;
+        for (size_t i = 0; i < depSize && sameOrder; i++) {
+            sameOrder = orderDeps_[i] == depOld[i].getOperationNode();
+        }
+
+        if (!sameOrder) {
+            determineEvaluationOrder(depOld, depSize);
+        }
+
+        values_.adjustSize();
+        evaluated_.adjustSize();
+        evaluated_.fill(false);
+    }
+
+    /**
+     * Determines a topological order of all the nodes required to evaluate
+     * the dependent variables (arguments come before the nodes which use
+     * them) without recursion.
+     */
+    inline void determineEvaluationOrder(const CG<ScalarIn>* depOld,
+                                         size_t depSize) {
+        resetEvaluationOrder();
+
+        orderNodeCount_ = handler_.getManagedNodesCount();
+        orderDeps_.resize(depSize);
+
+        std::vector<bool> visited(orderNodeCount_, false);
+        std::vector<std::pair<NodeIn*, size_t> > stack; // the node and the index of the next argument
+
+        for (size_t i = 0; i < depSize; i++) {
+            NodeIn* dep = depOld[i].getOperationNode();
+            orderDeps_[i] = dep;
+
+            if (dep == nullptr || visited[dep->getHandlerPosition()])
+                continue;
+
+            CPPADCG_ASSERT_KNOWN(dep->getHandlerPosition() < orderNodeCount_, "this node is not managed by the code handler");
+            visited[dep->getHandlerPosition()] = true;
+            stack.emplace_back(dep, 0);
+
+            while (!stack.empty()) {
+                NodeIn* node = stack.back().first;
+                size_t a = stack.back().second;
+                const std::vector<Argument<ScalarIn> >& args = node->getArguments();
+
+                if (a < args.size()) {
+                    stack.back().second++;
+
+                    NodeIn* arg = args[a].getOperation();
+                    if (arg != nullptr && !visited[arg->getHandlerPosition()]) {
+                        CPPADCG_ASSERT_KNOWN(arg->getHandlerPosition() < orderNodeCount_, "this node is not managed by the code handler");
+                        visited[arg->getHandlerPosition()] = true;
+                        stack.emplace_back(arg, 0);
+                    }
+                } else {
+                    order_.push_back(node);
+                    stack.pop_back();
+                }
+            }
+        }
+    }
+
+    /**
+     * Evaluates all the nodes in the topological order.
+     * Since the arguments of each node are always evaluated first, there
+     * is never more than one level of nested evaluations.
+     */
+    inline void evalOrder() {
+        for (NodeIn* node : order_) {
+            CGOpCode op = node->getOperationType();
+            if (op == CGOpCode::ArrayCreation || op == CGOpCode::SparseArrayCreation ||
+                op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) {
+                continue; // evaluated by the array element operations which use them
+            }
+
+            evalOperations(*node);
+        }
+    }
+
+    /**
+     * @return true if the node was already evaluated
+     */
+    inline bool isEvaluated(const NodeIn& node) const {
+        if (iterative_)
+            return evaluated_[node];
+        else
+            return evals_[node] != nullptr;
+    }
+
+    /**
+     * Provides the result of a node which was previously evaluated.
+     */
+    inline ActiveOut& getEvaluation(const NodeIn& node) {
+        CPPADCG_ASSERT_UNKNOWN(isEvaluated(node));
+        if (iterative_)
+            return values_[node];
+        else
+            return *evals_[node];
+    }
+
     inline ActiveOut evalCG(const CG<ScalarIn>& dep) {
         if (dep.isParameter()) {
             // parameter
@@ -242,8 +442,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (isEvaluated(node)) {
+            return getEvaluation(node);
         }
 
         // first evaluation of this node
@@ -265,11 +465,19 @@ protected:
 
     inline ActiveOut* saveEvaluation(const OperationNode<ScalarIn>& node,
                                      ActiveOut&& result) {
-        std::unique_ptr<ActiveOut>& resultPtr = evals_[node];
-        CPPADCG_ASSERT_UNKNOWN(resultPtr == nullptr); // not supposed to override existing result
-        resultPtr.reset(new ActiveOut(std::move(result)));
-
-        ActiveOut* resultPtr2 = resultPtr.get(); // do not use a reference (just in case evals_ is resized)
+        CPPADCG_ASSERT_UNKNOWN(!isEvaluated(node)); // not supposed to override existing result
+
+        ActiveOut* resultPtr2; // do not use a reference (just in case evals_ is resized)
+        if (iterative_) {
+            // values_ is never resized during an evaluation
+            resultPtr2 = &values_[node];
+            *resultPtr2 = std::move(result);
+            evaluated_[node] = true;
+        } else {
+            std::unique_ptr<ActiveOut>& resultPtr = evals_[node];
+            resultPtr.reset(new ActiveOut(std::move(result)));
+            resultPtr2 = resultPtr.get();
+        }
 
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
         thisOps.processActiveOut(node, *resultPtr2);
@@ -53,7 +53,6 @@ protected:
      * during the evaluation.
      */
     bool printOutPriOperations_;
-    using EvaluatorBase<ScalarIn, ScalarOut, CG<ScalarOut>, FinalEvaluatorType>::evals_;
 public:
 
     inline EvaluatorCG(CodeHandler<ScalarIn>& handler) :
@@ -154,8 +153,8 @@ protected:
                              "Invalid operation type");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return; // *evals_[node];
+        if (this->isEvaluated(node)) {
+            return; // this->getEvaluation(node);
         }
 
         const std::vector<size_t>& info = node.getInfo();
@@ -227,8 +226,8 @@ protected:
      */
     inline ActiveOut evalArrayElement(const NodeIn& node) {
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (this->isEvaluated(node)) {
+            return this->getEvaluation(node);
         }
 
         const std::vector<ArgIn>& args = node.getArguments();
@@ -244,7 +243,7 @@ protected:
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
         const NodeIn& atomicNode = *args[1].getOperation();
         thisOps.evalAtomicOperation(atomicNode); // atomic operation
-        ArgOut atomicArg = *evals_[atomicNode]->getOperationNode();
+        ArgOut atomicArg = *this->getEvaluation(atomicNode).getOperationNode();
 
         ActiveOut out(*outHandler_->makeNode(CGOpCode::ArrayElement, {index}, {arrayArg, atomicArg}));
 
@@ -291,8 +290,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (this->isEvaluated(node)) {
+            return this->getEvaluation(node);
         }
 
         if (outHandler_ == nullptr) {
@@ -311,8 +310,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < this->handler_.getManagedNodesCount(), "this node is not managed by the code handler");
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        if (this->isEvaluated(node)) {
+            return this->getEvaluation(node);
         }
 
         if (outHandler_ == nullptr) {
@@ -18,6 +18,7 @@
 #include <cppad/cppad.hpp>
 
 #include <cppad/cg/extra/sparse_forjac_hessian.hpp>
+#include <cppad/cg/extra/sparsity_pattern.hpp>
 #include <cppad/cg/extra/sparsity.hpp>
 
 #endif
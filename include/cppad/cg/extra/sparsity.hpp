@@ -296,6 +296,74 @@ inline void generateSparsityIndexes(const VectorSet& sparsity,
     }
 }
 
+/**
+ * Determines the Jacobian sparsity for a model in a compressed format
+ *
+ * @param fun The model
+ * @return The Jacobian sparsity
+ */
+template<class Base>
+inline SparsityPattern jacobianSparsityPattern(ADFun<Base>& fun) {
+    using SparseRC = CppAD::sparse_rc<std::vector<size_t> >;
+
+    size_t m = fun.Range();
+    size_t n = fun.Domain();
+
+    // the pattern is created directly from the row and column indexes
+    // (without the set-based representation)
+    SparseRC jac;
+    if (n <= m) {
+        // use forward mode
+        SparseRC r(n, n, n); // identity matrix
+        for (size_t j = 0; j < n; j++)
+            r.set(j, j, j);
+        fun.for_jac_sparsity(r, false, false, false, jac);
+    } else {
+        // use reverse mode
+        SparseRC s(m, m, m); // identity matrix
+        for (size_t i = 0; i < m; i++)
+            s.set(i, i, i);
+        fun.rev_jac_sparsity(s, false, false, false, jac);
+    }
+
+    return SparsityPattern(m, n, jac.row(), jac.col());
+}
+
+/**
+ * Determines the sparsity of the sum of the hessians of all the dependent
+ * variables in a model in a compressed format
+ *
+ * @param fun The model
+ * @return The sum of the hessian sparsities
+ */
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun,
+                                              bool transpose = false) {
+    using SparseRC = CppAD::sparse_rc<std::vector<size_t> >;
+
+    size_t m = fun.Range();
+    size_t n = fun.Domain();
+
+    SparseRC r(n, n, n); // identity matrix
+    for (size_t j = 0; j < n; j++)
+        r.set(j, j, j);
+    SparseRC jac;
+    fun.for_jac_sparsity(r, false, false, false, jac);
+
+    std::vector<bool> s(m, true);
+    SparseRC hess;
+    fun.rev_hes_sparsity(s, transpose, false, hess);
+
+    return SparsityPattern(n, n, hess.row(), hess.col());
+}
+
+template<class VectorSize>
+inline void generateSparsityIndexes(const SparsityPattern& sparsity,
+                                    VectorSize& row,
+                                    VectorSize& col) {
+    sparsity.toIndexes(row, col);
+}
+
 template<class VectorSet, class VectorSize>
 inline void generateSparsitySet(const VectorSize& row,
                                 const VectorSize& col,
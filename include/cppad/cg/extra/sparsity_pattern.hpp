@@ -0,0 +1,293 @@
+#ifndef CPPAD_CG_SPARSITY_PATTERN_INCLUDED
+#define CPPAD_CG_SPARSITY_PATTERN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An immutable sparsity pattern in a compressed row storage (CSR) format.
+ *
+ * The column indexes of each row are sorted and unique.
+ * Rows with many elements can also have a bitset (see useBitsets()) which
+ * allows constant time lookups with contains().
+ *
+ * It requires much less memory than a vector of sets and it can be
+ * converted to and from the set-based representation used by CppAD.
+ *
+ * @author Joao Leal
+ */
+class SparsityPattern {
+protected:
+    // the number of columns
+    size_t _nCols;
+    // the position of the first element of each row in _cols (nRows + 1)
+    std::vector<size_t> _rowStart;
+    // the column indexes of the non-zero elements
+    std::vector<size_t> _cols;
+    // the position of the first word of each row bitset in _bits (empty if there are no bitsets)
+    std::vector<size_t> _bitsetStart;
+    // the bitsets of the rows with many elements
+    std::vector<uint64_t> _bits;
+public:
+
+    /**
+     * Creates an empty pattern with no rows.
+     */
+    inline SparsityPattern() :
+            _nCols(0),
+            _rowStart(1, 0) {
+    }
+
+    /**
+     * Creates a pattern without non-zero elements.
+     *
+     * @param nRows the number of rows
+     * @param nCols the number of columns
+     */
+    inline SparsityPattern(size_t nRows,
+                           size_t nCols) :
+            _nCols(nCols),
+            _rowStart(nRows + 1, 0) {
+    }
+
+    /**
+     * Creates a pattern from the row and column indexes of the non-zero
+     * elements (in any order, repeated elements are ignored).
+     *
+     * @param nRows the number of rows
+     * @param nCols the number of columns
+     * @param rows the row index of each element
+     * @param cols the column index of each element
+     */
+    template<class VectorSize>
+    inline SparsityPattern(size_t nRows,
+                           size_t nCols,
+                           const VectorSize& rows,
+                           const VectorSize& cols) :
+            _nCols(nCols),
+            _rowStart(nRows + 1, 0) {
+        CPPADCG_ASSERT_KNOWN(rows.size() == cols.size(), "The number of row and column indexes must be the same")
+
+        size_t nnz = rows.size();
+        for (size_t e = 0; e < nnz; e++) {
+            CPPADCG_ASSERT_KNOWN(size_t(rows[e]) < nRows && size_t(cols[e]) < nCols, "Element outside the sparsity pattern")
+            _rowStart[rows[e] + 1]++;
+        }
+        for (size_t i = 0; i < nRows; i++) {
+            _rowStart[i + 1] += _rowStart[i];
+        }
+
+        _cols.resize(nnz);
+        std::vector<size_t> pos(_rowStart.begin(), _rowStart.end() - 1);
+        for (size_t e = 0; e < nnz; e++) {
+            _cols[pos[rows[e]]++] = cols[e];
+        }
+
+        // sort and remove repeated elements
+        size_t last = 0;
+        for (size_t i = 0; i < nRows; i++) {
+            auto begin = _cols.begin() + _rowStart[i];
+            auto end = _cols.begin() + _rowStart[i + 1];
+            std::sort(begin, end);
+            end = std::unique(begin, end);
+
+            _rowStart[i] = last;
+            auto dest = _cols.begin() + last;
+            if (dest == begin) {
+                last = end - _cols.begin(); // already in place
+            } else {
+                // the destination is always before begin (forward copy)
+                last = std::copy(begin, end, dest) - _cols.begin();
+            }
+        }
+        _rowStart[nRows] = last;
+        _cols.resize(last);
+        _cols.shrink_to_fit();
+    }
+
+    /**
+     * Creates a pattern from a set-based representation.
+     *
+     * @param sparsity the column indexes of each row
+     * @param nCols the number of columns
+     */
+    template<class VectorSet>
+    static inline SparsityPattern fromSet(const VectorSet& sparsity,
+                                          size_t nCols) {
+        size_t nRows = sparsity.size();
+
+        SparsityPattern p(nRows, nCols);
+
+        for (size_t i = 0; i < nRows; i++) {
+            p._rowStart[i + 1] = p._rowStart[i] + sparsity[i].size();
+        }
+
+        p._cols.reserve(p._rowStart[nRows]);
+        for (size_t i = 0; i < nRows; i++) {
+            p._cols.insert(p._cols.end(), sparsity[i].begin(), sparsity[i].end());
+        }
+
+        return p;
+    }
+
+    /**
+     * @return the number of rows
+     */
+    inline size_t rows() const {
+        return _rowStart.size() - 1;
+    }
+
+    /**
+     * @return the number of columns
+     */
+    inline size_t columns() const {
+        return _nCols;
+    }
+
+    /**
+     * @return the total number of non-zero elements
+     */
+    inline size_t nnz() const {
+        return _cols.size();
+    }
+
+    /**
+     * @return the number of non-zero elements in a row
+     */
+    inline size_t rowSize(size_t i) const {
+        return _rowStart[i + 1] - _rowStart[i];
+    }
+
+    /**
+     * @return the sorted column indexes of the non-zero elements in a row
+     */
+    inline ArrayView<const size_t> row(size_t i) const {
+        return ArrayView<const size_t>(_cols.data() + _rowStart[i], rowSize(i));
+    }
+
+    /**
+     * Determines whether or not an element is non-zero.
+     *
+     * @param i the row index
+     * @param j the column index
+     */
+    inline bool contains(size_t i,
+                         size_t j) const {
+        if (!_bitsetStart.empty() && _bitsetStart[i] != (std::numeric_limits<size_t>::max)()) {
+            return (_bits[_bitsetStart[i] + j / 64] >> (j % 64)) & 1u;
+        }
+
+        auto begin = _cols.begin() + _rowStart[i];
+        auto end = _cols.begin() + _rowStart[i + 1];
+        return std::binary_search(begin, end, j);
+    }
+
+    /**
+     * Creates bitsets for the rows with at least one non-zero element for
+     * every 64 columns (the bitset uses no more memory than the column
+     * indexes of those rows).
+     * This allows contains() to be evaluated in constant time for dense
+     * rows.
+     */
+    inline void useBitsets() {
+        const size_t nRows = rows();
+        const size_t words = (_nCols + 63) / 64;
+
+        _bitsetStart.assign(nRows, (std::numeric_limits<size_t>::max)());
+        _bits.clear();
+
+        for (size_t i = 0; i < nRows; i++) {
+            if (rowSize(i) == 0 || rowSize(i) < words)
+                continue;
+
+            _bitsetStart[i] = _bits.size();
+            _bits.resize(_bits.size() + words, 0);
+            uint64_t* bits = &_bits[_bitsetStart[i]];
+            for (size_t j : row(i)) {
+                bits[j / 64] |= uint64_t(1) << (j % 64);
+            }
+        }
+
+        if (_bits.empty())
+            _bitsetStart.clear();
+    }
+
+    /**
+     * Provides the row and column indexes of all non-zero elements (sorted
+     * by row and then by column).
+     */
+    template<class VectorSize>
+    inline void toIndexes(VectorSize& rows,
+                          VectorSize& cols) const {
+        const size_t nRows = this->rows();
+
+        rows.resize(nnz());
+        cols.resize(nnz());
+
+        for (size_t i = 0; i < nRows; i++) {
+            for (size_t e = _rowStart[i]; e < _rowStart[i + 1]; e++) {
+                rows[e] = i;
+                cols[e] = _cols[e];
+            }
+        }
+    }
+
+    /**
+     * Creates a set-based representation of this pattern (e.g. for CppAD
+     * sparse drivers).
+     */
+    inline std::vector<std::set<size_t> > toSet() const {
+        const size_t nRows = rows();
+
+        std::vector<std::set<size_t> > sparsity(nRows);
+        for (size_t i = 0; i < nRows; i++) {
+            ArrayView<const size_t> r = row(i);
+            sparsity[i].insert(r.begin(), r.end());
+        }
+
+        return sparsity;
+    }
+
+    /**
+     * Creates a dense boolean representation of this pattern (row-major).
+     */
+    inline std::vector<bool> toBool() const {
+        const size_t nRows = rows();
+
+        std::vector<bool> sparsity(nRows * _nCols, false);
+        for (size_t i = 0; i < nRows; i++) {
+            for (size_t j : row(i)) {
+                sparsity[i * _nCols + j] = true;
+            }
+        }
+
+        return sparsity;
+    }
+
+    inline bool operator==(const SparsityPattern& other) const {
+        return _nCols == other._nCols && _rowStart == other._rowStart && _cols == other._cols;
+    }
+
+    inline bool operator!=(const SparsityPattern& other) const {
+        return !(*this == other);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
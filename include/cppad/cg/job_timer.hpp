@@ -329,6 +329,24 @@ public:
         _jobs.pop_back();
     }
 
+    /**
+     * Registers a job which was executed elsewhere (e.g. in a different
+     * thread) and which has already been completed.
+     *
+     * @param jobName the job name
+     * @param type the job type
+     * @param prefix a prefix for the job description
+     * @param beginTime the instant when the job actually started
+     */
+    inline void completedJob(const std::string& jobName,
+                             const JobType& type,
+                             const std::string& prefix,
+                             std::chrono::steady_clock::time_point beginTime) {
+        startingJob(jobName, type, prefix);
+        _jobs.back()._beginTime = beginTime;
+        finishedJob();
+    }
+
 };
 
 } // END cg namespace
@@ -0,0 +1,394 @@
+#ifndef CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+#define CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Instructions of a bytecode program
+ */
+enum class BytecodeOp : uint8_t {
+    Assign,    // r = a
+    Abs,       // r = abs(a)
+    Acos,      // r = acos(a)
+    Acosh,     // r = acosh(a)
+    Add,       // r = a + b
+    Asin,      // r = asin(a)
+    Asinh,     // r = asinh(a)
+    Atan,      // r = atan(a)
+    Atanh,     // r = atanh(a)
+    ComLt,     // r = a < b ? c : d
+    ComLe,     // r = a <= b ? c : d
+    ComEq,     // r = a == b ? c : d
+    ComGe,     // r = a >= b ? c : d
+    ComGt,     // r = a > b ? c : d
+    ComNe,     // r = a != b ? c : d
+    Cosh,      // r = cosh(a)
+    Cos,       // r = cos(a)
+    Div,       // r = a / b
+    Erf,       // r = erf(a)
+    Exp,       // r = exp(a)
+    Expm1,     // r = expm1(a)
+    Log,       // r = log(a)
+    Log1p,     // r = log1p(a)
+    Mul,       // r = a * b
+    Pow,       // r = pow(a, b)
+    Sign,      // r = (a > 0)? 1 : ((a == 0)? 0 : -1)
+    Sinh,      // r = sinh(a)
+    Sin,       // r = sin(a)
+    Sqrt,      // r = sqrt(a)
+    Sub,       // r = a - b
+    Tanh,      // r = tanh(a)
+    Tan,       // r = tan(a)
+    UnMinus    // r = -a
+};
+
+/**
+ * A linear register-based program which evaluates an operation graph
+ * without any compilation.
+ *
+ * All values are kept in a single array of registers:
+ *  - register 0 is not used;
+ *  - the following registers hold the input values (all input arrays
+ *    in sequence);
+ *  - the following registers hold the dependent and temporary variables
+ *    (temporary registers are reused);
+ *  - the last registers hold the constants used by the program.
+ *
+ * Instructions are saved as a structure of arrays (the operation code, the
+ * result register and the first two argument registers).
+ * The two additional arguments of conditional operations are saved in
+ * separate arrays in the order they are executed.
+ *
+ * Programs are created by LanguageBytecode.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeProgram {
+public:
+    using Register = uint32_t;
+protected:
+    /// the sizes of the input arrays
+    std::vector<size_t> _inputSizes;
+    /// the total number of registers
+    size_t _registerCount;
+    /// the register of the first constant
+    size_t _constantStart;
+    /// the constant values
+    std::vector<Base> _constants;
+    /// the operation of each instruction
+    std::vector<BytecodeOp> _op;
+    /// the result register of each instruction
+    std::vector<Register> _result;
+    /// the first argument register of each instruction
+    std::vector<Register> _arg0;
+    /// the second argument register of each instruction (if used)
+    std::vector<Register> _arg1;
+    /// the register used when a conditional operation is true
+    std::vector<Register> _condTrue;
+    /// the register used when a conditional operation is false
+    std::vector<Register> _condFalse;
+    /// the register of each dependent variable
+    std::vector<Register> _output;
+public:
+
+    inline BytecodeProgram() :
+        _registerCount(1),
+        _constantStart(1) {
+    }
+
+    /**
+     * @return the sizes of each input array
+     */
+    inline const std::vector<size_t>& getInputSizes() const {
+        return _inputSizes;
+    }
+
+    /**
+     * @return the total number of input values
+     */
+    inline size_t getInputSize() const {
+        size_t s = 0;
+        for (size_t size : _inputSizes)
+            s += size;
+        return s;
+    }
+
+    /**
+     * @return the number of dependent variables
+     */
+    inline size_t getOutputSize() const {
+        return _output.size();
+    }
+
+    /**
+     * @param i the dependent variable index
+     * @return the register with the value of a dependent variable
+     */
+    inline Register getOutputRegister(size_t i) const {
+        return _output[i];
+    }
+
+    /**
+     * @return the number of instructions
+     */
+    inline size_t getInstructionCount() const {
+        return _op.size();
+    }
+
+    /**
+     * @return the total number of registers required to evaluate the
+     *         program
+     */
+    inline size_t getRegisterCount() const {
+        return _registerCount;
+    }
+
+    /**
+     * Prepares an array of registers to be used by this program (the
+     * constants are only defined once).
+     *
+     * @param registers the registers
+     */
+    inline void initRegisters(std::vector<Base>& registers) const {
+        registers.resize(_registerCount);
+        std::copy(_constants.begin(), _constants.end(), registers.begin() + _constantStart);
+    }
+
+    /**
+     * Evaluates the program.
+     *
+     * @param registers registers previously prepared with initRegisters()
+     * @param in the input arrays (with the sizes in getInputSizes())
+     * @param out the output array (with getOutputSize() elements)
+     */
+    inline void evaluate(std::vector<Base>& registers,
+                         const Base* const* in,
+                         Base* out) const {
+        CPPADCG_ASSERT_KNOWN(registers.size() == _registerCount, "Invalid registers (prepared for a different program?)");
+
+        Base* r = registers.data();
+
+        size_t p = 1;
+        for (size_t a = 0; a < _inputSizes.size(); a++) {
+            std::copy(in[a], in[a] + _inputSizes[a], r + p);
+            p += _inputSizes[a];
+        }
+
+        run(r);
+
+        const size_t m = _output.size();
+        for (size_t i = 0; i < m; i++) {
+            out[i] = r[_output[i]];
+        }
+    }
+
+    /**
+     * Executes all the instructions.
+     *
+     * @param r the registers with the input values and constants already
+     *          defined
+     */
+    inline void run(Base* r) const {
+        using std::abs;
+        using std::acos;
+        using std::asin;
+        using std::atan;
+        using std::cosh;
+        using std::cos;
+        using std::exp;
+        using std::log;
+        using std::pow;
+        using std::sinh;
+        using std::sin;
+        using std::sqrt;
+        using std::tanh;
+        using std::tan;
+        using std::acosh;
+        using std::asinh;
+        using std::atanh;
+        using std::erf;
+        using std::expm1;
+        using std::log1p;
+
+        const size_t nOps = _op.size();
+        const BytecodeOp* op = _op.data();
+        const Register* res = _result.data();
+        const Register* a0 = _arg0.data();
+        const Register* a1 = _arg1.data();
+        const Register* ct = _condTrue.data();
+        const Register* cf = _condFalse.data();
+
+        for (size_t i = 0; i < nOps; i++) {
+            const Base& a = r[a0[i]];
+
+            switch (op[i]) {
+                case BytecodeOp::Assign:
+                    r[res[i]] = a;
+                    break;
+                case BytecodeOp::Abs:
+                    r[res[i]] = abs(a);
+                    break;
+                case BytecodeOp::Acos:
+                    r[res[i]] = acos(a);
+                    break;
+                case BytecodeOp::Acosh:
+                    r[res[i]] = acosh(a);
+                    break;
+                case BytecodeOp::Add:
+                    r[res[i]] = a + r[a1[i]];
+                    break;
+                case BytecodeOp::Asin:
+                    r[res[i]] = asin(a);
+                    break;
+                case BytecodeOp::Asinh:
+                    r[res[i]] = asinh(a);
+                    break;
+                case BytecodeOp::Atan:
+                    r[res[i]] = atan(a);
+                    break;
+                case BytecodeOp::Atanh:
+                    r[res[i]] = atanh(a);
+                    break;
+                case BytecodeOp::ComLt:
+                    r[res[i]] = a < r[a1[i]] ? r[*ct] : r[*cf];
+                    ++ct, ++cf;
+                    break;
+                case BytecodeOp::ComLe:
+                    r[res[i]] = a <= r[a1[i]] ? r[*ct] : r[*cf];
+                    ++ct, ++cf;
+                    break;
+                case BytecodeOp::ComEq:
+                    r[res[i]] = a == r[a1[i]] ? r[*ct] : r[*cf];
+                    ++ct, ++cf;
+                    break;
+                case BytecodeOp::ComGe:
+                    r[res[i]] = a >= r[a1[i]] ? r[*ct] : r[*cf];
+                    ++ct, ++cf;
+                    break;
+                case BytecodeOp::ComGt:
+                    r[res[i]] = a > r[a1[i]] ? r[*ct] : r[*cf];
+                    ++ct, ++cf;
+                    break;
+                case BytecodeOp::ComNe:
+                    r[res[i]] = a != r[a1[i]] ? r[*ct] : r[*cf];
+                    ++ct, ++cf;
+                    break;
+                case BytecodeOp::Cosh:
+                    r[res[i]] = cosh(a);
+                    break;
+                case BytecodeOp::Cos:
+                    r[res[i]] = cos(a);
+                    break;
+                case BytecodeOp::Div:
+                    r[res[i]] = a / r[a1[i]];
+                    break;
+                case BytecodeOp::Erf:
+                    r[res[i]] = erf(a);
+                    break;
+                case BytecodeOp::Exp:
+                    r[res[i]] = exp(a);
+                    break;
+                case BytecodeOp::Expm1:
+                    r[res[i]] = expm1(a);
+                    break;
+                case BytecodeOp::Log:
+                    r[res[i]] = log(a);
+                    break;
+                case BytecodeOp::Log1p:
+                    r[res[i]] = log1p(a);
+                    break;
+                case BytecodeOp::Mul:
+                    r[res[i]] = a * r[a1[i]];
+                    break;
+                case BytecodeOp::Pow:
+                    r[res[i]] = pow(a, r[a1[i]]);
+                    break;
+                case BytecodeOp::Sign:
+                    r[res[i]] = a > Base(0) ? Base(1) : (a == Base(0) ? Base(0) : Base(-1));
+                    break;
+                case BytecodeOp::Sinh:
+                    r[res[i]] = sinh(a);
+                    break;
+                case BytecodeOp::Sin:
+                    r[res[i]] = sin(a);
+                    break;
+                case BytecodeOp::Sqrt:
+                    r[res[i]] = sqrt(a);
+                    break;
+                case BytecodeOp::Sub:
+                    r[res[i]] = a - r[a1[i]];
+                    break;
+                case BytecodeOp::Tanh:
+                    r[res[i]] = tanh(a);
+                    break;
+                case BytecodeOp::Tan:
+                    r[res[i]] = tan(a);
+                    break;
+                case BytecodeOp::UnMinus:
+                    r[res[i]] = -a;
+                    break;
+            }
+        }
+    }
+
+    /**
+     * Prints out the instructions in a human readable format.
+     */
+    inline void print(std::ostream& out) const {
+        size_t c = 0;
+        for (size_t i = 0; i < _op.size(); i++) {
+            out << "r" << _result[i] << " = " << opName(_op[i]) << " r" << _arg0[i];
+            if (isBinary(_op[i])) {
+                out << " r" << _arg1[i];
+            } else if (isConditional(_op[i])) {
+                out << " r" << _arg1[i] << " r" << _condTrue[c] << " r" << _condFalse[c];
+                c++;
+            }
+            out << "\n";
+        }
+        for (size_t i = 0; i < _output.size(); i++) {
+            out << "y[" << i << "] = r" << _output[i] << "\n";
+        }
+    }
+
+    static inline bool isBinary(BytecodeOp op) {
+        return op == BytecodeOp::Add || op == BytecodeOp::Div || op == BytecodeOp::Mul ||
+               op == BytecodeOp::Pow || op == BytecodeOp::Sub;
+    }
+
+    static inline bool isConditional(BytecodeOp op) {
+        return op == BytecodeOp::ComLt || op == BytecodeOp::ComLe || op == BytecodeOp::ComEq ||
+               op == BytecodeOp::ComGe || op == BytecodeOp::ComGt || op == BytecodeOp::ComNe;
+    }
+
+    static inline const char* opName(BytecodeOp op) {
+        static const char* const names[] = {"assign", "abs", "acos", "acosh", "add", "asin", "asinh", "atan", "atanh",
+                                            "lt", "le", "eq", "ge", "gt", "ne", "cosh", "cos", "div", "erf", "exp",
+                                            "expm1", "log", "log1p", "mul", "pow", "sign", "sinh", "sin", "sqrt", "sub",
+                                            "tanh", "tan", "neg"};
+        return names[size_t(op)];
+    }
+
+    friend class LanguageBytecode<Base>;
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef CPPAD_CG_LANGUAGE_BYTECODE_INCLUDED
+#define CPPAD_CG_LANGUAGE_BYTECODE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates a bytecode program (see BytecodeProgram) from an operation graph
+ * which can be evaluated without any compilation.
+ *
+ * The variable order and the (reused) temporary variable IDs determined by
+ * the CodeHandler are used as the instruction order and registers.
+ * Only operations without arrays, atomic functions, loops, and if-else
+ * blocks are supported.
+ * The output stream provided to the code handler is not used.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageBytecode : public Language<Base> {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+    using Register = typename BytecodeProgram<Base>::Register;
+protected:
+    // information from the code handler (not owned)
+    LanguageGenerationData<Base>* _info;
+    // the sizes of the input arrays (an empty vector means a single array)
+    std::vector<size_t> _inputSizes;
+    // the generated program
+    BytecodeProgram<Base> _program;
+    // maps constant values to their registers
+    std::map<Base, Register> _constantRegisters;
+public:
+
+    /**
+     * Creates a bytecode generator.
+     *
+     * @param inputSizes the sizes of the input arrays which contain the
+     *                   independent variables (by default all independent
+     *                   variables are in a single array)
+     */
+    inline explicit LanguageBytecode(const std::vector<size_t>& inputSizes = std::vector<size_t>()) :
+        _info(nullptr),
+        _inputSizes(inputSizes) {
+    }
+
+    inline virtual ~LanguageBytecode() = default;
+
+    /**
+     * Provides the last program created with this object
+     */
+    inline const BytecodeProgram<Base>& getProgram() const {
+        return _program;
+    }
+
+    inline BytecodeProgram<Base>& getProgram() {
+        return _program;
+    }
+
+protected:
+
+    void generateSourceCode(std::ostream& out,
+                            std::unique_ptr<LanguageGenerationData<Base> > info) override {
+        _info = info.get();
+        _program = BytecodeProgram<Base>();
+        _constantRegisters.clear();
+
+        const std::vector<Node*>& variableOrder = _info->variableOrder;
+        const ArrayView<CG<Base> >& dependent = _info->dependent;
+
+        /**
+         * inputs
+         */
+        size_t n = _info->independent.size();
+        if (_inputSizes.empty()) {
+            _program._inputSizes.push_back(n);
+        } else {
+            _program._inputSizes = _inputSizes;
+            if (_program.getInputSize() != n) {
+                throw CGException("The input array sizes do not match the number of independent variables (", n, ")");
+            }
+        }
+
+        /**
+         * registers
+         */
+        size_t maxID = _info->minTemporaryVarID - 1;
+        for (const Node* node : variableOrder) {
+            maxID = std::max<size_t>(maxID, getVariableID(*node));
+        }
+        _program._constantStart = maxID + 1;
+        _program._registerCount = maxID + 1;
+
+        /**
+         * instructions
+         */
+        const size_t nOps = variableOrder.size();
+        _program._op.reserve(nOps);
+        _program._result.reserve(nOps);
+        _program._arg0.reserve(nOps);
+        _program._arg1.reserve(nOps);
+
+        for (Node* node : variableOrder) {
+            const std::vector<Arg>& args = node->getArguments();
+            BytecodeOp op = getBytecodeOp(*node);
+
+            size_t nArgs = 1;
+            if (BytecodeProgram<Base>::isBinary(op))
+                nArgs = 2;
+            else if (BytecodeProgram<Base>::isConditional(op))
+                nArgs = 4;
+
+            if (args.size() != nArgs) {
+                throw CGException("Invalid number of arguments for operation '", node->getOperationType(), "'");
+            }
+
+            _program._op.push_back(op);
+            _program._result.push_back(Register(getVariableID(*node)));
+            _program._arg0.push_back(getRegister(args[0]));
+            _program._arg1.push_back(nArgs > 1 ? getRegister(args[1]) : 0);
+            if (nArgs == 4) {
+                _program._condTrue.push_back(getRegister(args[2]));
+                _program._condFalse.push_back(getRegister(args[3]));
+            }
+        }
+
+        /**
+         * outputs
+         */
+        _program._output.resize(dependent.size());
+        for (size_t i = 0; i < dependent.size(); i++) {
+            const CG<Base>& dep = dependent[i];
+            if (dep.getOperationNode() != nullptr) {
+                _program._output[i] = getRegister(Arg(*dep.getOperationNode()));
+            } else {
+                _program._output[i] = getConstantRegister(dep.getValue());
+            }
+        }
+
+        if (_program._registerCount > (std::numeric_limits<Register>::max)()) {
+            throw CGException("Too many registers required by the bytecode program (", _program._registerCount, ")");
+        }
+
+        _info = nullptr;
+        _constantRegisters.clear();
+    }
+
+    bool createsNewVariable(const Node& var,
+                            size_t totalUseCount,
+                            size_t opCount) const override {
+        // each operation has its own instruction
+        return true;
+    }
+
+    bool requiresVariableArgument(enum CGOpCode op,
+                                  size_t argIndex) const override {
+        return false;
+    }
+
+    bool requiresVariableDependencies() const override {
+        return false;
+    }
+
+    inline size_t getVariableID(const Node& node) const {
+        return _info->varId[node];
+    }
+
+    /**
+     * Provides the register with the value of an argument
+     */
+    inline Register getRegister(const Arg& arg) {
+        const Node* node = arg.getOperation();
+        if (node == nullptr) {
+            return getConstantRegister(*arg.getParameter());
+        }
+
+        // aliases never have their own variable
+        while (node->getOperationType() == CGOpCode::Alias) {
+            const Arg& a = node->getArguments()[0];
+            if (a.getOperation() == nullptr) {
+                return getConstantRegister(*a.getParameter());
+            }
+            node = a.getOperation();
+        }
+
+        size_t id = getVariableID(*node);
+        CPPADCG_ASSERT_UNKNOWN(id > 0 && id < _program._constantStart);
+        return Register(id);
+    }
+
+    /**
+     * Provides the register with a constant value (constants are never
+     * repeated)
+     */
+    inline Register getConstantRegister(const Base& value) {
+        if (value == value) { // not NaN
+            auto it = _constantRegisters.find(value);
+            if (it != _constantRegisters.end())
+                return it->second;
+        }
+
+        Register r = Register(_program._registerCount++);
+        _program._constants.push_back(value);
+        if (value == value)
+            _constantRegisters[value] = r;
+        return r;
+    }
+
+    static inline BytecodeOp getBytecodeOp(const Node& node) {
+        switch (node.getOperationType()) {
+            case CGOpCode::Assign:
+                return BytecodeOp::Assign;
+            case CGOpCode::Abs:
+                return BytecodeOp::Abs;
+            case CGOpCode::Acos:
+                return BytecodeOp::Acos;
+            case CGOpCode::Acosh:
+                return BytecodeOp::Acosh;
+            case CGOpCode::Add:
+                return BytecodeOp::Add;
+            case CGOpCode::Asin:
+                return BytecodeOp::Asin;
+            case CGOpCode::Asinh:
+                return BytecodeOp::Asinh;
+            case CGOpCode::Atan:
+                return BytecodeOp::Atan;
+            case CGOpCode::Atanh:
+                return BytecodeOp::Atanh;
+            case CGOpCode::ComLt:
+                return BytecodeOp::ComLt;
+            case CGOpCode::ComLe:
+                return BytecodeOp::ComLe;
+            case CGOpCode::ComEq:
+                return BytecodeOp::ComEq;
+            case CGOpCode::ComGe:
+                return BytecodeOp::ComGe;
+            case CGOpCode::ComGt:
+                return BytecodeOp::ComGt;
+            case CGOpCode::ComNe:
+                return BytecodeOp::ComNe;
+            case CGOpCode::Cosh:
+                return BytecodeOp::Cosh;
+            case CGOpCode::Cos:
+                return BytecodeOp::Cos;
+            case CGOpCode::Div:
+                return BytecodeOp::Div;
+            case CGOpCode::Erf:
+                return BytecodeOp::Erf;
+            case CGOpCode::Exp:
+                return BytecodeOp::Exp;
+            case CGOpCode::Expm1:
+                return BytecodeOp::Expm1;
+            case CGOpCode::Log:
+                return BytecodeOp::Log;
+            case CGOpCode::Log1p:
+                return BytecodeOp::Log1p;
+            case CGOpCode::Mul:
+                return BytecodeOp::Mul;
+            case CGOpCode::Pow:
+                return BytecodeOp::Pow;
+            case CGOpCode::Sign:
+                return BytecodeOp::Sign;
+            case CGOpCode::Sinh:
+                return BytecodeOp::Sinh;
+            case CGOpCode::Sin:
+                return BytecodeOp::Sin;
+            case CGOpCode::Sqrt:
+                return BytecodeOp::Sqrt;
+            case CGOpCode::Sub:
+                return BytecodeOp::Sub;
+            case CGOpCode::Tanh:
+                return BytecodeOp::Tanh;
+            case CGOpCode::Tan:
+                return BytecodeOp::Tan;
+            case CGOpCode::UnMinus:
+                return BytecodeOp::UnMinus;
+            default:
+                throw CGException("Operation '", node.getOperationType(), "' is not supported by bytecode programs");
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
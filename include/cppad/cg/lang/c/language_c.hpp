@@ -99,6 +99,8 @@ protected:
     size_t _maxOperationsPerAssignment;
     //  maps file names to with their contents
     std::map<std::string, std::string>* _sources;
+    // receives the source files as soon as they are complete (used instead of _sources if defined)
+    SourceFileSink* _sourceSink;
     // the values in the temporary array
     std::vector<const Arg*> _tmpArrayValues;
     // the values in the temporary sparse array
@@ -110,6 +112,10 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // atomic functions called directly (atomic function name -> C function name prefix)
+    std::map<std::string, std::string> _directAtomicFunctions;
+    // the C function used to evaluate tasks at the same time (empty if tasks are not used)
+    std::string _parallelTaskRunner;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -142,6 +148,7 @@ public:
         _maxAssignmentsPerFunction(0),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
         _sources(nullptr),
+        _sourceSink(nullptr),
         _parameterPrecision(std::numeric_limits<Base>::digits10) {
     }
 
@@ -238,6 +245,59 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Provides the atomic functions which are called directly instead of
+     * through the LangCAtomicFun callbacks.
+     *
+     * @return maps atomic function names to C function name prefixes
+     */
+    inline const std::map<std::string, std::string>& getDirectAtomicFunctions() const {
+        return _directAtomicFunctions;
+    }
+
+    /**
+     * Defines atomic functions which are called directly instead of
+     * through the LangCAtomicFun callbacks.
+     * For an atomic function with the prefix P, the generated source code
+     * will call the C functions
+     *   int P_forward(struct LangCAtomicFun atomicFun, int atomicIndex, int q, int p, const Array tx[], Array* ty)
+     *   int P_reverse(struct LangCAtomicFun atomicFun, int atomicIndex, int p, const Array tx[], Array* px, const Array py[])
+     * which must be provided elsewhere (with the same arguments as the
+     * callbacks, except for libModel).
+     *
+     * @param functions maps atomic function names to C function name
+     *                  prefixes
+     */
+    inline void setDirectAtomicFunctions(const std::map<std::string, std::string>& functions) {
+        _directAtomicFunctions = functions;
+    }
+
+    /**
+     * Provides the name of the C function used to evaluate independent
+     * tasks at the same time (empty if tasks are not used).
+     */
+    inline const std::string& getParallelTaskRunner() const {
+        return _parallelTaskRunner;
+    }
+
+    /**
+     * Defines the C function used to evaluate the tasks created by the
+     * CodeHandler (see CodeHandler::setParallelTasks()) at the same time.
+     * Each task is placed in its own local function and the generated
+     * function will call
+     *   void runner(void (*function)(void*), void* args[], const int nDeps[], const int succStart[], const int succ[], int nTasks)
+     * which must be provided elsewhere (e.g. cppadcg_thpool_run_task_graph()
+     * from the model library thread pool).
+     * The tasks are only used when a function is generated and the sources
+     * are saved in a map (see setMaxAssignmentsPerFunction()).
+     *
+     * @param runner the name of the C function which evaluates the tasks
+     *               (an empty string disables tasks)
+     */
+    inline void setParallelTaskRunner(const std::string& runner) {
+        _parallelTaskRunner = runner;
+    }
+
     /**
      * Defines the maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -255,6 +315,30 @@ public:
         _sources = sources;
     }
 
+    /**
+     * Provides the object which receives the generated source files as
+     * soon as each one is complete.
+     *
+     * @return the source file sink (null if the files are saved in the
+     *         map defined in setMaxAssignmentsPerFunction())
+     */
+    inline SourceFileSink* getSourceSink() const {
+        return _sourceSink;
+    }
+
+    /**
+     * Defines an object which receives the generated source files as soon
+     * as each one is complete instead of saving them in the map provided
+     * to setMaxAssignmentsPerFunction().
+     * This avoids keeping all the local functions of a very large function
+     * in memory.
+     *
+     * @param sink the source file sink (null to use the map)
+     */
+    inline void setSourceSink(SourceFileSink* sink) {
+        _sourceSink = sink;
+    }
+
     /**
      * The maximum number of operations per variable assignment.
      *
@@ -277,7 +361,8 @@ public:
     inline std::string generateTemporaryVariableDeclaration(bool isWrapperFunction,
                                                             bool zeroArrayDependents,
                                                             const std::vector<int>& atomicMaxForward,
-                                                            const std::vector<int>& atomicMaxReverse) {
+                                                            const std::vector<int>& atomicMaxReverse,
+                                                            bool heapTemporaries = false) {
         int maxForward = -1;
         if (!atomicMaxForward.empty())
             maxForward = *std::max_element(atomicMaxForward.begin(), atomicMaxForward.end());
@@ -287,7 +372,7 @@ public:
             maxReverse = *std::max_element(atomicMaxReverse.begin(), atomicMaxReverse.end());
 
         return generateTemporaryVariableDeclaration(isWrapperFunction, zeroArrayDependents,
-                                                    maxForward, maxReverse);
+                                                    maxForward, maxReverse, heapTemporaries);
     }
 
     /**
@@ -303,12 +388,17 @@ public:
      *                        atomic functions
      * @param maxReverseOrder the maximum order of reverse mode calls to
      *                        atomic functions
+     * @param heapTemporaries whether or not the array with the temporary
+     *                        variables is only declared as a pointer (it
+     *                        must then be allocated on the heap, see
+     *                        printTemporaryVariableAllocation())
      * @return the string with the declarations for the temporary variables
      */
     virtual std::string generateTemporaryVariableDeclaration(bool isWrapperFunction = false,
                                                              bool zeroArrayDependents = false,
                                                              int maxForwardOrder = -1,
-                                                             int maxReverseOrder = -1) {
+                                                             int maxReverseOrder = -1,
+                                                             bool heapTemporaries = false) {
         CPPADCG_ASSERT_UNKNOWN(_nameGen != nullptr);
 
         // declare variables
@@ -323,7 +413,9 @@ public:
          */
         if (tmpArg[0].array) {
             size_t size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
-            if (size > 0 || isWrapperFunction) {
+            if (heapTemporaries) {
+                _ss << _spaces << _baseTypeName << "* " << tmpArg[0].name << ";\n";
+            } else if (size > 0 || isWrapperFunction) {
                 _ss << _spaces << _baseTypeName << " " << tmpArg[0].name << "[" << size << "];\n";
             }
         } else if (_temporary.size() > 0) {
@@ -663,7 +755,9 @@ protected:
                             std::unique_ptr<LanguageGenerationData<Base> > info) override {
 
         const bool createFunction = !_functionName.empty();
-        const bool multiFunction = createFunction && _maxAssignmentsPerFunction > 0 && _sources != nullptr;
+        const bool multiFunction = createFunction && _maxAssignmentsPerFunction > 0 && hasSourceFileOutput();
+        // each task is placed in a different local function
+        const bool taskFunctions = !info->taskStart.empty() && supportsParallelTasks();
 
         // clean up
         _code.str("");
@@ -780,7 +874,9 @@ protected:
 
         // the names of local functions
         std::vector<std::string> localFuncNames;
-        if (multiFunction) {
+        if (taskFunctions) {
+            localFuncNames.reserve(_info->taskStart.size());
+        } else if (multiFunction) {
             localFuncNames.reserve(variableOrder.size() / _maxAssignmentsPerFunction);
         }
 
@@ -822,11 +918,18 @@ protected:
             }
 
             size_t assignCount = 0;
+            size_t nextTask = 1;
             for (size_t i = 0; i < variableOrder.size(); ++i) {
                 Node* it = variableOrder[i];
 
                 // check if a new function should start
-                if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
+                if (taskFunctions) {
+                    if (nextTask < _info->taskStart.size() && i == _info->taskStart[nextTask]) {
+                        assignCount = 0;
+                        nextTask++;
+                        saveLocalFunction(localFuncNames, false);
+                    }
+                } else if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
                     assignCount = 0;
                     saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
                 }
@@ -849,7 +952,7 @@ protected:
                 CPPAD_ASSERT_KNOWN(_streamStack.empty(), "Error writing all operations to output stream")
             }
 
-            if (!localFuncNames.empty() && assignCount > 0) {
+            if (taskFunctions || (!localFuncNames.empty() && assignCount > 0)) {
                 assignCount = 0;
                 saveLocalFunction(localFuncNames, false);
             }
@@ -862,6 +965,10 @@ protected:
             CPPADCG_ASSERT_KNOWN(tmpArg[0].array,
                                  "The temporary variables must be saved in an array in order to generate multiple functions")
 
+            if (taskFunctions) {
+                _code << "#include <stdio.h>\n"
+                         "#include <stdlib.h>\n\n";
+            }
             _code << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
             // forward declarations
             std::string localFuncArgDcl2 = implode(localFuncArgDcl_, ", ");
@@ -869,6 +976,9 @@ protected:
                 _code << "void " << localFuncName << "(" << localFuncArgDcl2 << ");\n";
             }
             _code << "\n";
+            if (taskFunctions) {
+                printTaskDefinitions();
+            }
             printFunctionDeclaration(_code, "void", _functionName, funcArgDcl_);
             _code  << " {\n";
             _nameGen->customFunctionVariableDeclarations(_code);
@@ -876,10 +986,19 @@ protected:
             _code << generateDependentVariableDeclaration() << "\n";
             _code << generateTemporaryVariableDeclaration(true, false,
                                                           _info->atomicFunctionsMaxForward,
-                                                          _info->atomicFunctionsMaxReverse) << "\n";
+                                                          _info->atomicFunctionsMaxReverse,
+                                                          taskFunctions) << "\n";
+            if (taskFunctions) {
+                printTaskGraphDeclaration(localFuncNames);
+            }
             _nameGen->prepareCustomFunctionVariables(_code);
-            for (auto & localFuncName : localFuncNames) {
-                _code << _spaces << localFuncName << "(" << localFuncArgs_ << ");\n";
+            if (taskFunctions) {
+                printTemporaryVariableAllocation();
+                printTaskGraphEvaluation(localFuncNames.size());
+            } else {
+                for (auto & localFuncName : localFuncNames) {
+                    _code << _spaces << localFuncName << "(" << localFuncArgs_ << ");\n";
+                }
             }
         }
 
@@ -928,6 +1047,7 @@ protected:
                 _ss << "#include <math.h>\n"
                         "#include <stdio.h>\n\n"
                     << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                printDirectAtomicFunctionDeclarations(_ss);
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
                 _nameGen->customFunctionVariableDeclarations(_ss);
@@ -943,14 +1063,17 @@ protected:
 
                 out << _ss.str();
 
-                if (_sources != nullptr) {
-                    (*_sources)[_functionName + ".c"] = _ss.str();
+                if (hasSourceFileOutput()) {
+                    saveSourceFile(_functionName + ".c", _ss.str());
                 }
             } else {
+                if (taskFunctions) {
+                    _code << _spaces << "free(" << tmpArg[0].name << ");\n";
+                }
                 _nameGen->finalizeCustomFunctionVariables(_code);
                 _code << "}\n\n";
 
-                (*_sources)[_functionName + ".c"] = _code.str();
+                saveSourceFile(_functionName + ".c", _code.str());
             }
         } else {
             out << _code.str();
@@ -1043,6 +1166,26 @@ protected:
         return dcl + " " + funcArg.name;
     }
 
+    /**
+     * @return whether or not complete source files can be created (in the
+     *         source map or in the source sink)
+     */
+    inline bool hasSourceFileOutput() const {
+        return _sources != nullptr || _sourceSink != nullptr;
+    }
+
+    /**
+     * Saves a complete source file in the source sink or in the source map.
+     */
+    inline void saveSourceFile(const std::string& name,
+                               std::string&& source) {
+        if (_sourceSink != nullptr) {
+            _sourceSink->addSource(name, std::move(source));
+        } else {
+            (*_sources)[name] = std::move(source);
+        }
+    }
+
     virtual void saveLocalFunction(std::vector<std::string>& localFuncNames,
                                    bool zeroDependentArray) {
         _ss << _functionName << "__" << (localFuncNames.size() + 1);
@@ -1052,6 +1195,7 @@ protected:
         _ss << "#include <math.h>\n"
                 "#include <stdio.h>\n\n"
                 << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+        printDirectAtomicFunctionDeclarations(_ss);
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
         _nameGen->customFunctionVariableDeclarations(_ss);
@@ -1079,13 +1223,131 @@ protected:
         _nameGen->finalizeCustomFunctionVariables(_ss);
         _ss << "}\n\n";
 
-        (*_sources)[funcName + ".c"] = _ss.str();
+        saveSourceFile(funcName + ".c", _ss.str());
         localFuncNames.push_back(funcName);
 
         _code.str("");
         _ss.str("");
     }
 
+    /**
+     * Defines the structure with the arguments of a task (local function)
+     * and the function which evaluates a task (used by the task runner).
+     */
+    virtual void printTaskDefinitions() {
+        const std::vector<FuncArgument>& tmpArg = _nameGen->getTemporary();
+        std::vector<std::string> argNames{_inArgName, _outArgName, _atomicArgName,
+                                          tmpArg[0].name, tmpArg[1].name, tmpArg[2].name,
+                                          _C_SPARSE_INDEX_ARRAY};
+        CPPADCG_ASSERT_UNKNOWN(argNames.size() == localFuncArgDcl_.size())
+
+        const std::string taskType = _functionName + "__task";
+
+        _code << "typedef struct " << taskType << " {\n"
+                 "   void (*function)(" << implode(localFuncArgDcl_, ", ") << ");\n";
+        for (const std::string& dcl : localFuncArgDcl_) {
+            _code << "   " << dcl << ";\n";
+        }
+        _code << "} " << taskType << ";\n"
+                 "\n"
+                 "void " << _parallelTaskRunner << "(void (*function)(void*), void* args[], const int nDeps[], const int succStart[], const int succ[], int nTasks);\n"
+                 "\n"
+                 "static void " << _functionName << "__run_task(void* arg) {\n"
+                 "   " << taskType << "* t = (" << taskType << "*) arg;\n"
+                 "   (*t->function)(";
+        for (size_t a = 0; a < argNames.size(); ++a) {
+            if (a > 0) _code << ", ";
+            _code << "t->" << argNames[a];
+        }
+        _code << ");\n"
+                 "}\n"
+                 "\n";
+    }
+
+    /**
+     * Declares the variables with the dependencies between tasks in the
+     * wrapper function.
+     */
+    virtual void printTaskGraphDeclaration(const std::vector<std::string>& taskFuncNames) {
+        const std::vector<std::set<size_t>>& taskDeps = _info->taskDependencies;
+        const size_t nTasks = taskFuncNames.size();
+        CPPADCG_ASSERT_UNKNOWN(taskDeps.size() == nTasks)
+
+        // the tasks which depend on each task
+        std::vector<std::vector<size_t>> successors(nTasks);
+        for (size_t t = 0; t < nTasks; ++t) {
+            for (size_t d : taskDeps[t]) {
+                successors[d].push_back(t);
+            }
+        }
+
+        auto printArray = [this](const std::string& dcl, const std::vector<size_t>& values) {
+            _code << _spaces << "static const int " << dcl << "[" << std::max<size_t>(values.size(), 1) << "] = {";
+            for (size_t e = 0; e < values.size(); ++e) {
+                if (e > 0) _code << ", ";
+                _code << values[e];
+            }
+            if (values.empty()) _code << "0";
+            _code << "};\n";
+        };
+
+        std::vector<size_t> nDeps(nTasks);
+        std::vector<size_t> succStart(nTasks + 1, 0);
+        std::vector<size_t> succ;
+        for (size_t t = 0; t < nTasks; ++t) {
+            nDeps[t] = taskDeps[t].size();
+            succ.insert(succ.end(), successors[t].begin(), successors[t].end());
+            succStart[t + 1] = succ.size();
+        }
+
+        const std::string taskType = _functionName + "__task";
+
+        _code << _spaces << "static void (*const task_functions[" << nTasks << "])(" << implode(localFuncArgDcl_, ", ") << ") = {"
+              << implode(taskFuncNames, ", ") << "};\n";
+        printArray("task_n_deps", nDeps);
+        printArray("task_succ_start", succStart);
+        printArray("task_succ", succ);
+        _code << _spaces << taskType << " tasks[" << nTasks << "];\n"
+              << _spaces << "void* task_args[" << nTasks << "];\n"
+              << _spaces << "int ti;\n";
+    }
+
+    /**
+     * Allocates the array with the temporary variables on the heap in the
+     * wrapper function.
+     * Temporary variable IDs are not reused when the operations are split
+     * into tasks and, therefore, this array can be too large for the stack.
+     */
+    virtual void printTemporaryVariableAllocation() {
+        const std::vector<FuncArgument>& tmpArg = _nameGen->getTemporary();
+        size_t size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
+
+        _code << _spaces << tmpArg[0].name << " = (" << _baseTypeName << "*) malloc(" << std::max<size_t>(size, 1) << " * sizeof(" << _baseTypeName << "));\n"
+              << _spaces << "if (" << tmpArg[0].name << " == NULL) {\n"
+              << _spaces << _spaces << "fprintf(stderr, \"" << _functionName << "(): Could not allocate memory for the temporary variables\\n\");\n"
+              << _spaces << _spaces << "return;\n"
+              << _spaces << "}\n";
+    }
+
+    /**
+     * Evaluates all the tasks with the task runner.
+     */
+    virtual void printTaskGraphEvaluation(size_t nTasks) {
+        const std::vector<FuncArgument>& tmpArg = _nameGen->getTemporary();
+        std::vector<std::string> argNames{_inArgName, _outArgName, _atomicArgName,
+                                          tmpArg[0].name, tmpArg[1].name, tmpArg[2].name,
+                                          _C_SPARSE_INDEX_ARRAY};
+
+        _code << _spaces << "for(ti = 0; ti < " << nTasks << "; ti++) {\n"
+              << _spaces << _spaces << "tasks[ti].function = task_functions[ti];\n";
+        for (const std::string& name : argNames) {
+            _code << _spaces << _spaces << "tasks[ti]." << name << " = " << name << ";\n";
+        }
+        _code << _spaces << _spaces << "task_args[ti] = &tasks[ti];\n"
+              << _spaces << "}\n"
+              << _spaces << _parallelTaskRunner << "(" << _functionName << "__run_task, task_args, task_n_deps, task_succ_start, task_succ, " << nTasks << ");\n";
+    }
+
     bool createsNewVariable(const Node& var,
                             size_t totalUseCount,
                             size_t opCount) const override {
@@ -1230,6 +1492,10 @@ protected:
         return false;
     }
 
+    bool supportsParallelTasks() const override {
+        return !_parallelTaskRunner.empty() && !_functionName.empty() && hasSourceFileOutput() && _funcArgIndexes.empty();
+    }
+
     virtual void pushIndependentVariableName(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 0, "Invalid number of arguments for independent variable")
 
@@ -1782,6 +2048,29 @@ protected:
 
     virtual void pushArrayElementOp(Node& op);
 
+    /**
+     * Prints the declarations of the C functions for the atomic functions
+     * used by the current function which are called directly.
+     */
+    virtual void printDirectAtomicFunctionDeclarations(std::ostream& out) const {
+        if (_directAtomicFunctions.empty())
+            return;
+
+        std::set<std::string> prefixes;
+        for (const auto& it : _info->atomicFunctionId2Name) {
+            auto itDirect = _directAtomicFunctions.find(it.second);
+            if (itDirect != _directAtomicFunctions.end())
+                prefixes.insert(itDirect->second);
+        }
+
+        for (const std::string& prefix : prefixes) {
+            out << "int " << prefix << "_forward(struct LangCAtomicFun atomicFun, int atomicIndex, int q, int p, const Array tx[], Array* ty);\n"
+                   "int " << prefix << "_reverse(struct LangCAtomicFun atomicFun, int atomicIndex, int p, const Array tx[], Array* px, const Array py[]);\n";
+        }
+        if (!prefixes.empty())
+            out << "\n";
+    }
+
     virtual void pushAtomicForwardOp(Node& atomicFor) {
         CPPADCG_ASSERT_KNOWN(atomicFor.getInfo().size() == 3, "Invalid number of information elements for atomic forward operation")
         int q = atomicFor.getInfo()[1];
@@ -1812,10 +2101,16 @@ protected:
         printArrayStructInit(_ATOMIC_TY, *ty[p]); // also does indentation
         _ss.str("");
 
-        _streamStack << _indentation << "atomicFun.forward(atomicFun.libModel, "
-                     << atomicIndex << ", " << q << ", " << p << ", "
+        const std::string& atomicName = _info->atomicFunctionId2Name.at(id);
+        auto itDirect = _directAtomicFunctions.find(atomicName);
+        if (itDirect != _directAtomicFunctions.end()) {
+            _streamStack << _indentation << itDirect->second << "_forward(atomicFun, ";
+        } else {
+            _streamStack << _indentation << "atomicFun.forward(atomicFun.libModel, ";
+        }
+        _streamStack << atomicIndex << ", " << q << ", " << p << ", "
                      << _ATOMIC_TX << ", &" << _ATOMIC_TY << "); // "
-                     << _info->atomicFunctionId2Name.at(id)
+                     << atomicName
                      << "\n";
 
         /**
@@ -1860,10 +2155,16 @@ protected:
         printArrayStructInit(_ATOMIC_PX, *px[0]); // also does indentation
         _ss.str("");
 
-        _streamStack << _indentation << "atomicFun.reverse(atomicFun.libModel, "
-                     << atomicIndex << ", " << p << ", "
+        const std::string& atomicName = _info->atomicFunctionId2Name.at(id);
+        auto itDirect = _directAtomicFunctions.find(atomicName);
+        if (itDirect != _directAtomicFunctions.end()) {
+            _streamStack << _indentation << itDirect->second << "_reverse(atomicFun, ";
+        } else {
+            _streamStack << _indentation << "atomicFun.reverse(atomicFun.libModel, ";
+        }
+        _streamStack << atomicIndex << ", " << p << ", "
                      << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << "); // "
-                     << _info->atomicFunctionId2Name.at(id)
+                     << atomicName
                      << "\n";
 
         /**
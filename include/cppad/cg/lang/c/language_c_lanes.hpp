@@ -0,0 +1,305 @@
+#ifndef CPPAD_CG_LANGUAGE_C_LANES_INCLUDED
+#define CPPAD_CG_LANGUAGE_C_LANES_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#define CPPAD_CG_C_LANG_LANES_FUNCNAME(fn) \
+inline const std::string& fn ## FuncName() override {\
+    return laneFunctionName(#fn);\
+}
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Generates code for the C language where each variable holds the values
+ * of several independent evaluations (lanes).
+ *
+ * Variables are declared using a GCC/Clang vector extension type
+ * (e.g. <tt>double __attribute__((vector_size(32)))</tt> for 4 lanes of
+ * doubles) so that a single call to the generated function evaluates the
+ * model for several points at once.
+ * The element l of variable j is located at <tt>in[0][j * lanes + l]</tt>.
+ *
+ * The size of the vector type is determined by the C compiler from the
+ * element type name, which does not need to match Base.
+ *
+ * Only the arithmetic operations use the vector extension directly.
+ * Mathematical functions and conditional assignments are mapped to lane-wise
+ * helper functions which must be defined before the generated code
+ * (see generateLaneTypeDefinition()); these helpers are scalar loops over
+ * the lanes, which the C compiler may or may not vectorize.
+ * Atomic functions and print operations are not supported.
+ *
+ * This language is standalone: it is not used by ModelCSourceGen and the
+ * model libraries, and must be passed directly to
+ * CodeHandler::generateCode() (the caller provides the function signature).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageCLanes : public LanguageC<Base> {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+protected:
+    // the type name of a single lane (e.g. "double")
+    const std::string _elementTypeName;
+    // the number of lanes
+    const size_t _lanes;
+    // the names of the lane-wise mathematical functions
+    std::map<std::string, std::string> _laneFuncNames;
+public:
+
+    /**
+     * Creates a C language source code generator using lanes
+     *
+     * @param elementTypeName the type name of a single lane (e.g. double)
+     * @param lanes the number of lanes (must be a power of 2)
+     * @param spaces number of spaces for indentations
+     */
+    LanguageCLanes(const std::string& elementTypeName,
+                   size_t lanes,
+                   size_t spaces = 3) :
+        LanguageC<Base>(createLaneTypeName(elementTypeName, lanes), spaces),
+        _elementTypeName(elementTypeName),
+        _lanes(lanes) {
+        CPPADCG_ASSERT_KNOWN(lanes > 0 && (lanes & (lanes - 1)) == 0, "The number of lanes must be a power of 2")
+    }
+
+    /**
+     * Provides the number of lanes
+     */
+    inline size_t getLanes() const {
+        return _lanes;
+    }
+
+    /**
+     * Provides the type name of a single lane (e.g. double)
+     */
+    inline const std::string& getElementTypeName() const {
+        return _elementTypeName;
+    }
+
+    /**
+     * Provides the name of the vector type used for all variables
+     */
+    inline const std::string& getLaneTypeName() const {
+        return this->_baseTypeName;
+    }
+
+    /**
+     * Creates the source code with the definition of the vector type and
+     * of the lane-wise helper functions used by the generated code.
+     * It must be placed before the generated function(s).
+     *
+     * @return the source code
+     */
+    virtual std::string generateLaneTypeDefinition() {
+        const std::string& t = this->_baseTypeName;
+        const std::string& e = _elementTypeName;
+
+        std::ostringstream os;
+        os << "#include <math.h>\n"
+              "\n"
+              "typedef " << e << " " << t << " __attribute__((vector_size(" << _lanes << " * sizeof(" << e << ")), aligned(sizeof(" << e << "))));\n"
+              "\n"
+              "static inline " << t << " " << t << "_set1(" << e << " v) {\n"
+              "   " << t << " r = {0};\n"
+              "   return r + v;\n"
+              "}\n"
+              "\n";
+
+        printUnaryFunction(os, "abs", LanguageC<Base>::absFuncName());
+        printUnaryFunction(os, "acos", LanguageC<Base>::acosFuncName());
+        printUnaryFunction(os, "asin", LanguageC<Base>::asinFuncName());
+        printUnaryFunction(os, "atan", LanguageC<Base>::atanFuncName());
+        printUnaryFunction(os, "cosh", LanguageC<Base>::coshFuncName());
+        printUnaryFunction(os, "cos", LanguageC<Base>::cosFuncName());
+        printUnaryFunction(os, "exp", LanguageC<Base>::expFuncName());
+        printUnaryFunction(os, "log", LanguageC<Base>::logFuncName());
+        printUnaryFunction(os, "sinh", LanguageC<Base>::sinhFuncName());
+        printUnaryFunction(os, "sin", LanguageC<Base>::sinFuncName());
+        printUnaryFunction(os, "sqrt", LanguageC<Base>::sqrtFuncName());
+        printUnaryFunction(os, "tanh", LanguageC<Base>::tanhFuncName());
+        printUnaryFunction(os, "tan", LanguageC<Base>::tanFuncName());
+#if CPPAD_USE_CPLUSPLUS_2011
+        printUnaryFunction(os, "erf", LanguageC<Base>::erfFuncName());
+        printUnaryFunction(os, "asinh", LanguageC<Base>::asinhFuncName());
+        printUnaryFunction(os, "acosh", LanguageC<Base>::acoshFuncName());
+        printUnaryFunction(os, "atanh", LanguageC<Base>::atanhFuncName());
+        printUnaryFunction(os, "expm1", LanguageC<Base>::expm1FuncName());
+        printUnaryFunction(os, "log1p", LanguageC<Base>::log1pFuncName());
+#endif
+
+        os << "static inline " << t << " " << laneFunctionName("pow") << "(" << t << " x, " << t << " y) {\n"
+              "   " << t << " r;\n"
+              "   int l;\n"
+              "   for(l = 0; l < " << _lanes << "; l++) r[l] = " << LanguageC<Base>::powFuncName() << "(x[l], y[l]);\n"
+              "   return r;\n"
+              "}\n"
+              "\n"
+              "static inline " << t << " " << laneFunctionName("sign") << "(" << t << " x) {\n"
+              "   " << t << " r;\n"
+              "   int l;\n"
+              "   for(l = 0; l < " << _lanes << "; l++) r[l] = x[l] > 0? 1: (x[l] < 0? -1: 0);\n"
+              "   return r;\n"
+              "}\n"
+              "\n";
+
+        for (CGOpCode op : {CGOpCode::ComLt, CGOpCode::ComLe, CGOpCode::ComEq,
+                            CGOpCode::ComGe, CGOpCode::ComGt, CGOpCode::ComNe}) {
+            os << "static inline " << t << " " << conditionalFunctionName(op) << "(" << t << " left, " << t << " right, " << t << " trueCase, " << t << " falseCase) {\n"
+                  "   " << t << " r;\n"
+                  "   int l;\n"
+                  "   for(l = 0; l < " << _lanes << "; l++) r[l] = left[l] " << this->getComparison(op) << " right[l]? trueCase[l]: falseCase[l];\n"
+                  "   return r;\n"
+                  "}\n"
+                  "\n";
+        }
+
+        return os.str();
+    }
+
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(abs)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(acos)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(asin)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(atan)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(cosh)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(cos)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(exp)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(log)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(sinh)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(sin)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(sqrt)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(tanh)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(tan)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(pow)
+
+#if CPPAD_USE_CPLUSPLUS_2011
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(erf)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(asinh)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(acosh)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(atanh)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(expm1)
+    CPPAD_CG_C_LANG_LANES_FUNCNAME(log1p)
+#endif
+
+protected:
+
+    static inline std::string createLaneTypeName(const std::string& elementTypeName,
+                                                 size_t lanes) {
+        std::string name = "cppadcg_" + elementTypeName + std::to_string(lanes);
+        std::replace(name.begin(), name.end(), ' ', '_');
+        return name;
+    }
+
+    inline const std::string& laneFunctionName(const std::string& function) {
+        std::string& name = _laneFuncNames[function];
+        if (name.empty()) {
+            name = this->_baseTypeName + "_" + function;
+        }
+        return name;
+    }
+
+    inline std::string conditionalFunctionName(enum CGOpCode op) {
+        switch (op) {
+            case CGOpCode::ComLt:
+                return laneFunctionName("cond_lt");
+            case CGOpCode::ComLe:
+                return laneFunctionName("cond_le");
+            case CGOpCode::ComEq:
+                return laneFunctionName("cond_eq");
+            case CGOpCode::ComGe:
+                return laneFunctionName("cond_ge");
+            case CGOpCode::ComGt:
+                return laneFunctionName("cond_gt");
+            case CGOpCode::ComNe:
+                return laneFunctionName("cond_ne");
+            default:
+                throw CGException("Invalid comparison operator code '", op, "'.");
+        }
+    }
+
+    inline void printUnaryFunction(std::ostringstream& os,
+                                   const std::string& function,
+                                   const std::string& elementFunction) {
+        const std::string& t = this->_baseTypeName;
+        os << "static inline " << t << " " << laneFunctionName(function) << "(" << t << " x) {\n"
+              "   " << t << " r;\n"
+              "   int l;\n"
+              "   for(l = 0; l < " << _lanes << "; l++) r[l] = " << elementFunction << "(x[l]);\n"
+              "   return r;\n"
+              "}\n"
+              "\n";
+    }
+
+    void pushSignFunction(Node& op) override {
+        CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 1, "Invalid number of arguments for sign() function")
+
+        this->_streamStack << laneFunctionName("sign") << "(";
+        this->push(op.getArguments()[0]);
+        this->_streamStack << ")";
+    }
+
+    void pushConditionalAssignment(Node& node) override {
+        CPPADCG_ASSERT_UNKNOWN(this->getVariableID(node) > 0)
+
+        const std::vector<Arg>& args = node.getArguments();
+
+        bool isDep = this->isDependent(node);
+        const std::string& varName = this->createVariableName(node);
+
+        // both branches are evaluated since each lane can follow a different one
+        this->pushAssignmentStart(node, varName, isDep);
+        this->_streamStack << conditionalFunctionName(node.getOperationType()) << "(";
+        for (size_t a = 0; a < 4; a++) {
+            if (a > 0) this->_streamStack << ", ";
+            this->push(args[a]);
+        }
+        this->_streamStack << ")";
+        this->pushAssignmentEnd(node);
+    }
+
+    void pushPrintOperation(const Node& node) override {
+        throw CGException("Print operations are not supported by the C language with lanes.");
+    }
+
+    void pushAtomicForwardOp(Node& atomicFor) override {
+        throw CGException("Atomic functions are not supported by the C language with lanes.");
+    }
+
+    void pushAtomicReverseOp(Node& atomicRev) override {
+        throw CGException("Atomic functions are not supported by the C language with lanes.");
+    }
+
+    void printParameter(const Base& value) override {
+        this->_code << this->_baseTypeName << "_set1(";
+        this->writeParameter(value, this->_code);
+        this->_code << ")";
+    }
+
+    void pushParameter(const Base& value) override {
+        this->_streamStack << this->_baseTypeName << "_set1(";
+        this->writeParameter(value, this->_streamStack);
+        this->_streamStack << ")";
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -55,6 +55,16 @@ public:
      * maps dependencies between variables in variableOrder
      */
     const std::vector<std::set<Node*>>& variableDependencies;
+    /**
+     * the position in variableOrder where each task starts
+     * (empty if the variables were not partitioned into tasks)
+     */
+    const std::vector<size_t>& taskStart;
+    /**
+     * the tasks which must be completed before each task can start
+     * (they always have a lower index)
+     */
+    const std::vector<std::set<size_t>>& taskDependencies;
     /**
      * Provides the rules for variable name creation
      */
@@ -114,6 +124,8 @@ public:
                            const CodeHandlerVector<Base, size_t>& varIds,
                            const std::vector<Node*>& vo,
                            const std::vector<std::set<Node*>>& variableDependencies,
+                           const std::vector<size_t>& taskStart,
+                           const std::vector<std::set<size_t>>& taskDependencies,
                            VariableNameGenerator<Base>& ng,
                            const std::map<size_t, size_t>& atomicId2Index,
                            const std::map<size_t, std::string>& atomicId2Name,
@@ -134,6 +146,8 @@ public:
         varId(varIds),
         variableOrder(vo),
         variableDependencies(variableDependencies),
+        taskStart(taskStart),
+        taskDependencies(taskDependencies),
         nameGen(ng),
         atomicFunctionId2Index(atomicId2Index),
         atomicFunctionId2Name(atomicId2Name),
@@ -186,6 +200,15 @@ protected:
      */
     virtual bool requiresVariableDependencies() const = 0;
 
+    /**
+     * Whether or not this language can evaluate groups of variable
+     * assignments (tasks) which do not depend on each other at the same
+     * time.
+     */
+    virtual bool supportsParallelTasks() const {
+        return false;
+    }
+
 };
 
 } // END cg namespace
@@ -28,6 +28,7 @@ namespace cg {
 template<class Base>
 class AbstractCCompiler : public CCompiler<Base> {
 protected:
+    class CompilationStream;
     std::string _path; // the path to the gcc executable
     std::string _tmpFolder;
     std::string _sourcesFolder; // path where source files are saved
@@ -38,6 +39,8 @@ protected:
     std::vector<std::string> _linkFlags;
     bool _verbose;
     bool _saveToDiskFirst;
+    size_t _maxJobs; // maximum number of compiler processes running simultaneously
+    std::unique_ptr<CompilationStream> _stream; // source files being compiled while they are provided
 public:
 
     AbstractCCompiler(const std::string& compilerPath) :
@@ -45,7 +48,8 @@ public:
         _tmpFolder("cppadcg_tmp"),
         _sourcesFolder("cppadcg_sources"),
         _verbose(false),
-        _saveToDiskFirst(false) {
+        _saveToDiskFirst(false),
+        _maxJobs(std::max<size_t>(1, std::thread::hardware_concurrency())) {
     }
 
     AbstractCCompiler(const AbstractCCompiler& orig) = delete;
@@ -135,6 +139,45 @@ public:
         _verbose = verbose;
     }
 
+    /**
+     * Provides the maximum number of compiler processes which can be
+     * running at the same time while compiling source files.
+     *
+     * @return the maximum number of simultaneous compilation jobs
+     */
+    size_t getMaxParallelJobs() const {
+        return _maxJobs;
+    }
+
+    /**
+     * Defines the maximum number of compiler processes which can be
+     * running at the same time while compiling source files (similar to
+     * the -j option of make).
+     * The default is the number of concurrent threads supported by the
+     * hardware.
+     *
+     * @param maxJobs the maximum number of simultaneous compilation jobs
+     *                (a value of 1 compiles one source file at a time)
+     */
+    void setMaxParallelJobs(size_t maxJobs) {
+        _maxJobs = std::max<size_t>(1, maxJobs);
+    }
+
+    std::string getConfigurationDescription() const override {
+        std::ostringstream os;
+        os << "compiler: " << _path << "\n";
+        auto print = [&os](const std::string& name, const std::vector<std::string>& flags) {
+            os << name << ":";
+            for (const std::string& f : flags)
+                os << " " << f;
+            os << "\n";
+        };
+        print("compile flags", _compileFlags);
+        print("compile library flags", _compileLibFlags);
+        print("link flags", _linkFlags);
+        return os.str();
+    }
+
     /**
      * Compiles the provided C source code.
      *
@@ -182,12 +225,17 @@ public:
             std::cout << std::endl;
         }
 
-        std::ostringstream os;
-
         if (_saveToDiskFirst) {
             system::createFolder(_sourcesFolder);
         }
 
+        if (_maxJobs > 1 && sources.size() > 1) {
+            compileSourcesParallel(sources, posIndepCode, timer, outputExtension, outputFiles, maxsize, countWidth);
+            return;
+        }
+
+        std::ostringstream os;
+
         // compile each source code file into a different object file
         for (it = sources.begin(); it != sources.end(); ++it) {
             count++;
@@ -215,20 +263,7 @@ public:
                 std::cout.fill(f); // restore fill character
             }
 
-            if (_saveToDiskFirst) {
-                // save a new source file to disk
-                std::ofstream sourceFile;
-                std::string srcfile = system::createPath(_sourcesFolder, it->first);
-                sourceFile.open(srcfile.c_str());
-                sourceFile << it->second;
-                sourceFile.close();
-
-                // compile the file
-                compileFile(srcfile, file, posIndepCode);
-            } else {
-                 // compile without saving the source code to disk
-                compileSource(it->second, file, posIndepCode);
-            }
+            compile(it->first, it->second, file, posIndepCode, nullptr);
 
             if (timer != nullptr) {
                 timer->finishedJob();
@@ -243,6 +278,35 @@ public:
 
     }
 
+    /**
+     * Starts the compilation of source files which are provided one at a
+     * time.
+     * Up to getMaxParallelJobs() compiler processes are used and the
+     * thread which provides a source file waits while there are too many
+     * source files waiting to be compiled (which limits the memory used
+     * by the source files).
+     * The progress is only reported in finishCompilation().
+     */
+    SourceFileSink& startCompilation(bool posIndepCode,
+                                     JobTimer* timer = nullptr) override {
+        CPPADCG_ASSERT_KNOWN(_stream == nullptr, "The compilation of source files was already started")
+
+        system::createFolder(this->_tmpFolder);
+        if (_saveToDiskFirst) {
+            system::createFolder(_sourcesFolder);
+        }
+
+        _stream.reset(new CompilationStream(*this, posIndepCode, timer));
+        return *_stream;
+    }
+
+    void finishCompilation() override {
+        CPPADCG_ASSERT_KNOWN(_stream != nullptr, "The compilation of source files was not started")
+
+        std::unique_ptr<CompilationStream> stream(std::move(_stream));
+        stream->finish();
+    }
+
     /**
      * Creates a dynamic library from a set of object files
      *
@@ -252,6 +316,8 @@ public:
                               JobTimer* timer = nullptr) override = 0;
 
     void cleanup() override {
+        _stream.reset(); // stops any remaining compilation
+
         // clean up;
         for (const std::string& it : _ofiles) {
             if (remove(it.c_str()) != 0)
@@ -269,25 +335,389 @@ public:
 
 protected:
 
+    /**
+     * Compiles the provided C source code using several compiler processes
+     * at the same time (up to the maximum number of parallel jobs).
+     * Progress is only reported from the calling thread, in the order in
+     * which the source files finish compiling.
+     */
+    virtual void compileSourcesParallel(const std::map<std::string, std::string>& sources,
+                                        bool posIndepCode,
+                                        JobTimer* timer,
+                                        const std::string& outputExtension,
+                                        std::set<std::string>& outputFiles,
+                                        size_t maxsize,
+                                        size_t countWidth) {
+        using namespace std::chrono;
+
+        /**
+         * A compilation job which is performed by a worker thread
+         */
+        struct CompileJob {
+            const std::string* name;
+            const std::string* source;
+            std::string output;
+            std::string message; // standard output and error from the compiler
+            steady_clock::time_point beginTime;
+            steady_clock::time_point endTime;
+        };
+
+        std::vector<CompileJob> jobs(sources.size());
+        size_t j = 0;
+        for (const auto& it : sources) {
+            CompileJob& job = jobs[j++];
+            job.name = &it.first;
+            job.source = &it.second;
+            job.output = system::createPath(this->_tmpFolder, it.first + outputExtension);
+            outputFiles.insert(job.output);
+        }
+
+        std::mutex mutex;
+        std::condition_variable finishedCond;
+        std::deque<size_t> finished; // completed jobs not yet reported
+        size_t next = 0; // the next job to start
+        std::exception_ptr error;
+
+        auto worker = [&]() {
+            while (true) {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (next == jobs.size() || error != nullptr)
+                        break;
+                    i = next++;
+                }
+
+                CompileJob& job = jobs[i];
+                job.beginTime = steady_clock::now();
+                try {
+                    compile(*job.name, *job.source, job.output, posIndepCode, &job.message);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (error == nullptr)
+                        error = std::current_exception();
+                    finishedCond.notify_one();
+                    break;
+                }
+                job.endTime = steady_clock::now();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.push_back(i);
+                finishedCond.notify_one();
+            }
+        };
+
+        size_t nThreads = std::min<size_t>(_maxJobs, jobs.size());
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads);
+        for (size_t t = 0; t < nThreads; ++t) {
+            threads.emplace_back(worker);
+        }
+
+        // report progress from the calling thread only
+        std::ostringstream os;
+        size_t count = 0;
+        while (count < jobs.size()) {
+            size_t i;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finishedCond.wait(lock, [&] { return !finished.empty() || error != nullptr; });
+                if (finished.empty())
+                    break; // failed
+                i = finished.front();
+                finished.pop_front();
+            }
+
+            count++;
+            const CompileJob& job = jobs[i];
+
+            if (timer != nullptr || _verbose) {
+                os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << count
+                        << "/" << jobs.size() << "]";
+            }
+
+            if (timer != nullptr) {
+                timer->completedJob("'" + job.output + "'", JobTypeHolder<>::COMPILING, os.str(), job.beginTime);
+                os.str("");
+            } else if (_verbose) {
+                char f = std::cout.fill();
+                duration<float> dt = job.endTime - job.beginTime;
+                std::cout << os.str() << " compiled  "
+                        << std::setw(maxsize + 9) << std::setfill('.') << std::left
+                        << ("'" + job.output + "' ") << " "
+                        << "done [" << std::fixed << std::setprecision(3)
+                        << dt.count() << "]" << std::endl;
+                os.str("");
+                std::cout.fill(f); // restore fill character
+            }
+
+            if (!job.message.empty()) {
+                std::cerr << job.message;
+                std::cerr.flush();
+            }
+        }
+
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * Compiles the source files provided one at a time using worker
+     * threads (see startCompilation()).
+     */
+    class CompilationStream : public SourceFileSink {
+    private:
+        /**
+         * A compilation job which is performed by a worker thread
+         */
+        struct CompileJob {
+            std::string name;
+            std::string source;
+            std::string output;
+            std::string message; // standard output and error from the compiler
+            std::chrono::steady_clock::time_point beginTime;
+            std::chrono::steady_clock::time_point endTime;
+        };
+
+        AbstractCCompiler& _compiler;
+        const bool _posIndepCode;
+        JobTimer* const _timer;
+        const size_t _maxQueued; // the maximum number of source files waiting to be compiled
+        std::mutex _mutex;
+        std::condition_variable _queueCond; // signals a new source file or the end
+        std::condition_variable _spaceCond; // signals a source file removed from the queue
+        std::deque<CompileJob> _queue; // source files waiting to be compiled
+        std::vector<CompileJob> _finished; // compiled source files (in the order they finished)
+        std::vector<std::thread> _threads;
+        std::exception_ptr _error;
+        bool _closed;
+    public:
+
+        CompilationStream(AbstractCCompiler& compiler,
+                          bool posIndepCode,
+                          JobTimer* timer) :
+            _compiler(compiler),
+            _posIndepCode(posIndepCode),
+            _timer(timer),
+            _maxQueued(2 * std::max<size_t>(1, compiler._maxJobs)),
+            _closed(false) {
+            const size_t nThreads = std::max<size_t>(1, compiler._maxJobs);
+            _threads.reserve(nThreads);
+            for (size_t t = 0; t < nThreads; ++t) {
+                _threads.emplace_back(&CompilationStream::work, this);
+            }
+        }
+
+        CompilationStream(const CompilationStream& orig) = delete;
+        CompilationStream& operator=(const CompilationStream& rhs) = delete;
+
+        void addSource(const std::string& name,
+                       std::string&& source) override {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            CPPADCG_ASSERT_KNOWN(!_closed, "The compilation of source files already finished")
+            if (!_compiler._sfiles.insert(name).second) {
+                throw CGException("Source file '", name, "' was already compiled");
+            }
+
+            _spaceCond.wait(lock, [&] { return _queue.size() < _maxQueued || _error != nullptr; });
+            if (_error != nullptr) {
+                std::rethrow_exception(_error);
+            }
+
+            CompileJob job;
+            job.name = name;
+            job.source = std::move(source);
+            job.output = system::createPath(_compiler._tmpFolder, name + ".o");
+            _compiler._ofiles.insert(job.output);
+
+            _queue.push_back(std::move(job));
+            _queueCond.notify_one();
+        }
+
+        /**
+         * Waits until all source files are compiled and reports the
+         * progress.
+         */
+        void finish() {
+            using namespace std::chrono;
+
+            stop();
+
+            if (_error != nullptr) {
+                std::rethrow_exception(_error);
+            }
+
+            size_t maxsize = 0;
+            for (const CompileJob& job : _finished) {
+                maxsize = std::max<size_t>(maxsize, job.output.size());
+            }
+            size_t countWidth = _finished.empty() ? 1 : size_t(std::ceil(std::log10(_finished.size() + 1)));
+
+            if (_timer != nullptr) {
+                size_t ms = 3 + 2 * countWidth + 1 + JobTypeHolder<>::COMPILING.getActionName().size() + 2 + maxsize + 5;
+                ms += _timer->getJobCount() * 2;
+                if (_timer->getMaxLineWidth() < ms)
+                    _timer->setMaxLineWidth(ms);
+            } else if (_compiler._verbose && !_finished.empty()) {
+                std::cout << std::endl;
+            }
+
+            std::ostringstream os;
+            size_t count = 0;
+            for (const CompileJob& job : _finished) {
+                count++;
+
+                if (_timer != nullptr || _compiler._verbose) {
+                    os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << count
+                            << "/" << _finished.size() << "]";
+                }
+
+                if (_timer != nullptr) {
+                    _timer->completedJob("'" + job.output + "'", JobTypeHolder<>::COMPILING, os.str(), job.beginTime);
+                    os.str("");
+                } else if (_compiler._verbose) {
+                    char f = std::cout.fill();
+                    duration<float> dt = job.endTime - job.beginTime;
+                    std::cout << os.str() << " compiled  "
+                            << std::setw(maxsize + 9) << std::setfill('.') << std::left
+                            << ("'" + job.output + "' ") << " "
+                            << "done [" << std::fixed << std::setprecision(3)
+                            << dt.count() << "]" << std::endl;
+                    os.str("");
+                    std::cout.fill(f); // restore fill character
+                }
+
+                if (!job.message.empty()) {
+                    std::cerr << job.message;
+                    std::cerr.flush();
+                }
+            }
+        }
+
+        virtual ~CompilationStream() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _queue.clear(); // source files not compiled yet are discarded
+            }
+            stop();
+        }
+
+    private:
+
+        /**
+         * Waits for the worker threads to compile the remaining source
+         * files.
+         */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+                _queueCond.notify_all();
+                _spaceCond.notify_all();
+            }
+
+            for (std::thread& t : _threads) {
+                if (t.joinable())
+                    t.join();
+            }
+        }
+
+        void work() {
+            while (true) {
+                CompileJob job;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _queueCond.wait(lock, [&] { return !_queue.empty() || _closed || _error != nullptr; });
+                    if (_queue.empty() || _error != nullptr)
+                        break;
+                    job = std::move(_queue.front());
+                    _queue.pop_front();
+                    _spaceCond.notify_one();
+                }
+
+                job.beginTime = std::chrono::steady_clock::now();
+                try {
+                    _compiler.compile(job.name, job.source, job.output, _posIndepCode, &job.message);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_error == nullptr)
+                        _error = std::current_exception();
+                    _spaceCond.notify_all();
+                    _queueCond.notify_all();
+                    break;
+                }
+                job.endTime = std::chrono::steady_clock::now();
+                job.source.clear();
+                job.source.shrink_to_fit();
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                _finished.push_back(std::move(job));
+            }
+        }
+    };
+
+    /**
+     * Compiles a single source file, saving it to disk first if requested.
+     * This method can be called simultaneously from different threads.
+     *
+     * @param name the source file name
+     * @param source the content of the source file
+     * @param output the compiled output file name (the object file path)
+     * @param stdOutErrMessage if not null, it will contain the standard
+     *                         output and error messages from the compiler
+     */
+    virtual void compile(const std::string& name,
+                         const std::string& source,
+                         const std::string& output,
+                         bool posIndepCode,
+                         std::string* stdOutErrMessage) {
+        if (_saveToDiskFirst) {
+            // save a new source file to disk
+            std::ofstream sourceFile;
+            std::string srcfile = system::createPath(_sourcesFolder, name);
+            sourceFile.open(srcfile.c_str());
+            sourceFile << source;
+            sourceFile.close();
+
+            // compile the file
+            compileFile(srcfile, output, posIndepCode, stdOutErrMessage);
+        } else {
+            // compile without saving the source code to disk
+            compileSource(source, output, posIndepCode, stdOutErrMessage);
+        }
+    }
+
     /**
      * Compiles a single source file into an object file.
      *
      * @param source the content of the source file
      * @param output the compiled output file name (the object file path)
+     * @param stdOutErrMessage if not null, it will contain the standard
+     *                         output and error messages from the compiler
      */
     virtual void compileSource(const std::string& source,
                                const std::string& output,
-                               bool posIndepCode) = 0;
+                               bool posIndepCode,
+                               std::string* stdOutErrMessage = nullptr) = 0;
 
     /**
      * Compiles a single source file into an object file.
      *
      * @param path the path to the source file
      * @param output the compiled output file name (the object file path)
+     * @param stdOutErrMessage if not null, it will contain the standard
+     *                         output and error messages from the compiler
      */
     virtual void compileFile(const std::string& path,
                              const std::string& output,
-                             bool posIndepCode) = 0;
+                             bool posIndepCode,
+                             std::string* stdOutErrMessage = nullptr) = 0;
 };
 
 } // END cg namespace
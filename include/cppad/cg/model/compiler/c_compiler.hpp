@@ -83,6 +83,41 @@ public:
                                 bool posIndepCode,
                                 JobTimer* timer = nullptr) = 0;
 
+    /**
+     * Starts the compilation of source files which are provided one at a
+     * time (e.g. while the remaining source files are still being
+     * generated).
+     * finishCompilation() must be called after all source files are
+     * provided to the returned sink.
+     * The default implementation keeps the source files in memory and
+     * only compiles them (with compileSources()) in finishCompilation().
+     *
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     * @param timer the job timer (possibly null)
+     * @return the sink which receives the source files to compile (it
+     *         remains valid until finishCompilation() or cleanup() is
+     *         called)
+     */
+    virtual SourceFileSink& startCompilation(bool posIndepCode,
+                                             JobTimer* timer = nullptr) {
+        CPPADCG_ASSERT_KNOWN(_bufferedSources == nullptr, "The compilation of source files was already started")
+
+        _bufferedSources.reset(new BufferedSourceSink(posIndepCode, timer));
+        return *_bufferedSources;
+    }
+
+    /**
+     * Waits for the compilation of all the source files provided since
+     * startCompilation().
+     */
+    virtual void finishCompilation() {
+        CPPADCG_ASSERT_KNOWN(_bufferedSources != nullptr, "The compilation of source files was not started")
+
+        std::unique_ptr<BufferedSourceSink> sink(std::move(_bufferedSources));
+        compileSources(sink->sources, sink->posIndepCode, sink->timer);
+    }
+
     /**
      * Creates a dynamic library from the previously compiled object files
      *
@@ -91,6 +126,15 @@ public:
     virtual void buildDynamic(const std::string& library,
                               JobTimer* timer = nullptr) = 0;
 
+    /**
+     * Provides a description of the compiler and of all the options which
+     * affect the created binaries (e.g. used to identify previously
+     * compiled libraries).
+     *
+     * @return the compiler configuration description
+     */
+    virtual std::string getConfigurationDescription() const = 0;
+
     /**
      * Deletes the previously compiled object files and clears of files
      * to include in a dynamic library
@@ -99,6 +143,33 @@ public:
 
     inline virtual ~CCompiler() = default;
 
+private:
+
+    /**
+     * Keeps the source files provided since startCompilation() (used by
+     * the default implementation only)
+     */
+    class BufferedSourceSink : public SourceFileSink {
+    public:
+        const bool posIndepCode;
+        JobTimer* const timer;
+        std::map<std::string, std::string> sources;
+        std::mutex mutex;
+
+        inline BufferedSourceSink(bool posIndepCode,
+                                  JobTimer* timer) :
+            posIndepCode(posIndepCode),
+            timer(timer) {
+        }
+
+        void addSource(const std::string& name,
+                       std::string&& source) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            sources[name] = std::move(source);
+        }
+    };
+
+    std::unique_ptr<BufferedSourceSink> _bufferedSources;
 };
 
 } // END cg namespace
@@ -91,7 +91,8 @@ protected:
      */
     void compileSource(const std::string& source,
                        const std::string& output,
-                       bool posIndepCode) override {
+                       bool posIndepCode,
+                       std::string* stdOutErrMessage = nullptr) override {
         std::vector<std::string> args;
         args.push_back("-x");
         args.push_back("c"); // C source files
@@ -104,12 +105,13 @@ protected:
         args.push_back("-o");
         args.push_back(output);
 
-        system::callExecutable(this->_path, args, nullptr, &source);
+        system::callExecutable(this->_path, args, stdOutErrMessage, &source);
     }
 
     void compileFile(const std::string& path,
                      const std::string& output,
-                     bool posIndepCode) override {
+                     bool posIndepCode,
+                     std::string* stdOutErrMessage = nullptr) override {
         std::vector<std::string> args;
         args.push_back("-x");
         args.push_back("c"); // C source files
@@ -122,7 +124,7 @@ protected:
         args.push_back("-o");
         args.push_back(output);
 
-        system::callExecutable(this->_path, args);
+        system::callExecutable(this->_path, args, stdOutErrMessage);
     }
 
 };
@@ -0,0 +1,291 @@
+#ifndef CPPAD_CG_DYNAMIC_LIBRARY_CACHE_INCLUDED
+#define CPPAD_CG_DYNAMIC_LIBRARY_CACHE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A persistent cache of compiled dynamic libraries.
+ *
+ * Libraries are saved in a folder and identified by a key determined from
+ * the content of all the generated source files and from the compiler
+ * configuration (see createKey()).
+ * A library is therefore only compiled again when the model or the
+ * compiler options change.
+ * When the total size of the cached libraries exceeds a limit, the least
+ * recently used libraries are removed.
+ *
+ * The same folder can be shared by several processes: libraries are first
+ * written to a temporary file which is then atomically renamed.
+ *
+ * @author Joao Leal
+ */
+class DynamicLibraryCache {
+protected:
+    /// the folder where the libraries are saved
+    std::string _folder;
+    /// the maximum total size of the cached libraries (in bytes)
+    size_t _maxSize;
+public:
+
+    /**
+     * Creates a new cache of compiled dynamic libraries.
+     *
+     * @param folder the folder where the libraries are saved (it is
+     *               created if it does not exist)
+     * @param maxSize the maximum total size of the cached libraries in
+     *                bytes
+     */
+    inline explicit DynamicLibraryCache(const std::string& folder,
+                                        size_t maxSize = 1024 * 1024 * 1024) :
+        _folder(folder),
+        _maxSize(maxSize) {
+        CPPADCG_ASSERT_KNOWN(!folder.empty(), "Cache folder cannot be empty")
+    }
+
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    inline size_t getMaxSize() const {
+        return _maxSize;
+    }
+
+    /**
+     * Defines the maximum total size of the cached libraries.
+     * Libraries are only removed when a new library is added to the cache.
+     *
+     * @param maxSize the maximum size in bytes
+     */
+    inline void setMaxSize(size_t maxSize) {
+        _maxSize = maxSize;
+    }
+
+    /**
+     * Provides the path where a library is saved in the cache.
+     *
+     * @param key the library key
+     * @param extension the library file extension (e.g. ".so")
+     */
+    inline std::string getLibraryPath(const std::string& key,
+                                      const std::string& extension) const {
+        return system::createPath(_folder, libraryPrefix() + key + extension);
+    }
+
+    /**
+     * Searches for a library in the cache.
+     * The library is marked as recently used.
+     *
+     * @param key the library key
+     * @param extension the library file extension (e.g. ".so")
+     * @return the path of the cached library or an empty string if it
+     *         is not in the cache
+     */
+    inline std::string find(const std::string& key,
+                            const std::string& extension) const {
+        std::string path = getLibraryPath(key, extension);
+        if (!system::isFile(path))
+            return "";
+
+        try {
+            system::touchFile(path);
+        } catch (const CGException&) {
+            // it could have been removed by another process
+            if (!system::isFile(path))
+                return "";
+        }
+        return path;
+    }
+
+    /**
+     * Adds a copy of a library to the cache.
+     * The least recently used libraries are removed if the maximum size
+     * of the cache is exceeded.
+     *
+     * @param key the library key
+     * @param library the path to the library to be copied into the cache
+     * @param extension the library file extension (e.g. ".so")
+     * @return the path of the cached library
+     * @throws CGException on failure to copy the library
+     */
+    inline std::string store(const std::string& key,
+                             const std::string& library,
+                             const std::string& extension) {
+        system::createFolder(_folder);
+
+        std::string path = getLibraryPath(key, extension);
+
+        std::random_device rd;
+        std::string tmpPath = system::createPath(_folder, temporaryPrefix() + key + "_" + std::to_string(rd()));
+
+        copyFile(library, tmpPath);
+
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+            const char* error = strerror(errno);
+            std::remove(tmpPath.c_str());
+            throw CGException("Failed to move '", tmpPath, "' to '", path, "': ", error);
+        }
+
+        evict(path);
+
+        return path;
+    }
+
+    /**
+     * Removes the least recently used libraries until the total size of
+     * the cache is not larger than the maximum size.
+     *
+     * @param keep the path of a library which should never be removed
+     *             (e.g. a library which was just added)
+     */
+    inline void evict(const std::string& keep = "") {
+        struct Entry {
+            std::string path;
+            size_t size;
+            time_t time;
+        };
+
+        std::vector<Entry> entries;
+        size_t total = 0;
+        for (const std::string& name : system::listFiles(_folder)) {
+            if (name.compare(0, libraryPrefix().size(), libraryPrefix()) != 0)
+                continue;
+
+            Entry e;
+            e.path = system::createPath(_folder, name);
+            if (!system::getFileInfo(e.path, e.size, e.time))
+                continue; // removed by another process
+
+            total += e.size;
+            if (e.path != keep)
+                entries.push_back(std::move(e));
+        }
+
+        if (total <= _maxSize)
+            return;
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.time < b.time || (a.time == b.time && a.path < b.path);
+        });
+
+        for (const Entry& e : entries) {
+            if (total <= _maxSize)
+                break;
+            if (std::remove(e.path.c_str()) == 0 || !system::isFile(e.path)) {
+                total -= e.size;
+            }
+        }
+    }
+
+    /**
+     * Removes all libraries from the cache.
+     */
+    inline void clear() {
+        if (!system::isDirectory(_folder))
+            return;
+
+        for (const std::string& name : system::listFiles(_folder)) {
+            if (name.compare(0, libraryPrefix().size(), libraryPrefix()) == 0) {
+                std::remove(system::createPath(_folder, name).c_str());
+            }
+        }
+    }
+
+    /**
+     * Determines the key which identifies a library in the cache.
+     *
+     * @param sources the names and contents of all the source files used
+     *                to build the library
+     * @param description additional information which affects the library
+     *                    (e.g. the compiler configuration)
+     * @return the key
+     */
+    static inline std::string createKey(const std::vector<const std::map<std::string, std::string>*>& sources,
+                                        const std::string& description) {
+        Sha256 sha;
+
+        auto addField = [&sha](const std::string& s) {
+            // the length avoids ambiguities between consecutive fields
+            std::string length = std::to_string(s.size()) + ":";
+            sha.update(length);
+            sha.update(s);
+        };
+
+        addField(description);
+        for (const auto* s : sources) {
+            addField(std::to_string(s->size()));
+            for (const auto& p : *s) {
+                addField(p.first);
+                addField(p.second);
+            }
+        }
+
+        return sha.finish();
+    }
+
+    /**
+     * Copies a file.
+     *
+     * @param source the path of the file to be copied
+     * @param destination the path of the new file
+     * @throws CGException on failure to copy the file
+     */
+    static inline void copyFile(const std::string& source,
+                                const std::string& destination) {
+        std::ifstream in(source, std::ios::binary);
+        if (!in) {
+            throw CGException("Failed to open '", source, "'");
+        }
+
+        std::ofstream out(destination, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw CGException("Failed to create '", destination, "'");
+        }
+
+        out << in.rdbuf();
+        out.close();
+
+        if (!out) {
+            std::remove(destination.c_str());
+            throw CGException("Failed to copy '", source, "' to '", destination, "'");
+        }
+    }
+
+protected:
+
+    /**
+     * The prefix of the file names of all libraries in the cache
+     */
+    static inline const std::string& libraryPrefix() {
+        static const std::string prefix = "cppadcg_";
+        return prefix;
+    }
+
+    /**
+     * The prefix of the file names of libraries being added to the cache
+     */
+    static inline const std::string& temporaryPrefix() {
+        static const std::string prefix = ".tmp_cppadcg_";
+        return prefix;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
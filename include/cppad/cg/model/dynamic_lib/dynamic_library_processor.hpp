@@ -39,6 +39,15 @@ protected:
      * System dependent custom options
      */
     std::map<std::string, std::string> _options;
+    /**
+     * a cache of previously compiled libraries (not owned)
+     */
+    DynamicLibraryCache* _cache;
+    /**
+     * whether or not to compile the source files while the remaining source
+     * files are still being generated
+     */
+    bool _streamSources;
 public:
 
     /**
@@ -53,7 +62,9 @@ public:
                                         const std::string& libraryName = "cppad_cg_model") :
         ModelLibraryProcessor<Base>(modelLibGen),
         _libraryName(libraryName),
-        _customLibExtension(nullptr) {
+        _customLibExtension(nullptr),
+        _cache(nullptr),
+        _streamSources(false) {
     }
 
     inline const std::string& getLibraryName() const {
@@ -107,8 +118,67 @@ public:
         return _options;
     }
 
+    /**
+     * Provides the cache of previously compiled dynamic libraries.
+     *
+     * @return the library cache or nullptr if no cache is used
+     */
+    inline DynamicLibraryCache* getLibraryCache() const {
+        return _cache;
+    }
+
+    /**
+     * Defines a cache of compiled dynamic libraries.
+     * The compilation of a dynamic library is skipped when a library built
+     * from the same source files, with the same compiler configuration, is
+     * found in the cache.
+     * Source files are still generated since they identify the library.
+     *
+     * @param cache the library cache (it must exist while it is used by
+     *              this object)
+     */
+    inline void setLibraryCache(DynamicLibraryCache& cache) {
+        _cache = &cache;
+    }
+
+    /**
+     * Stops using a cache of compiled dynamic libraries
+     */
+    inline void removeLibraryCache() {
+        _cache = nullptr;
+    }
+
+    /**
+     * Whether or not the source files are compiled while the remaining
+     * source files are still being generated.
+     *
+     * @return true if the source files are compiled as soon as they are
+     *         generated
+     */
+    inline bool isStreamSources() const {
+        return _streamSources;
+    }
+
+    /**
+     * Defines whether or not to compile each source file as soon as it is
+     * generated instead of generating all source files first.
+     * Generated source files are discarded once they are compiled which can
+     * considerably reduce the memory required for large models.
+     * The source files are not streamed when a library cache is used since
+     * all source files are needed to search for a cached library.
+     *
+     * @param stream true to compile the source files as soon as they are
+     *               generated
+     */
+    inline void setStreamSources(bool stream) {
+        _streamSources = stream;
+    }
+
     /**
      * Compiles all models and generates a dynamic library.
+     * If a library cache is used and it already contains an equivalent
+     * library, then no compilation is performed and the cached library is
+     * used (loaded directly from the cache or copied to the library path).
      * 
      * @param compiler The compiler used to compile the sources and create
      *                 the dynamic library
@@ -122,30 +192,67 @@ public:
 
         this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
 
+        std::string libExtension;
+        if (_customLibExtension != nullptr)
+            libExtension = *_customLibExtension;
+        else
+            libExtension = system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+        std::string libname = _libraryName + libExtension;
+        std::string cachedLib;
+
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
+            if (_streamSources && _cache == nullptr) {
+                createDynamicLibraryStreamed(compiler, libname);
+            } else {
+                std::vector<const std::map<std::string, std::string>*> modelSources;
+                modelSources.reserve(models.size());
+                for (const auto& p : models) {
+                    modelSources.push_back(&this->getSources(*p.second));
+                }
+
+                const std::map<std::string, std::string>& sources = this->getLibrarySources();
+                const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
+
+                std::string key;
+                if (_cache != nullptr) {
+                    std::vector<const std::map<std::string, std::string>*> allSources(modelSources);
+                    allSources.push_back(&sources);
+                    allSources.push_back(&customSource);
+
+                    // the library file name is used by the linker (e.g. soname)
+                    std::string description = compiler.getConfigurationDescription() +
+                                              "library: " + system::filenameFromPath(libname) + "\n";
+                    key = DynamicLibraryCache::createKey(allSources, description);
+                    cachedLib = _cache->find(key, libExtension);
+                }
+
+                if (cachedLib.empty()) {
+                    for (const auto* ms : modelSources) {
+                        this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+                        compiler.compileSources(*ms, true, this->modelLibraryHelper_);
+                        this->modelLibraryHelper_->finishedJob();
+                    }
+
+                    compiler.compileSources(sources, true, this->modelLibraryHelper_);
+
+                    compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+
+                    compiler.buildDynamic(libname, this->modelLibraryHelper_);
+
+                    if (_cache != nullptr) {
+                        _cache->store(key, libname, libExtension);
+                    }
+                } else {
+                    if (compiler.isVerbose()) {
+                        std::cout << "using cached library '" << cachedLib << "'" << std::endl;
+                    }
+                    if (!loadLib) {
+                        DynamicLibraryCache::copyFile(cachedLib, libname);
+                    }
+                }
             }
 
-            const std::map<std::string, std::string>& sources = this->getLibrarySources();
-            compiler.compileSources(sources, true, this->modelLibraryHelper_);
-
-            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-            compiler.compileSources(customSource, true, this->modelLibraryHelper_);
-
-            std::string libname = _libraryName;
-            if (_customLibExtension != nullptr)
-                libname += *_customLibExtension;
-            else
-                libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
-
-            compiler.buildDynamic(libname, this->modelLibraryHelper_);
-
         } catch (...) {
             compiler.cleanup();
             throw;
@@ -155,7 +262,7 @@ public:
         this->modelLibraryHelper_->finishedJob();
 
         if (loadLib)
-            return loadDynamicLibrary();
+            return loadDynamicLibrary(cachedLib.empty() ? libname : cachedLib);
         else
             return std::unique_ptr<DynamicLib<Base>>(nullptr);
     }
@@ -217,7 +324,43 @@ public:
 
 protected:
 
-    virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
+    /**
+     * Generates and compiles the source files of all models at the same
+     * time and then creates the dynamic library.
+     *
+     * @param compiler The compiler used to compile the sources and create
+     *                 the dynamic library
+     * @param libname The path of the dynamic library (with the extension)
+     */
+    virtual void createDynamicLibraryStreamed(CCompiler<Base>& compiler,
+                                              const std::string& libname) {
+        SourceFileSink& sink = compiler.startCompilation(true, this->modelLibraryHelper_);
+
+        for (const auto& p : this->modelLibraryHelper_->getModels()) {
+            this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+            this->streamSources(*p.second, sink);
+            this->modelLibraryHelper_->finishedJob();
+        }
+
+        for (const auto& it : this->getLibrarySources()) {
+            sink.addSource(it.first, std::string(it.second));
+        }
+
+        for (const auto& it : this->modelLibraryHelper_->getCustomSources()) {
+            sink.addSource(it.first, std::string(it.second));
+        }
+
+        compiler.finishCompilation();
+
+        compiler.buildDynamic(libname, this->modelLibraryHelper_);
+    }
+
+    /**
+     * Loads a dynamic library.
+     *
+     * @param libPath the path to the dynamic library
+     */
+    virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary(const std::string& libPath);
 
 };
 
@@ -20,14 +20,14 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-std::unique_ptr<DynamicLib<Base>> DynamicModelLibraryProcessor<Base>::loadDynamicLibrary() {
+std::unique_ptr<DynamicLib<Base>> DynamicModelLibraryProcessor<Base>::loadDynamicLibrary(const std::string& libPath) {
     std::unique_ptr<DynamicLib<Base>> lib;
     const auto it = _options.find("dlOpenMode");
     if (it == _options.end()) {
-        lib.reset(new LinuxDynamicLib<Base>(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+        lib.reset(new LinuxDynamicLib<Base>(libPath));
     } else {
         int dlOpenMode = std::stoi(it->second);
-        lib.reset(new LinuxDynamicLib<Base>(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, dlOpenMode));
+        lib.reset(new LinuxDynamicLib<Base>(libPath, dlOpenMode));
     }
     return lib;
 }
@@ -36,12 +36,16 @@ protected:
     /// the dynamic library handler
     void* _dynLibHandle;
     std::set<LinuxDynamicLibModel<Base>*> _models;
+    void (*_setThreadPoolAffinity)(int, const int*, int);
+    int (*_getThreadPoolAffinity)();
 public:
 
     LinuxDynamicLib(const std::string& dynLibName,
                     int dlOpenMode = RTLD_NOW) :
         _dynLibName(dynLibName),
-        _dynLibHandle(nullptr) {
+        _dynLibHandle(nullptr),
+        _setThreadPoolAffinity(nullptr),
+        _getThreadPoolAffinity(nullptr) {
 
         std::string path;
         if (dynLibName[0] == '/') {
@@ -59,6 +63,9 @@ public:
 
         // validate the dynamic library
         this->validate();
+
+        _setThreadPoolAffinity = reinterpret_cast<decltype(_setThreadPoolAffinity)> (loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLAFFINITY, false));
+        _getThreadPoolAffinity = reinterpret_cast<decltype(_getThreadPoolAffinity)> (loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITY, false));
     }
 
     LinuxDynamicLib(const LinuxDynamicLib&) = delete;
@@ -79,6 +86,41 @@ public:
         return std::unique_ptr<FunctorGenericModel<Base>>(modelLinuxDyn(modelName).release());
     }
 
+    /**
+     * Defines the CPUs where the threads used to determine sparse Jacobians
+     * and sparse Hessians run.
+     * Pinning threads avoids moving work between NUMA domains and makes the
+     * elapsed time measurements used for scheduling more stable.
+     * This value is only used by the models if they were compiled with
+     * pthreads multithreading support.
+     *
+     * @param affinity the affinity type
+     * @param cpus the CPU used by each thread (only used and required for
+     *             ThreadPoolAffinity::EXPLICIT). If there are more threads
+     *             than CPUs the list is repeated.
+     */
+    virtual void setThreadPoolAffinity(ThreadPoolAffinity affinity,
+                                       const std::vector<int>& cpus = std::vector<int>()) {
+        CPPADCG_ASSERT_KNOWN(affinity != ThreadPoolAffinity::EXPLICIT || !cpus.empty(),
+                             "A list of CPUs is required for an explicit thread affinity")
+        if (_setThreadPoolAffinity != nullptr) {
+            (*_setThreadPoolAffinity)(int(affinity), cpus.data(), int(cpus.size()));
+        }
+    }
+
+    /**
+     * Provides the CPU affinity of the threads used to determine sparse
+     * Jacobians and sparse Hessians.
+     *
+     * @return the affinity type
+     */
+    virtual ThreadPoolAffinity getThreadPoolAffinity() const {
+        if (_getThreadPoolAffinity != nullptr) {
+            return ThreadPoolAffinity((*_getThreadPoolAffinity)());
+        }
+        return ThreadPoolAffinity::NONE;
+    }
+
     void* loadFunction(const std::string& functionName, bool required = true) override {
         void* functor = dlsym(_dynLibHandle, functionName.c_str());
 
@@ -27,6 +27,11 @@ namespace cg {
  * different threads.
  * Multiple instances of this class for the same model from the same model
  * library object can be used simulataneously in different threads.
+ * Alternatively, the const evaluation methods which receive a
+ * GenericModelWorkspace can be used simultaneously in different threads
+ * with a single model object (one workspace per thread) as long as the
+ * model does not use atomic functions and the model library thread pool is
+ * disabled.
  *
  * @author Joao Leal
  */
@@ -48,6 +53,8 @@ protected:
     CppAD::vector<Base> _tx, _ty, _px, _py;
     // original model function
     void (*_zero)(Base const*const*, Base * const*, LangCAtomicFun);
+    // original model function for several points
+    int (*_zeroBatch)(unsigned long, Base const*const*, Base * const*, LangCAtomicFun);
     // first order forward mode
     int (*_forwardOne)(Base const tx[], Base ty[], LangCAtomicFun);
     // first order reverse mode
@@ -64,8 +71,17 @@ protected:
     int (*_sparseReverseOne)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
     //
     int (*_sparseReverseTwo)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    // values shared by the directional functions of the sparse forward one, reverse one and reverse two modes (optional)
+    void (*_sparseForwardOneShared)(Base const *const *, Base * const *, LangCAtomicFun);
+    void (*_sparseReverseOneShared)(Base const *const *, Base * const *, LangCAtomicFun);
+    void (*_sparseReverseTwoShared)(Base const *const *, Base * const *, LangCAtomicFun);
+    unsigned long _forwardOneSharedSize;
+    unsigned long _reverseOneSharedSize;
+    unsigned long _reverseTwoSharedSize;
     // sparse jacobian function in the dynamic library
     void (*_sparseJacobian)(Base const*const*, Base * const*, LangCAtomicFun);
+    // sparse jacobian function for several points in the dynamic library
+    int (*_sparseJacobianBatch)(unsigned long, Base const*const*, Base * const*, LangCAtomicFun);
     // sparse hessian function in the dynamic library
     void (*_sparseHessian)(Base const*const*, Base * const*, LangCAtomicFun);
     //
@@ -88,6 +104,19 @@ protected:
             unsigned long * nnz);
     void (*_atomicFunctions)(const char*** names,
             unsigned long * n);
+    // Jacobian sparsity pattern (cached when the library is loaded)
+    unsigned long const* _jacRows;
+    unsigned long const* _jacCols;
+    unsigned long _jacNnz;
+    // Hessian sparsity pattern (cached when the library is loaded)
+    unsigned long const* _hessRows;
+    unsigned long const* _hessCols;
+    unsigned long _hessNnz;
+    // buffers for the non-zero elements of the Jacobian and Hessian
+    CppAD::vector<Base> _compressedJac;
+    CppAD::vector<Base> _compressedHess;
+    // buffer for the values shared by the directional functions
+    CppAD::vector<Base> _shared;
 
 public:
 
@@ -171,6 +200,20 @@ public:
         std::copy(col, col + nnz, variables.begin());
     }
 
+    ArrayView<const size_t> JacobianSparsityRows() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library");
+
+        return ArrayView<const size_t>(_jacRows, _jacNnz);
+    }
+
+    ArrayView<const size_t> JacobianSparsityCols() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library");
+
+        return ArrayView<const size_t>(_jacCols, _jacNnz);
+    }
+
     // Hessian sparsity
     bool isHessianSparsityAvailable() override {
         return _hessianSparsity != nullptr;
@@ -224,6 +267,20 @@ public:
         std::copy(col, col + nnz, cols.begin());
     }
 
+    ArrayView<const size_t> HessianSparsityRows() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library");
+
+        return ArrayView<const size_t>(_hessRows, _hessNnz);
+    }
+
+    ArrayView<const size_t> HessianSparsityCols() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library");
+
+        return ArrayView<const size_t>(_hessCols, _hessNnz);
+    }
+
     bool isEquationHessianSparsityAvailable() override {
         return _hessianSparsity2 != nullptr;
     }
@@ -322,6 +379,33 @@ public:
         (*_zero)(&x[0], &_out[0], _atomicFuncArg);
     }
 
+    bool isForwardZeroBatchAvailable() override {
+        return _zeroBatch != nullptr;
+    }
+
+    /// calculate the dependent values (zero order) for several points
+    void ForwardZeroBatch(size_t nPoints,
+                          ArrayView<const Base> x,
+                          ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_zeroBatch != nullptr, "No zero order forward batch function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m * nPoints, "Invalid dependent array size");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
+
+        if (nPoints == 0)
+            return;
+
+        _in[0] = x.data();
+        _out[0] = dep.data();
+
+        int ret = (*_zeroBatch)(nPoints, &_in[0], &_out[0], _atomicFuncArg);
+
+        CPPADCG_ASSERT_KNOWN(ret == 0, "Zero order forward batch evaluation failed.");
+    }
+
     void ForwardZero(const CppAD::vector<bool>& vx,
                      CppAD::vector<bool>& vy,
                      ArrayView<const Base> tx,
@@ -342,9 +426,9 @@ public:
         if (vx.size() > 0) {
             CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size");
             CPPADCG_ASSERT_KNOWN(vy.size() >= _m, "Invalid vy size");
-            const std::vector<std::set<size_t> > jacSparsity = JacobianSparsitySet();
+            const SparsityPattern jacSparsity = this->JacobianSparsityPattern();
             for (size_t i = 0; i < _m; i++) {
-                for (size_t j : jacSparsity[i]) {
+                for (size_t j : jacSparsity.row(i)) {
                     if (vx[j]) {
                         vy[i] = true;
                         break;
@@ -443,15 +527,23 @@ public:
         _ty.resize(_m);
         Base* compressed = &_ty[0];
 
-        _inHess[0] = x.data();
+        const Base * in[3];
+        in[0] = x.data();
+        if (_sparseForwardOneShared != nullptr) {
+            _shared.resize(_forwardOneSharedSize);
+            in[1] = &tx1[0];
+            in[2] = _shared.data();
+            _out[0] = _shared.data();
+            (*_sparseForwardOneShared)(&in[0], &_out[0], _atomicFuncArg);
+        }
         _out[0] = compressed;
 
         for (size_t ej = 0; ej < tx1Nnz; ej++) {
             size_t j = idx[ej];
             (*_forwardOneSparsity)(j, &pos, &nnz);
 
-            _inHess[1] = &tx1[ej];
-            int ret = (*_sparseForwardOne)(j, &_inHess[0], &_out[0], _atomicFuncArg);
+            in[1] = &tx1[ej];
+            int ret = (*_sparseForwardOne)(j, &in[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order forward mode failed."); // generic failure
 
@@ -509,15 +601,23 @@ public:
         _px.resize(_n);
         Base* compressed = &_px[0];
 
-        _inHess[0] = x.data();
+        const Base * in[3];
+        in[0] = x.data();
+        if (_sparseReverseOneShared != nullptr) {
+            _shared.resize(_reverseOneSharedSize);
+            in[1] = &py[0];
+            in[2] = _shared.data();
+            _out[0] = _shared.data();
+            (*_sparseReverseOneShared)(&in[0], &_out[0], _atomicFuncArg);
+        }
         _out[0] = compressed;
 
         for (size_t ei = 0; ei < pyNnz; ei++) {
             size_t i = idx[ei];
             (*_reverseOneSparsity)(i, &pos, &nnz);
 
-            _inHess[1] = &py[ei];
-            int ret = (*_sparseReverseOne)(i, &_inHess[0], &_out[0], _atomicFuncArg);
+            in[1] = &py[ei];
+            int ret = (*_sparseReverseOne)(i, &in[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order reverse mode failed.");
 
@@ -579,9 +679,16 @@ public:
         _px.resize(_n);
         Base* compressed = &_px[0];
 
-        const Base * in[3];
+        const Base * in[4];
         in[0] = x.data();
         in[2] = py2.data();
+        if (_sparseReverseTwoShared != nullptr) {
+            _shared.resize(_reverseTwoSharedSize);
+            in[1] = &tx1[0];
+            in[3] = _shared.data();
+            _out[0] = _shared.data();
+            (*_sparseReverseTwoShared)(&in[0], &_out[0], _atomicFuncArg);
+        }
         _out[0] = compressed;
 
         for (size_t ej = 0; ej < tx1Nnz; ej++) {
@@ -615,12 +722,11 @@ public:
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* row;
-        unsigned long const* col;
-        unsigned long nnz;
-        (*_jacobianSparsity)(&row, &col, &nnz);
+        unsigned long const* row = _jacRows;
+        unsigned long const* col = _jacCols;
+        unsigned long nnz = _jacNnz;
 
-        CppAD::vector<Base> compressed(nnz);
+        CppAD::vector<Base>& compressed = _compressedJac;
 
         if (nnz > 0) {
             _in[0] = x.data();
@@ -646,10 +752,9 @@ public:
                              " please use the variable size methods");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* drow;
-        unsigned long const* dcol;
-        unsigned long nnz;
-        (*_jacobianSparsity)(&drow, &dcol, &nnz);
+        unsigned long const* drow = _jacRows;
+        unsigned long const* dcol = _jacCols;
+        unsigned long nnz = _jacNnz;
 
         jac.resize(nnz);
         row.resize(nnz);
@@ -676,10 +781,9 @@ public:
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* drow;
-        unsigned long const* dcol;
-        unsigned long nnz;
-        (*_jacobianSparsity)(&drow, &dcol, &nnz);
+        unsigned long const* drow = _jacRows;
+        unsigned long const* dcol = _jacCols;
+        unsigned long nnz = _jacNnz;
         CPPADCG_ASSERT_KNOWN(nnz == jac.size(), "Invalid number of non-zero elements in Jacobian");
         *row = drow;
         *col = dcol;
@@ -701,10 +805,9 @@ public:
         CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* drow;
-        unsigned long const* dcol;
-        unsigned long nnz;
-        (*_jacobianSparsity)(&drow, &dcol, &nnz);
+        unsigned long const* drow = _jacRows;
+        unsigned long const* dcol = _jacCols;
+        unsigned long nnz = _jacNnz;
         CPPADCG_ASSERT_KNOWN(nnz == jac.size(), "Invalid number of non-zero elements in Jacobian");
         *row = drow;
         *col = dcol;
@@ -716,6 +819,40 @@ public:
         }
     }
 
+    bool isSparseJacobianBatchAvailable() override {
+        return _jacobianSparsity != nullptr && _sparseJacobianBatch != nullptr;
+    }
+
+    /// calculate sparse Jacobians for several points
+    void SparseJacobianBatch(size_t nPoints,
+                             ArrayView<const Base> x,
+                             ArrayView<Base> jac,
+                             size_t const** row,
+                             size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianBatch != nullptr, "No sparse Jacobian batch function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
+
+        unsigned long const* drow = _jacRows;
+        unsigned long const* dcol = _jacCols;
+        unsigned long nnz = _jacNnz;
+        CPPADCG_ASSERT_KNOWN(nnz * nPoints == jac.size(), "Invalid number of non-zero elements in Jacobian");
+        *row = drow;
+        *col = dcol;
+
+        if (nnz > 0 && nPoints > 0) {
+            _in[0] = x.data();
+            _out[0] = jac.data();
+
+            int ret = (*_sparseJacobianBatch)(nPoints, &_in[0], &_out[0], _atomicFuncArg);
+
+            CPPADCG_ASSERT_KNOWN(ret == 0, "Sparse Jacobian batch evaluation failed.");
+        }
+    }
+
     bool isSparseHessianAvailable() override {
         return _hessianSparsity != nullptr && _sparseHessian != nullptr;
     }
@@ -734,11 +871,11 @@ public:
                              " please use the variable size methods");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* row, *col;
-        unsigned long nnz;
-        (*_hessianSparsity)(&row, &col, &nnz);
+        unsigned long const* row = _hessRows;
+        unsigned long const* col = _hessCols;
+        unsigned long nnz = _hessNnz;
 
-        CppAD::vector<Base> compressed(nnz);
+        CppAD::vector<Base>& compressed = _compressedHess;
         if (nnz > 0) {
             _inHess[0] = x.data();
             _inHess[1] = w.data();
@@ -767,9 +904,9 @@ public:
                              " please use the variable size methods");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* drow, *dcol;
-        unsigned long nnz;
-        (*_hessianSparsity)(&drow, &dcol, &nnz);
+        unsigned long const* drow = _hessRows;
+        unsigned long const* dcol = _hessCols;
+        unsigned long nnz = _hessNnz;
 
         hess.resize(nnz);
         row.resize(nnz);
@@ -800,9 +937,9 @@ public:
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* drow, *dcol;
-        unsigned long nnz;
-        (*_hessianSparsity)(&drow, &dcol, &nnz);
+        unsigned long const* drow = _hessRows;
+        unsigned long const* dcol = _hessCols;
+        unsigned long nnz = _hessNnz;
         CPPADCG_ASSERT_KNOWN(nnz == hess.size(), "Invalid number of non-zero elements in Hessian");
         *row = drow;
         *col = dcol;
@@ -827,9 +964,9 @@ public:
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet");
 
-        unsigned long const* drow, *dcol;
-        unsigned long nnz;
-        (*_hessianSparsity)(&drow, &dcol, &nnz);
+        unsigned long const* drow = _hessRows;
+        unsigned long const* dcol = _hessCols;
+        unsigned long nnz = _hessNnz;
         CPPADCG_ASSERT_KNOWN(nnz == hess.size(), "Invalid number of non-zero elements in Hessian");
         *row = drow;
         *col = dcol;
@@ -843,6 +980,156 @@ public:
         }
     }
 
+    /***********************************************************************
+     *                        Reentrant evaluation
+     **********************************************************************/
+
+    GenericModelWorkspace<Base> createWorkspace() const override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+
+        return GenericModelWorkspace<Base>(_in.size(), _out.size(), _jacNnz, _hessNnz);
+    }
+
+    void ForwardZero(GenericModelWorkspace<Base>& work,
+                     ArrayView<const Base> x,
+                     ArrayView<Base> dep) const override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(work._in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(_atomicNames.empty(), "Reentrant evaluations are not supported by models using atomic functions");
+
+        work._in[0] = x.data();
+        work._out[0] = dep.data();
+
+        (*_zero)(&work._in[0], &work._out[0], _atomicFuncArg);
+    }
+
+    void SparseJacobian(GenericModelWorkspace<Base>& work,
+                        ArrayView<const Base> x,
+                        ArrayView<Base> jac) const override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse jacobian function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(work._in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size");
+        CPPADCG_ASSERT_KNOWN(_atomicNames.empty(), "Reentrant evaluations are not supported by models using atomic functions");
+
+        unsigned long const* row = _jacRows;
+        unsigned long const* col = _jacCols;
+        unsigned long nnz = _jacNnz;
+
+        CppAD::vector<Base>& compressed = work._compressedJac;
+        CPPADCG_ASSERT_KNOWN(compressed.size() == nnz, "Invalid workspace (created for a different model?)");
+
+        if (nnz > 0) {
+            work._in[0] = x.data();
+            work._out[0] = &compressed[0];
+
+            (*_sparseJacobian)(&work._in[0], &work._out[0], _atomicFuncArg);
+        }
+
+        createDenseFromSparse(compressed,
+                              _m, _n,
+                              row, col,
+                              nnz,
+                              jac);
+    }
+
+    void SparseJacobian(GenericModelWorkspace<Base>& work,
+                        ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) const override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(work._in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(_atomicNames.empty(), "Reentrant evaluations are not supported by models using atomic functions");
+
+        unsigned long const* drow = _jacRows;
+        unsigned long const* dcol = _jacCols;
+        unsigned long nnz = _jacNnz;
+        CPPADCG_ASSERT_KNOWN(nnz == jac.size(), "Invalid number of non-zero elements in Jacobian");
+        *row = drow;
+        *col = dcol;
+
+        if (nnz > 0) {
+            work._in[0] = x.data();
+            work._out[0] = jac.data();
+
+            (*_sparseJacobian)(&work._in[0], &work._out[0], _atomicFuncArg);
+        }
+    }
+
+    void SparseHessian(GenericModelWorkspace<Base>& work,
+                       ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) const override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(work._in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(_atomicNames.empty(), "Reentrant evaluations are not supported by models using atomic functions");
+
+        unsigned long const* row = _hessRows;
+        unsigned long const* col = _hessCols;
+        unsigned long nnz = _hessNnz;
+
+        CppAD::vector<Base>& compressed = work._compressedHess;
+        CPPADCG_ASSERT_KNOWN(compressed.size() == nnz, "Invalid workspace (created for a different model?)");
+
+        if (nnz > 0) {
+            work._inHess[0] = x.data();
+            work._inHess[1] = w.data();
+            work._out[0] = &compressed[0];
+
+            (*_sparseHessian)(&work._inHess[0], &work._out[0], _atomicFuncArg);
+        }
+
+        createDenseFromSparse(compressed,
+                              _n, _n,
+                              row, col,
+                              nnz,
+                              hess);
+    }
+
+    void SparseHessian(GenericModelWorkspace<Base>& work,
+                       ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) const override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, "Model library is not ready (possibly closed)");
+        CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library");
+        CPPADCG_ASSERT_KNOWN(work._in.size() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(_atomicNames.empty(), "Reentrant evaluations are not supported by models using atomic functions");
+
+        unsigned long const* drow = _hessRows;
+        unsigned long const* dcol = _hessCols;
+        unsigned long nnz = _hessNnz;
+        CPPADCG_ASSERT_KNOWN(nnz == hess.size(), "Invalid number of non-zero elements in Hessian");
+        *row = drow;
+        *col = dcol;
+
+        if (nnz > 0) {
+            work._inHess[0] = x.data();
+            work._inHess[1] = w.data();
+            work._out[0] = hess.data();
+
+            (*_sparseHessian)(&work._inHess[0], &work._out[0], _atomicFuncArg);
+        }
+    }
+
 protected:
 
     /**
@@ -858,6 +1145,7 @@ protected:
         _atomicFuncArg{nullptr}, // not really required
         _missingAtomicFunctions(0),
         _zero(nullptr),
+        _zeroBatch(nullptr),
         _forwardOne(nullptr),
         _reverseOne(nullptr),
         _reverseTwo(nullptr),
@@ -866,14 +1154,27 @@ protected:
         _sparseForwardOne(nullptr),
         _sparseReverseOne(nullptr),
         _sparseReverseTwo(nullptr),
+        _sparseForwardOneShared(nullptr),
+        _sparseReverseOneShared(nullptr),
+        _sparseReverseTwoShared(nullptr),
+        _forwardOneSharedSize(0),
+        _reverseOneSharedSize(0),
+        _reverseTwoSharedSize(0),
         _sparseJacobian(nullptr),
+        _sparseJacobianBatch(nullptr),
         _sparseHessian(nullptr),
         _forwardOneSparsity(nullptr),
         _reverseOneSparsity(nullptr),
         _reverseTwoSparsity(nullptr),
         _jacobianSparsity(nullptr),
         _hessianSparsity(nullptr),
-        _hessianSparsity2(nullptr) {
+        _hessianSparsity2(nullptr),
+        _jacRows(nullptr),
+        _jacCols(nullptr),
+        _jacNnz(0),
+        _hessRows(nullptr),
+        _hessCols(nullptr),
+        _hessNnz(0) {
 
     }
 
@@ -888,6 +1189,29 @@ protected:
     virtual void* loadFunction(const std::string& functionName,
                                bool required = true) = 0;
 
+    /**
+     * Loads an optional function which computes the values shared by the
+     * directional functions of a sparse mode.
+     *
+     * @param function the function name (without the model name)
+     * @param size the number of shared values (zero if the function is not
+     *             available)
+     * @return the function or nullptr if it is not available
+     */
+    inline void* loadSharedFunction(const std::string& function,
+                                    unsigned long& size) {
+        size = 0;
+        void* fun = loadFunction(_name + "_" + function, false);
+        if (fun == nullptr)
+            return nullptr;
+
+        void (*sizeFunc)(unsigned long*);
+        sizeFunc = reinterpret_cast<decltype(sizeFunc)>(loadFunction(_name + "_" + function + "_size"));
+        (*sizeFunc)(&size);
+
+        return fun;
+    }
+
     virtual void validate() {
         /**
          * Check the data type
@@ -922,6 +1246,7 @@ protected:
 
     virtual void loadFunctions() {
         _zero = reinterpret_cast<decltype(_zero)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO, false));
+        _zeroBatch = reinterpret_cast<decltype(_zeroBatch)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_BATCH, false));
         _forwardOne = reinterpret_cast<decltype(_forwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE, false));
         _reverseOne = reinterpret_cast<decltype(_reverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE, false));
         _reverseTwo = reinterpret_cast<decltype(_reverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO, false));
@@ -930,7 +1255,11 @@ protected:
         _sparseForwardOne = reinterpret_cast<decltype(_sparseForwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE, false));
         _sparseReverseOne = reinterpret_cast<decltype(_sparseReverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE, false));
         _sparseReverseTwo = reinterpret_cast<decltype(_sparseReverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, false));
+        _sparseForwardOneShared = reinterpret_cast<decltype(_sparseForwardOneShared)>(loadSharedFunction(ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE_SHARED, _forwardOneSharedSize));
+        _sparseReverseOneShared = reinterpret_cast<decltype(_sparseReverseOneShared)>(loadSharedFunction(ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE_SHARED, _reverseOneSharedSize));
+        _sparseReverseTwoShared = reinterpret_cast<decltype(_sparseReverseTwoShared)>(loadSharedFunction(ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO_SHARED, _reverseTwoSharedSize));
         _sparseJacobian = reinterpret_cast<decltype(_sparseJacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN, false));
+        _sparseJacobianBatch = reinterpret_cast<decltype(_sparseJacobianBatch)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN_BATCH, false));
         _sparseHessian = reinterpret_cast<decltype(_sparseHessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN, false));
         _forwardOneSparsity = reinterpret_cast<decltype(_forwardOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY, false));
         _reverseOneSparsity = reinterpret_cast<decltype(_reverseOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, false));
@@ -947,8 +1276,21 @@ protected:
         CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwoSparsity == nullptr), "Missing functions in the dynamic library");
         CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr), "Missing functions in the dynamic library");
         CPPADCG_ASSERT_KNOWN((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library");
+        CPPADCG_ASSERT_KNOWN((_sparseJacobianBatch == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library");
         CPPADCG_ASSERT_KNOWN((_sparseHessian == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library");
 
+        /**
+         * Cache the sparsity patterns
+         */
+        if (_jacobianSparsity != nullptr) {
+            (*_jacobianSparsity)(&_jacRows, &_jacCols, &_jacNnz);
+            _compressedJac.resize(_jacNnz);
+        }
+        if (_hessianSparsity != nullptr) {
+            (*_hessianSparsity)(&_hessRows, &_hessCols, &_hessNnz);
+            _compressedHess.resize(_hessNnz);
+        }
+
         /**
          * Prepare the atomic functions argument
          */
@@ -1012,6 +1354,7 @@ protected:
     virtual void modelLibraryClosed() {
         _isLibraryReady = false;
         _zero = nullptr;
+        _zeroBatch = nullptr;
         _forwardOne = nullptr;
         _reverseOne = nullptr;
         _reverseTwo = nullptr;
@@ -1020,7 +1363,14 @@ protected:
         _sparseForwardOne = nullptr;
         _sparseReverseOne = nullptr;
         _sparseReverseTwo = nullptr;
+        _sparseForwardOneShared = nullptr;
+        _sparseReverseOneShared = nullptr;
+        _sparseReverseTwoShared = nullptr;
+        _forwardOneSharedSize = 0;
+        _reverseOneSharedSize = 0;
+        _reverseTwoSharedSize = 0;
         _sparseJacobian = nullptr;
+        _sparseJacobianBatch = nullptr;
         _sparseHessian = nullptr;
         _forwardOneSparsity = nullptr;
         _reverseOneSparsity = nullptr;
@@ -1028,6 +1378,12 @@ protected:
         _jacobianSparsity = nullptr;
         _hessianSparsity = nullptr;
         _hessianSparsity2 = nullptr;
+        _jacRows = nullptr;
+        _jacCols = nullptr;
+        _jacNnz = 0;
+        _hessRows = nullptr;
+        _hessCols = nullptr;
+        _hessNnz = 0;
     }
 
 private:
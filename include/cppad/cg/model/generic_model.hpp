@@ -61,6 +61,37 @@ public:
     virtual void JacobianSparsity(std::vector<size_t>& equations,
                                   std::vector<size_t>& variables) = 0;
 
+    /**
+     * Provides the Jacobian sparsity in a compressed row format.
+     *
+     * @return The Jacobian sparsity
+     */
+    virtual SparsityPattern JacobianSparsityPattern() {
+        std::vector<size_t> rows, cols;
+        JacobianSparsity(rows, cols);
+        return SparsityPattern(Range(), Domain(), rows, cols);
+    }
+
+    /**
+     * Provides the row indices of the non-zero Jacobian elements in the
+     * same order used by the sparse Jacobian evaluation methods.
+     * No data is copied: the returned array is owned by the model and it
+     * is only valid while the model library is loaded.
+     *
+     * @return the row indices of the non-zero Jacobian elements
+     */
+    virtual ArrayView<const size_t> JacobianSparsityRows() = 0;
+
+    /**
+     * Provides the column indices of the non-zero Jacobian elements in the
+     * same order used by the sparse Jacobian evaluation methods.
+     * No data is copied: the returned array is owned by the model and it
+     * is only valid while the model library is loaded.
+     *
+     * @return the column indices of the non-zero Jacobian elements
+     */
+    virtual ArrayView<const size_t> JacobianSparsityCols() = 0;
+
     /**
      * Determines whether or not the sparsity pattern for the weighted sum of
      * the Hessians can be requested.
@@ -81,6 +112,40 @@ public:
     virtual void HessianSparsity(std::vector<size_t>& rows,
                                  std::vector<size_t>& cols) = 0;
 
+    /**
+     * Provides the sparsity of the sum of the hessian for each dependent
+     * variable in a compressed row format.
+     *
+     * @return The sparsity
+     */
+    virtual SparsityPattern HessianSparsityPattern() {
+        std::vector<size_t> rows, cols;
+        HessianSparsity(rows, cols);
+        return SparsityPattern(Domain(), Domain(), rows, cols);
+    }
+
+    /**
+     * Provides the row indices of the non-zero elements of the weighted sum
+     * of the Hessians in the same order used by the sparse Hessian
+     * evaluation methods.
+     * No data is copied: the returned array is owned by the model and it
+     * is only valid while the model library is loaded.
+     *
+     * @return the row indices of the non-zero Hessian elements
+     */
+    virtual ArrayView<const size_t> HessianSparsityRows() = 0;
+
+    /**
+     * Provides the column indices of the non-zero elements of the weighted
+     * sum of the Hessians in the same order used by the sparse Hessian
+     * evaluation methods.
+     * No data is copied: the returned array is owned by the model and it
+     * is only valid while the model library is loaded.
+     *
+     * @return the column indices of the non-zero Hessian elements
+     */
+    virtual ArrayView<const size_t> HessianSparsityCols() = 0;
+
     /**
      * Determines whether or not the sparsity pattern for the Hessian
      * associated with a dependent variable can be requested.
@@ -102,6 +167,19 @@ public:
                                  std::vector<size_t>& rows,
                                  std::vector<size_t>& cols) = 0;
 
+    /**
+     * Provides the sparsity of the hessian for a dependent variable in a
+     * compressed row format.
+     *
+     * @param i The index of the dependent variable
+     * @return The sparsity
+     */
+    virtual SparsityPattern HessianSparsityPattern(size_t i) {
+        std::vector<size_t> rows, cols;
+        HessianSparsity(i, rows, cols);
+        return SparsityPattern(Domain(), Domain(), rows, cols);
+    }
+
     /**
      * Provides the number of independent variables.
      * 
@@ -168,6 +246,101 @@ public:
         return _evalAtomicForwardOne4CppAD;
     }
 
+    /***********************************************************************
+     *                        Reentrant evaluation
+     **********************************************************************/
+
+    /**
+     * Creates a new workspace for the reentrant (const) evaluation methods.
+     * Each thread should use its own workspace, which allows the same model
+     * object to be used simultaneously by several threads.
+     *
+     * @return a workspace with all the arrays required for the model
+     *         evaluation already allocated
+     */
+    virtual GenericModelWorkspace<Base> createWorkspace() const = 0;
+
+    /**
+     * Evaluates the dependent model variables (zero-order).
+     * This method can be called simultaneously from different threads as
+     * long as each thread uses a different workspace.
+     *
+     * @param work the evaluation workspace
+     * @param x The independent variable vector
+     * @param dep The dependent variable vector
+     */
+    virtual void ForwardZero(GenericModelWorkspace<Base>& work,
+                             ArrayView<const Base> x,
+                             ArrayView<Base> dep) const = 0;
+
+    /**
+     * Calculates a Jacobian using sparse methods and saves it into a dense
+     * format.
+     * This method can be called simultaneously from different threads as
+     * long as each thread uses a different workspace.
+     *
+     * @param work the evaluation workspace
+     * @param x independent variable array (must have n elements)
+     * @param jac an array where the dense jacobian will be placed (must be allocated with at least m * n elements)
+     */
+    virtual void SparseJacobian(GenericModelWorkspace<Base>& work,
+                                ArrayView<const Base> x,
+                                ArrayView<Base> jac) const = 0;
+
+    /**
+     * Calculates a sparse Jacobian.
+     * This method can be called simultaneously from different threads as
+     * long as each thread uses a different workspace.
+     *
+     * @param work the evaluation workspace
+     * @param x independent variable array (must have n elements)
+     * @param jac The values of the sparse Jacobian in the order provided by
+     *            row and col
+     * @param row The row indices of the Jacobian values
+     * @param col The column indices of the Jacobian values
+     */
+    virtual void SparseJacobian(GenericModelWorkspace<Base>& work,
+                                ArrayView<const Base> x,
+                                ArrayView<Base> jac,
+                                size_t const** row,
+                                size_t const** col) const = 0;
+
+    /**
+     * Calculates a Hessian using sparse methods and saves it into a dense
+     * format.
+     * This method can be called simultaneously from different threads as
+     * long as each thread uses a different workspace.
+     *
+     * @param work the evaluation workspace
+     * @param x independent variable array (must have n elements)
+     * @param w multiplier array (must have m elements)
+     * @param hess an array where the dense Hessian will be placed (must be allocated with at least n * n elements)
+     */
+    virtual void SparseHessian(GenericModelWorkspace<Base>& work,
+                               ArrayView<const Base> x,
+                               ArrayView<const Base> w,
+                               ArrayView<Base> hess) const = 0;
+
+    /**
+     * Calculates a sparse Hessian.
+     * This method can be called simultaneously from different threads as
+     * long as each thread uses a different workspace.
+     *
+     * @param work the evaluation workspace
+     * @param x independent variable array (must have n elements)
+     * @param w multiplier array (must have m elements)
+     * @param hess The values of the sparse hessian in the order provided by
+     *             row and col
+     * @param row The row indices of the hessian values
+     * @param col The column indices of the hessian values
+     */
+    virtual void SparseHessian(GenericModelWorkspace<Base>& work,
+                               ArrayView<const Base> x,
+                               ArrayView<const Base> w,
+                               ArrayView<Base> hess,
+                               size_t const** row,
+                               size_t const** col) const = 0;
+
     /***********************************************************************
      *                        Forward zero
      **********************************************************************/
@@ -235,6 +408,31 @@ public:
     virtual void ForwardZero(const std::vector<const Base*> &x,
                              ArrayView<Base> dep) = 0;
 
+    /**
+     * Determines whether or not the model can be evaluated for several
+     * points with a single call (zero-order forward mode).
+     *
+     * @return true if it is possible to evaluate the model for several
+     *         points at once
+     */
+    virtual bool isForwardZeroBatchAvailable() = 0;
+
+    /**
+     * Evaluates the dependent model variables (zero-order) for several
+     * points.
+     * The values are provided using a structure-of-arrays layout, where the
+     * value of the independent variable j at point p is x[j * nPoints + p]
+     * and the value of the dependent variable i at point p is
+     * dep[i * nPoints + p].
+     *
+     * @param nPoints The number of points
+     * @param x The independent variables for all points (n * nPoints elements)
+     * @param dep The dependent variables for all points (m * nPoints elements)
+     */
+    virtual void ForwardZeroBatch(size_t nPoints,
+                                  ArrayView<const Base> x,
+                                  ArrayView<Base> dep) = 0;
+
     /***********************************************************************
      *                        Dense Jacobian
      **********************************************************************/
@@ -675,6 +873,35 @@ public:
                                 size_t const** row,
                                 size_t const** col) = 0;
 
+    /**
+     * Determines whether or not the sparse Jacobian can be evaluated for
+     * several points with a single call.
+     *
+     * @return true if it is possible to evaluate the sparse Jacobian for
+     *         several points at once
+     */
+    virtual bool isSparseJacobianBatchAvailable() = 0;
+
+    /**
+     * Determines the sparse Jacobian for several points.
+     * The values are provided using a structure-of-arrays layout, where the
+     * value of the independent variable j at point p is x[j * nPoints + p]
+     * and the value of the Jacobian element e at point p is
+     * jac[e * nPoints + p].
+     *
+     * @param nPoints The number of points
+     * @param x The independent variables for all points (n * nPoints elements)
+     * @param jac The values of the sparse Jacobian for all points
+     *            (nnz * nPoints elements) in the order provided by row and col
+     * @param row The row indices of the Jacobian values
+     * @param col The column indices of the Jacobian values
+     */
+    virtual void SparseJacobianBatch(size_t nPoints,
+                                     ArrayView<const Base> x,
+                                     ArrayView<Base> jac,
+                                     size_t const** row,
+                                     size_t const** col) = 0;
+
     /***********************************************************************
      *                        Sparse Hessians
      **********************************************************************/
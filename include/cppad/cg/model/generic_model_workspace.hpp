@@ -0,0 +1,77 @@
+#ifndef CPPAD_CG_GENERIC_MODEL_WORKSPACE_INCLUDED
+#define CPPAD_CG_GENERIC_MODEL_WORKSPACE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Holds the temporary data required to evaluate a generic model.
+ *
+ * A workspace allows the same model object to be evaluated simultaneously
+ * in different threads (each thread should use its own workspace).
+ * Workspaces are created by GenericModel::createWorkspace() with all
+ * arrays already allocated, so no memory allocations are performed
+ * during evaluations.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class GenericModelWorkspace {
+protected:
+    /// pointers to the independent variable arrays
+    std::vector<const Base*> _in;
+    /// pointers to the independent variable arrays and the multipliers
+    std::vector<const Base*> _inHess;
+    /// pointers to the dependent variable arrays
+    std::vector<Base*> _out;
+    /// the values of the non-zero Jacobian elements
+    CppAD::vector<Base> _compressedJac;
+    /// the values of the non-zero Hessian elements
+    CppAD::vector<Base> _compressedHess;
+    /// the registers of interpreted models (one array per program)
+    std::vector<std::vector<Base> > _registers;
+public:
+
+    /**
+     * Creates a new workspace
+     *
+     * @param inSize the number of independent variable arrays
+     * @param outSize the number of dependent variable arrays
+     * @param jacNnz the number of non-zero elements in the Jacobian
+     * @param hessNnz the number of non-zero elements in the Hessian
+     */
+    inline GenericModelWorkspace(size_t inSize,
+                                 size_t outSize,
+                                 size_t jacNnz,
+                                 size_t hessNnz) :
+        _in(inSize),
+        _inHess(inSize + 1),
+        _out(outSize),
+        _compressedJac(jacNnz),
+        _compressedHess(hessNnz) {
+    }
+
+    inline virtual ~GenericModelWorkspace() = default;
+
+    friend class FunctorGenericModel<Base>;
+    friend class InterpretedGenericModel<Base>;
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,825 @@
+#ifndef CPPAD_CG_INTERPRETED_GENERIC_MODEL_INCLUDED
+#define CPPAD_CG_INTERPRETED_GENERIC_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model evaluated by interpreting bytecode programs (see
+ * BytecodeProgram) created directly from the operation graphs, without
+ * generating or compiling any source code.
+ *
+ * It can be used while a compiled model library is not available yet
+ * (e.g. during the development of a model or while the compilation is
+ * taking place in the background).
+ * The zero-order forward mode, the sparse Jacobian, and the sparse Hessian
+ * are available (the dense versions are determined from the sparse ones).
+ * Models with atomic functions or loops are not supported.
+ *
+ * This class is not thread-safe and it should not be used simultaneously in
+ * different threads; the const evaluation methods which receive a
+ * GenericModelWorkspace can be used simultaneously in different threads
+ * (one workspace per thread).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class InterpretedGenericModel : public GenericModel<Base> {
+public:
+    using CGBase = CG<Base>;
+    using ADCG = AD<CGBase>;
+protected:
+    /// the model name
+    const std::string _name;
+    size_t _m;
+    size_t _n;
+    std::vector<std::string> _atomicNames; // always empty
+    // the programs
+    BytecodeProgram<Base> _zero;
+    BytecodeProgram<Base> _sparseJacobian;
+    BytecodeProgram<Base> _sparseHessian;
+    bool _jacobianAvailable;
+    bool _hessianAvailable;
+    // sparsity patterns
+    SparsityPattern _jacSparsity;
+    std::vector<size_t> _jacRows;
+    std::vector<size_t> _jacCols;
+    SparsityPattern _hessSparsity;
+    std::vector<size_t> _hessRows;
+    std::vector<size_t> _hessCols;
+    // registers used by the non-reentrant methods
+    std::vector<Base> _zeroRegisters;
+    std::vector<Base> _jacRegisters;
+    std::vector<Base> _hessRegisters;
+    // buffers for the non-zero elements of the Jacobian and Hessian
+    CppAD::vector<Base> _compressedJac;
+    CppAD::vector<Base> _compressedHess;
+public:
+
+    /**
+     * Creates a new model.
+     *
+     * @param fun the model (it must not use atomic functions)
+     * @param name the model name
+     * @param jacobian whether or not to create the sparse Jacobian program
+     * @param hessian whether or not to create the sparse Hessian program
+     * @throws CGException if the model uses operations which are not
+     *                     supported by bytecode programs
+     */
+    InterpretedGenericModel(ADFun<CGBase>& fun,
+                            const std::string& name,
+                            bool jacobian = true,
+                            bool hessian = true) :
+        _name(name),
+        _m(fun.Range()),
+        _n(fun.Domain()),
+        _jacobianAvailable(jacobian),
+        _hessianAvailable(hessian) {
+
+        createForwardZero(fun);
+        _zero.initRegisters(_zeroRegisters);
+
+        if (jacobian) {
+            createSparseJacobian(fun);
+            _sparseJacobian.initRegisters(_jacRegisters);
+            _compressedJac.resize(_jacRows.size());
+        }
+
+        if (hessian) {
+            createSparseHessian(fun);
+            _sparseHessian.initRegisters(_hessRegisters);
+            _compressedHess.resize(_hessRows.size());
+        }
+    }
+
+    InterpretedGenericModel(const InterpretedGenericModel&) = delete;
+    InterpretedGenericModel& operator=(const InterpretedGenericModel&) = delete;
+
+    virtual ~InterpretedGenericModel() = default;
+
+    /**
+     * Provides the program used to evaluate the zero-order forward mode.
+     */
+    inline const BytecodeProgram<Base>& getForwardZeroProgram() const {
+        return _zero;
+    }
+
+    /**
+     * Provides the program used to evaluate the sparse Jacobian (only
+     * defined if the Jacobian is available).
+     */
+    inline const BytecodeProgram<Base>& getSparseJacobianProgram() const {
+        return _sparseJacobian;
+    }
+
+    /**
+     * Provides the program used to evaluate the sparse Hessian (only
+     * defined if the Hessian is available).
+     */
+    inline const BytecodeProgram<Base>& getSparseHessianProgram() const {
+        return _sparseHessian;
+    }
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return _atomicNames;
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        return false; // not used by this model
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        return false; // not used by this model
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        return _jacobianAvailable;
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No Jacobian sparsity available in the interpreted model");
+
+        std::vector<bool> s(_m * _n, false);
+        for (size_t e = 0; e < _jacRows.size(); e++) {
+            s[_jacRows[e] * _n + _jacCols[e]] = true;
+        }
+        return s;
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No Jacobian sparsity available in the interpreted model");
+
+        return _jacSparsity.toSet();
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No Jacobian sparsity available in the interpreted model");
+
+        equations = _jacRows;
+        variables = _jacCols;
+    }
+
+    ArrayView<const size_t> JacobianSparsityRows() override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No Jacobian sparsity available in the interpreted model");
+
+        return ArrayView<const size_t>(_jacRows.data(), _jacRows.size());
+    }
+
+    ArrayView<const size_t> JacobianSparsityCols() override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No Jacobian sparsity available in the interpreted model");
+
+        return ArrayView<const size_t>(_jacCols.data(), _jacCols.size());
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        return _hessianAvailable;
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No Hessian sparsity available in the interpreted model");
+
+        std::vector<bool> s(_n * _n, false);
+        for (size_t e = 0; e < _hessRows.size(); e++) {
+            s[_hessRows[e] * _n + _hessCols[e]] = true;
+        }
+        return s;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No Hessian sparsity available in the interpreted model");
+
+        return _hessSparsity.toSet();
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No Hessian sparsity available in the interpreted model");
+
+        rows = _hessRows;
+        cols = _hessCols;
+    }
+
+    ArrayView<const size_t> HessianSparsityRows() override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No Hessian sparsity available in the interpreted model");
+
+        return ArrayView<const size_t>(_hessRows.data(), _hessRows.size());
+    }
+
+    ArrayView<const size_t> HessianSparsityCols() override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No Hessian sparsity available in the interpreted model");
+
+        return ArrayView<const size_t>(_hessCols.data(), _hessCols.size());
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return false;
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        throw CGException("The Hessian sparsity of individual equations is not available in interpreted models");
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        throw CGException("The Hessian sparsity of individual equations is not available in interpreted models");
+    }
+
+    void HessianSparsity(size_t i, std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        throw CGException("The Hessian sparsity of individual equations is not available in interpreted models");
+    }
+
+    /// number of independent variables
+
+    size_t Domain() const override {
+        return _n;
+    }
+
+    /// number of dependent variables
+
+    size_t Range() const override {
+        return _m;
+    }
+
+    bool isForwardZeroAvailable() override {
+        return true;
+    }
+
+    /// calculate the dependent values (zero order)
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+
+        const Base* in[] = {x.data()};
+        _zero.evaluate(_zeroRegisters, in, dep.data());
+    }
+
+    void ForwardZero(const std::vector<const Base*> &x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid");
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size");
+
+        _zero.evaluate(_zeroRegisters, x.data(), dep.data());
+    }
+
+    bool isForwardZeroBatchAvailable() override {
+        return true;
+    }
+
+    /// calculate the dependent values (zero order) for several points
+    void ForwardZeroBatch(size_t nPoints,
+                          ArrayView<const Base> x,
+                          ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m * nPoints, "Invalid dependent array size");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size");
+
+        evaluateBatch(_zero, _zeroRegisters, nPoints, x.data(), dep.data());
+    }
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        CPPADCG_ASSERT_KNOWN(tx.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(ty.size() == _m, "Invalid dependent array size");
+
+        ForwardZero(tx, ty);
+
+        if (vx.size() > 0) {
+            CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No Jacobian sparsity available in the interpreted model");
+            CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size");
+            CPPADCG_ASSERT_KNOWN(vy.size() >= _m, "Invalid vy size");
+            for (size_t i = 0; i < _m; i++) {
+                for (size_t j : _jacSparsity.row(i)) {
+                    if (vx[j]) {
+                        vy[i] = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    bool isJacobianAvailable() override {
+        return _jacobianAvailable;
+    }
+
+    /// calculate entire Jacobian
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        SparseJacobian(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        return _hessianAvailable;
+    }
+
+    /// calculate Hessian for one component of f
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        SparseHessian(x, w, hess);
+    }
+
+    bool isForwardOneAvailable() override {
+        return false;
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        throw CGException("First-order forward mode is not available in interpreted models");
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return false;
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        throw CGException("First-order forward mode is not available in interpreted models");
+    }
+
+    bool isReverseOneAvailable() override {
+        return false;
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        throw CGException("First-order reverse mode is not available in interpreted models");
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return false;
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        throw CGException("First-order reverse mode is not available in interpreted models");
+    }
+
+    bool isReverseTwoAvailable() override {
+        return false;
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        throw CGException("Second-order reverse mode is not available in interpreted models");
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return false;
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        throw CGException("Second-order reverse mode is not available in interpreted models");
+    }
+
+    bool isSparseJacobianAvailable() override {
+        return _jacobianAvailable;
+    }
+
+    /// calculate sparse Jacobians
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No sparse Jacobian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size");
+
+        if (!_jacRows.empty()) {
+            const Base* in[] = {x.data()};
+            _sparseJacobian.evaluate(_jacRegisters, in, &_compressedJac[0]);
+        }
+
+        createDenseFromSparse(_compressedJac, _m, _n, _jacRows, _jacCols, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base> &x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No sparse Jacobian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+
+        jac.resize(_jacRows.size());
+        row = _jacRows;
+        col = _jacCols;
+
+        const Base* in[] = {x.data()};
+        _sparseJacobian.evaluate(_jacRegisters, in, jac.data());
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+
+        const Base* in[] = {x.data()};
+        SparseJacobian(in, 1, jac, row, col);
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        SparseJacobian(x.data(), x.size(), jac, row, col);
+    }
+
+    bool isSparseJacobianBatchAvailable() override {
+        return _jacobianAvailable;
+    }
+
+    /// calculate sparse Jacobians for several points
+    void SparseJacobianBatch(size_t nPoints,
+                             ArrayView<const Base> x,
+                             ArrayView<Base> jac,
+                             size_t const** row,
+                             size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No sparse Jacobian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(_jacRows.size() * nPoints == jac.size(), "Invalid number of non-zero elements in Jacobian");
+
+        *row = _jacRows.data();
+        *col = _jacCols.data();
+
+        evaluateBatch(_sparseJacobian, _jacRegisters, nPoints, x.data(), jac.data());
+    }
+
+    bool isSparseHessianAvailable() override {
+        return _hessianAvailable;
+    }
+
+    /// calculate sparse Hessians
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No sparse Hessian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+
+        if (!_hessRows.empty()) {
+            const Base* in[] = {x.data(), w.data()};
+            _sparseHessian.evaluate(_hessRegisters, in, &_compressedHess[0]);
+        }
+
+        createDenseFromSparse(_compressedHess, _n, _n, _hessRows, _hessCols, hess);
+    }
+
+    void SparseHessian(const std::vector<Base> &x,
+                       const std::vector<Base> &w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No sparse Hessian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+
+        hess.resize(_hessRows.size());
+        row = _hessRows;
+        col = _hessCols;
+
+        const Base* in[] = {x.data(), w.data()};
+        _sparseHessian.evaluate(_hessRegisters, in, hess.data());
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+
+        const Base* in[] = {x.data()};
+        SparseHessian(in, 1, w, hess, row, col);
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        SparseHessian(x.data(), x.size(), w, hess, row, col);
+    }
+
+    /***********************************************************************
+     *                        Reentrant evaluation
+     **********************************************************************/
+
+    GenericModelWorkspace<Base> createWorkspace() const override {
+        GenericModelWorkspace<Base> work(1, 1, _compressedJac.size(), _compressedHess.size());
+
+        work._registers.resize(3);
+        _zero.initRegisters(work._registers[0]);
+        if (_jacobianAvailable)
+            _sparseJacobian.initRegisters(work._registers[1]);
+        if (_hessianAvailable)
+            _sparseHessian.initRegisters(work._registers[2]);
+
+        return work;
+    }
+
+    void ForwardZero(GenericModelWorkspace<Base>& work,
+                     ArrayView<const Base> x,
+                     ArrayView<Base> dep) const override {
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(work._registers.size() == 3, "Invalid workspace (created for a different model?)");
+
+        work._in[0] = x.data();
+        _zero.evaluate(work._registers[0], work._in.data(), dep.data());
+    }
+
+    void SparseJacobian(GenericModelWorkspace<Base>& work,
+                        ArrayView<const Base> x,
+                        ArrayView<Base> jac) const override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No sparse Jacobian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(work._registers.size() == 3, "Invalid workspace (created for a different model?)");
+
+        CppAD::vector<Base>& compressed = work._compressedJac;
+
+        if (!_jacRows.empty()) {
+            work._in[0] = x.data();
+            _sparseJacobian.evaluate(work._registers[1], work._in.data(), &compressed[0]);
+        }
+
+        createDenseFromSparse(compressed, _m, _n, _jacRows, _jacCols, jac);
+    }
+
+    void SparseJacobian(GenericModelWorkspace<Base>& work,
+                        ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) const override {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No sparse Jacobian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _jacRows.size(), "Invalid number of non-zero elements in Jacobian");
+        CPPADCG_ASSERT_KNOWN(work._registers.size() == 3, "Invalid workspace (created for a different model?)");
+
+        *row = _jacRows.data();
+        *col = _jacCols.data();
+
+        work._in[0] = x.data();
+        _sparseJacobian.evaluate(work._registers[1], work._in.data(), jac.data());
+    }
+
+    void SparseHessian(GenericModelWorkspace<Base>& work,
+                       ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) const override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No sparse Hessian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(work._registers.size() == 3, "Invalid workspace (created for a different model?)");
+
+        CppAD::vector<Base>& compressed = work._compressedHess;
+
+        if (!_hessRows.empty()) {
+            work._inHess[0] = x.data();
+            work._inHess[1] = w.data();
+            _sparseHessian.evaluate(work._registers[2], work._inHess.data(), &compressed[0]);
+        }
+
+        createDenseFromSparse(compressed, _n, _n, _hessRows, _hessCols, hess);
+    }
+
+    void SparseHessian(GenericModelWorkspace<Base>& work,
+                       ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) const override {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No sparse Hessian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(hess.size() == _hessRows.size(), "Invalid number of non-zero elements in Hessian");
+        CPPADCG_ASSERT_KNOWN(work._registers.size() == 3, "Invalid workspace (created for a different model?)");
+
+        *row = _hessRows.data();
+        *col = _hessCols.data();
+
+        work._inHess[0] = x.data();
+        work._inHess[1] = w.data();
+        _sparseHessian.evaluate(work._registers[2], work._inHess.data(), hess.data());
+    }
+
+protected:
+
+    inline void SparseJacobian(const Base* const* x,
+                               size_t xSize,
+                               ArrayView<Base> jac,
+                               size_t const** row,
+                               size_t const** col) {
+        CPPADCG_ASSERT_KNOWN(_jacobianAvailable, "No sparse Jacobian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(xSize == 1, "The number of independent variable arrays is invalid");
+        CPPADCG_ASSERT_KNOWN(jac.size() == _jacRows.size(), "Invalid number of non-zero elements in Jacobian");
+
+        *row = _jacRows.data();
+        *col = _jacCols.data();
+
+        _sparseJacobian.evaluate(_jacRegisters, x, jac.data());
+    }
+
+    inline void SparseHessian(const Base* const* x,
+                              size_t xSize,
+                              ArrayView<const Base> w,
+                              ArrayView<Base> hess,
+                              size_t const** row,
+                              size_t const** col) {
+        CPPADCG_ASSERT_KNOWN(_hessianAvailable, "No sparse Hessian available in the interpreted model");
+        CPPADCG_ASSERT_KNOWN(xSize == 1, "The number of independent variable arrays is invalid");
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size");
+        CPPADCG_ASSERT_KNOWN(hess.size() == _hessRows.size(), "Invalid number of non-zero elements in Hessian");
+
+        *row = _hessRows.data();
+        *col = _hessCols.data();
+
+        const Base* in[] = {x[0], w.data()};
+        _sparseHessian.evaluate(_hessRegisters, in, hess.data());
+    }
+
+    /**
+     * Evaluates a program with a single input array for several points
+     * saved using a structure-of-arrays layout.
+     */
+    static inline void evaluateBatch(const BytecodeProgram<Base>& program,
+                                     std::vector<Base>& registers,
+                                     size_t nPoints,
+                                     const Base* x,
+                                     Base* out) {
+        const size_t n = program.getInputSize();
+        const size_t nOut = program.getOutputSize();
+        CPPADCG_ASSERT_KNOWN(program.getInputSizes().size() == 1, "Invalid number of input arrays");
+
+        for (size_t p = 0; p < nPoints; p++) {
+            Base* r = registers.data();
+            for (size_t j = 0; j < n; j++)
+                r[1 + j] = x[j * nPoints + p];
+
+            program.run(r);
+
+            for (size_t i = 0; i < nOut; i++)
+                out[i * nPoints + p] = r[program.getOutputRegister(i)];
+        }
+    }
+
+    inline void createDenseFromSparse(const CppAD::vector<Base>& compressed,
+                                      size_t nrows, size_t ncols,
+                                      const std::vector<size_t>& rows,
+                                      const std::vector<size_t>& cols,
+                                      ArrayView<Base> mat) const {
+        CPPADCG_ASSERT_KNOWN(mat.size() == nrows * ncols, "Invalid matrix size");
+        mat.fill(Base(0));
+
+        for (size_t e = 0; e < rows.size(); e++) {
+            mat[rows[e] * ncols + cols[e]] = compressed[e];
+        }
+    }
+
+    /**
+     * Creates the program for the zero-order forward mode
+     */
+    inline void createForwardZero(ADFun<CGBase>& fun) {
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> x(_n);
+        handler.makeVariables(x);
+
+        std::vector<CGBase> y = fun.Forward(0, x);
+
+        createProgram(handler, y, std::vector<size_t>(), _zero, "model");
+    }
+
+    /**
+     * Creates the program for the sparse Jacobian
+     */
+    inline void createSparseJacobian(ADFun<CGBase>& fun) {
+        _jacSparsity = jacobianSparsityPattern(fun);
+        generateSparsityIndexes(_jacSparsity, _jacRows, _jacCols);
+
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> x(_n);
+        handler.makeVariables(x);
+
+        std::vector<CGBase> jac(_jacRows.size());
+        if (!jac.empty()) {
+            // the set-based representation is only required by CppAD
+            const std::vector<std::set<size_t> > jacSparsitySet = _jacSparsity.toSet();
+            CppAD::sparse_jacobian_work work;
+            if (_n <= _m) {
+                fun.SparseJacobianForward(x, jacSparsitySet, _jacRows, _jacCols, jac, work);
+            } else {
+                fun.SparseJacobianReverse(x, jacSparsitySet, _jacRows, _jacCols, jac, work);
+            }
+        }
+
+        createProgram(handler, jac, std::vector<size_t>(), _sparseJacobian, "sparse Jacobian");
+    }
+
+    /**
+     * Creates the program for the sparse Hessian (only the lower
+     * triangle is evaluated, the other elements are copied)
+     */
+    inline void createSparseHessian(ADFun<CGBase>& fun) {
+        _hessSparsity = hessianSparsityPattern(fun);
+        generateSparsityIndexes(_hessSparsity, _hessRows, _hessCols);
+
+        // make use of the symmetry of the Hessian in order to reduce operations
+        std::vector<size_t> lowerRows, lowerCols, lowerOrder;
+        std::map<size_t, size_t> duplicates; // the elements determined using symmetry
+        for (size_t e = 0; e < _hessRows.size(); e++) {
+            size_t i = _hessRows[e];
+            size_t j = _hessCols[e];
+            if (i < j && _hessSparsity.contains(j, i)) {
+                // the elements are sorted by row and then by column
+                ArrayView<const size_t> rowJ = _hessSparsity.row(j);
+                size_t eSim = std::lower_bound(_hessRows.begin(), _hessRows.end(), j) - _hessRows.begin();
+                eSim += std::lower_bound(rowJ.begin(), rowJ.end(), i) - rowJ.begin();
+                duplicates[e] = eSim;
+            } else {
+                lowerRows.push_back(i);
+                lowerCols.push_back(j);
+                lowerOrder.push_back(e);
+            }
+        }
+
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> x(_n);
+        handler.makeVariables(x);
+
+        std::vector<CGBase> w(_m);
+        handler.makeVariables(w);
+
+        std::vector<CGBase> hess(_hessRows.size());
+        if (!lowerRows.empty()) {
+            CppAD::sparse_hessian_work work;
+            work.color_method = "cppad.general";
+            std::vector<CGBase> lowerHess(lowerRows.size());
+            fun.SparseHessian(x, w, _hessSparsity.toSet(), lowerRows, lowerCols, lowerHess, work);
+
+            for (size_t e = 0; e < lowerOrder.size(); e++) {
+                hess[lowerOrder[e]] = lowerHess[e];
+            }
+
+            for (const auto& it : duplicates) {
+                hess[it.first] = hess[it.second];
+            }
+        }
+
+        createProgram(handler, hess, std::vector<size_t>{_n, _m}, _sparseHessian, "sparse Hessian");
+    }
+
+    static inline void createProgram(CodeHandler<Base>& handler,
+                                     std::vector<CGBase>& dep,
+                                     const std::vector<size_t>& inputSizes,
+                                     BytecodeProgram<Base>& program,
+                                     const std::string& jobName) {
+        LanguageBytecode<Base> lang(inputSizes);
+        LangCDefaultVariableNameGenerator<Base> nameGen;
+
+        std::ostringstream code; // not used
+        handler.generateCode(code, lang, dep, nameGen, jobName);
+
+        program = std::move(lang.getProgram());
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef CPPAD_CG_LLVM_JIT_OPTIONS_INCLUDED
+#define CPPAD_CG_LLVM_JIT_OPTIONS_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Options for the optimization and the generation of machine code of JIT
+ * compiled model libraries.
+ *
+ * The default options reproduce the original behaviour: only
+ * function-level optimizations (O2) for a generic CPU.
+ *
+ * @author Joao Leal
+ */
+class LlvmJitOptions {
+protected:
+    /// the optimization level (0 to 3)
+    unsigned int _optLevel;
+    /// whether or not to run module-level optimizations (e.g. inlining)
+    bool _moduleOptimizations;
+    /// whether or not to use the loop and SLP vectorizers
+    bool _vectorize;
+    /// whether or not to generate code for the CPU of the host
+    bool _hostCpu;
+    /// whether or not to compile each function only when it is first called
+    bool _lazyCompilation;
+public:
+
+    inline LlvmJitOptions() :
+        _optLevel(2),
+        _moduleOptimizations(false),
+        _vectorize(false),
+        _hostCpu(false),
+        _lazyCompilation(false) {
+    }
+
+    /**
+     * Provides the optimization level used both for the IR optimization
+     * passes and for the generation of machine code.
+     *
+     * @return the optimization level (0 to 3)
+     */
+    inline unsigned int getOptimizationLevel() const {
+        return _optLevel;
+    }
+
+    /**
+     * Defines the optimization level used both for the IR optimization
+     * passes and for the generation of machine code (similar to -O0 to
+     * -O3).
+     *
+     * @param optLevel the optimization level (0 to 3)
+     */
+    inline void setOptimizationLevel(unsigned int optLevel) {
+        CPPADCG_ASSERT_KNOWN(optLevel <= 3, "Invalid optimization level")
+        _optLevel = optLevel;
+    }
+
+    inline bool isModuleOptimizations() const {
+        return _moduleOptimizations;
+    }
+
+    /**
+     * Defines whether or not to optimize the whole module (all functions
+     * together) before it is JIT compiled, which enables interprocedural
+     * optimizations such as inlining.
+     *
+     * @param moduleOptimizations true to use module-level optimizations
+     */
+    inline void setModuleOptimizations(bool moduleOptimizations) {
+        _moduleOptimizations = moduleOptimizations;
+    }
+
+    inline bool isVectorize() const {
+        return _vectorize;
+    }
+
+    /**
+     * Defines whether or not to use the loop and the SLP (superword-level
+     * parallelism) vectorizers.
+     * It is only used with module-level optimizations.
+     *
+     * @param vectorize true to use the vectorizers
+     */
+    inline void setVectorize(bool vectorize) {
+        _vectorize = vectorize;
+    }
+
+    inline bool isHostCpu() const {
+        return _hostCpu;
+    }
+
+    /**
+     * Defines whether or not to generate machine code specific for the CPU
+     * of the host, using all of its features (similar to -march=native).
+     *
+     * @param hostCpu true to target the CPU of the host
+     */
+    inline void setHostCpu(bool hostCpu) {
+        _hostCpu = hostCpu;
+    }
+
+    inline bool isLazyCompilation() const {
+        return _lazyCompilation;
+    }
+
+    /**
+     * Defines whether or not each function should only be optimized and
+     * compiled into machine code when it is called for the first time.
+     * This reduces the time to the first evaluation when only some of the
+     * generated functions are used, but module-level optimizations and
+     * object caches are not used.
+     *
+     * @param lazyCompilation true to compile functions on demand
+     */
+    inline void setLazyCompilation(bool lazyCompilation) {
+        _lazyCompilation = lazyCompilation;
+    }
+
+    /**
+     * Creates options similar to the ones typically used for an optimized
+     * build with a static compiler (e.g. -O3 -march=native).
+     */
+    static inline LlvmJitOptions aggressive() {
+        LlvmJitOptions o;
+        o.setOptimizationLevel(3);
+        o.setModuleOptimizations(true);
+        o.setVectorize(true);
+        o.setHostCpu(true);
+        return o;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
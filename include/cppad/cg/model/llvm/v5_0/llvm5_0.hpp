@@ -51,14 +51,26 @@
 #include <clang/Lex/PreprocessorOptions.h>
 
 #include <llvm/Analysis/Passes.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
+#include <llvm/ExecutionEngine/Orc/IRTransformLayer.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LambdaResolver.h>
+#include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 //#include <llvm/ExecutionEngine/JIT.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Mangler.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/Pass.h>
+#include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
@@ -69,6 +81,10 @@
 //#include <llvm/Support/system_error.h>
 #include <llvm/Linker/Linker.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Target/TargetMachine.h>
 
 #ifdef LLVM_WITH_NDEBUG
 
@@ -87,7 +103,10 @@
 #include <cppad/cg/model/compiler/clang_compiler.hpp>
 #include <cppad/cg/model/llvm/llvm_model_library.hpp>
 #include <cppad/cg/model/llvm/llvm_model.hpp>
+#include <cppad/cg/model/llvm/llvm_jit_options.hpp>
+#include <cppad/cg/model/llvm/v5_0/llvm_object_cache.hpp>
 #include <cppad/cg/model/llvm/v5_0/llvm_model_library_impl.hpp>
+#include <cppad/cg/model/llvm/v5_0/llvm_lazy_model_library_impl.hpp>
 #include <cppad/cg/model/llvm/v5_0/llvm_model_library_processor.hpp>
 
 #endif
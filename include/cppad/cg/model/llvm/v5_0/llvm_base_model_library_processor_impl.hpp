@@ -31,6 +31,9 @@ class LlvmBaseModelLibraryProcessorImpl : public LlvmBaseModelLibraryProcessor<B
 protected:
     const std::string _version;
     std::vector<std::string> _includePaths;
+    LlvmJitOptions _jitOptions;
+    LlvmObjectCache* _objectCache; // not owned
+    size_t _maxJobs; // maximum number of threads used to create LLVM modules
     std::shared_ptr<llvm::LLVMContext> _context; // must be deleted after _linker and _module (it must come first)
     std::unique_ptr<llvm::Linker> _linker;
     std::unique_ptr<llvm::Module> _module;
@@ -44,7 +47,9 @@ public:
     LlvmBaseModelLibraryProcessorImpl(ModelLibraryCSourceGen<Base>& librarySourceGen,
                                       const std::string& version) :
         LlvmBaseModelLibraryProcessor<Base>(librarySourceGen),
-            _version(version) {
+            _version(version),
+            _objectCache(nullptr),
+            _maxJobs(std::max<size_t>(1, std::thread::hardware_concurrency())) {
     }
 
     virtual ~LlvmBaseModelLibraryProcessorImpl() = default;
@@ -63,6 +68,74 @@ public:
         return _includePaths;
     }
 
+    /**
+     * Provides the options used to optimize and JIT compile the model
+     * library.
+     */
+    inline const LlvmJitOptions& getJitOptions() const {
+        return _jitOptions;
+    }
+
+    /**
+     * Defines the options used to optimize and JIT compile the model
+     * library (e.g. the optimization level and the target CPU).
+     */
+    inline void setJitOptions(const LlvmJitOptions& jitOptions) {
+        _jitOptions = jitOptions;
+    }
+
+    /**
+     * Provides the maximum number of threads used to create LLVM modules
+     * from the source files.
+     *
+     * @return the maximum number of simultaneous compilation jobs
+     */
+    inline size_t getMaxParallelJobs() const {
+        return _maxJobs;
+    }
+
+    /**
+     * Defines the maximum number of threads used to create LLVM modules
+     * from the source files (each thread uses its own LLVM context).
+     * The default is the number of concurrent threads supported by the
+     * hardware.
+     *
+     * @param maxJobs the maximum number of simultaneous compilation jobs
+     *                (a value of 1 compiles one source file at a time)
+     */
+    inline void setMaxParallelJobs(size_t maxJobs) {
+        _maxJobs = std::max<size_t>(1, maxJobs);
+    }
+
+    /**
+     * Provides the cache of JIT compiled object code.
+     *
+     * @return the object cache or nullptr if no cache is used
+     */
+    inline LlvmObjectCache* getObjectCache() const {
+        return _objectCache;
+    }
+
+    /**
+     * Defines a cache for the object code emitted by the JIT.
+     * When the object code of a library built from the same sources with
+     * the same options is found in the cache, no LLVM module is created
+     * and the cached machine code is used directly.
+     *
+     * @param objectCache the object cache (it must exist while it is used
+     *                    by this object or by the created libraries)
+     */
+    inline void setObjectCache(LlvmObjectCache& objectCache) {
+        _objectCache = &objectCache;
+    }
+
+    /**
+     * Stops using a cache of JIT compiled object code
+     */
+    inline void removeObjectCache() {
+        _objectCache = nullptr;
+    }
+
     /**
      *
      * @return a model library
@@ -81,21 +154,36 @@ public:
 
         _context.reset(new llvm::LLVMContext());
 
-        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
-        for (const auto& p : models) {
-            const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-            createLlvmModules(modelSources);
+        std::string cacheKey;
+        if (_objectCache != nullptr && !_jitOptions.isLazyCompilation()) {
+            cacheKey = createCacheKey("");
         }
 
-        const std::map<std::string, std::string>& sources = this->getLibrarySources();
-        createLlvmModules(sources);
+        if (!cacheKey.empty() && _objectCache->contains(cacheKey)) {
+            // the machine code is loaded from the cache
+            _module.reset(new llvm::Module(LlvmObjectCache::createModuleIdentifier(cacheKey), *_context));
+        } else {
+            std::vector<const std::map<std::string, std::string>*> sources;
+
+            const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+            for (const auto& p : models) {
+                sources.push_back(&this->getSources(*p.second));
+            }
+
+            sources.push_back(&this->getLibrarySources());
 
-        const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-        createLlvmModules(customSource);
+            sources.push_back(&this->modelLibraryHelper_->getCustomSources());
+
+            createLlvmModules(sources);
+
+            if (!cacheKey.empty()) {
+                _module->setModuleIdentifier(LlvmObjectCache::createModuleIdentifier(cacheKey));
+            }
+        }
 
         llvm::InitializeNativeTarget();
 
-        std::unique_ptr<LlvmModelLibrary<Base>> lib(new LlvmModelLibraryImpl<Base>(std::move(_module), _context));
+        std::unique_ptr<LlvmModelLibrary<Base>> lib = createLibrary(std::move(_module));
 
         this->modelLibraryHelper_->finishedJob();
 
@@ -122,6 +210,31 @@ public:
         this->modelLibraryHelper_->startingJob("", JobTimer::JIT_MODEL_LIBRARY);
 
         try {
+            std::string cacheKey;
+            if (_objectCache != nullptr && !_jitOptions.isLazyCompilation()) {
+                cacheKey = createCacheKey(clang.getConfigurationDescription());
+            }
+
+            if (!cacheKey.empty() && _objectCache->contains(cacheKey)) {
+                /**
+                 * the machine code is loaded from the cache
+                 */
+                llvm::InitializeAllTargets();
+                llvm::InitializeAllAsmPrinters();
+
+                _context.reset(new llvm::LLVMContext());
+
+                std::unique_ptr<Module> module(new llvm::Module(LlvmObjectCache::createModuleIdentifier(cacheKey), *_context));
+
+                llvm::InitializeNativeTarget();
+
+                lib = createLibrary(std::move(module));
+
+                this->modelLibraryHelper_->finishedJob();
+
+                return lib;
+            }
+
             /**
              * generate bit code
              */
@@ -169,10 +282,14 @@ public:
                 }
             }
 
+            if (!cacheKey.empty()) {
+                linkerModule->setModuleIdentifier(LlvmObjectCache::createModuleIdentifier(cacheKey));
+            }
+
             llvm::InitializeNativeTarget();
 
             // voila
-            lib.reset(new LlvmModelLibraryImpl<Base>(std::move(linkerModule), _context));
+            lib = createLibrary(std::move(linkerModule));
 
         } catch (...) {
             clang.cleanup();
@@ -187,14 +304,204 @@ public:
 
 protected:
 
+    /**
+     * Creates the model library which JIT compiles a module.
+     *
+     * @param module the module with all the functions of the library
+     */
+    virtual std::unique_ptr<LlvmModelLibrary<Base>> createLibrary(std::unique_ptr<llvm::Module> module) {
+        std::unique_ptr<LlvmModelLibrary<Base>> lib;
+        if (_jitOptions.isLazyCompilation()) {
+            lib.reset(new LlvmLazyModelLibraryImpl<Base>(std::move(module), _context, _jitOptions));
+        } else {
+            lib.reset(new LlvmModelLibraryImpl<Base>(std::move(module), _context, _jitOptions, _objectCache));
+        }
+        return lib;
+    }
+
+    /**
+     * Determines the key which identifies the object code of the library
+     * in the object cache, using the generated sources and all the options
+     * which affect the emitted machine code.
+     *
+     * @param compilerDescription the configuration of an external compiler
+     *                            used to generate the bitcode (if any)
+     */
+    virtual std::string createCacheKey(const std::string& compilerDescription) {
+        std::vector<const std::map<std::string, std::string>*> sources;
+
+        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+        for (const auto& p : models) {
+            sources.push_back(&this->getSources(*p.second));
+        }
+        sources.push_back(&this->getLibrarySources());
+        sources.push_back(&this->modelLibraryHelper_->getCustomSources());
+
+        std::ostringstream d;
+        d << "llvm: " << _version << " (" << LLVM_VERSION_STRING << ")\n"
+          << "target: " << llvm::sys::getProcessTriple() << "\n"
+          << "optimization: " << _jitOptions.getOptimizationLevel()
+          << " module: " << _jitOptions.isModuleOptimizations()
+          << " vectorize: " << _jitOptions.isVectorize() << "\n";
+
+        if (_jitOptions.isHostCpu()) {
+            d << "cpu: " << llvm::sys::getHostCPUName().str() << "\n";
+
+            llvm::StringMap<bool> features;
+            if (llvm::sys::getHostCPUFeatures(features)) {
+                std::set<std::string> enabled; // sorted
+                for (const auto& f : features) {
+                    if (f.second)
+                        enabled.insert(f.first().str());
+                }
+                for (const std::string& f : enabled)
+                    d << "+" << f;
+                d << "\n";
+            }
+        }
+
+        for (const std::string& p : _includePaths)
+            d << "include: " << p << "\n";
+
+        d << compilerDescription;
+
+        return DynamicLibraryCache::createKey(sources, d.str());
+    }
+
     virtual void createLlvmModules(const std::map<std::string, std::string>& sources) {
         for (const auto& p : sources) {
             createLlvmModule(p.first, p.second);
         }
     }
 
+    /**
+     * Creates LLVM modules for all the source files and links them into a
+     * single module.
+     * Source files are compiled concurrently by up to getMaxParallelJobs()
+     * threads, each one with its own LLVM context.
+     * The modules created by each thread are linked together and
+     * transferred to the main context as bitcode.
+     *
+     * @param sources the source files (names and contents)
+     */
+    virtual void createLlvmModules(const std::vector<const std::map<std::string, std::string>*>& sources) {
+        std::vector<const std::pair<const std::string, std::string>*> files;
+        for (const auto* s : sources) {
+            for (const auto& p : *s) {
+                files.push_back(&p);
+            }
+        }
+
+        size_t nThreads = std::min(_maxJobs, files.size());
+        if (nThreads <= 1) {
+            for (const auto* f : files) {
+                createLlvmModule(f->first, f->second);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::vector<std::string> bitcode(nThreads);
+        std::vector<std::exception_ptr> errors(nThreads);
+
+        auto compile = [&](size_t t) {
+            try {
+                // the declaration order defines the destruction order
+                llvm::LLVMContext context;
+                std::unique_ptr<llvm::Module> module;
+                std::unique_ptr<llvm::Linker> linker;
+
+                for (size_t i = next++; i < files.size(); i = next++) {
+                    std::unique_ptr<llvm::Module> m = parseLlvmModule(files[i]->second, context);
+                    if (linker.get() == nullptr) {
+                        module = std::move(m);
+                        linker.reset(new llvm::Linker(*module));
+                    } else if (linker->linkInModule(std::move(m))) {
+                        throw CGException("LLVM failed to link module");
+                    }
+                }
+
+                if (module.get() != nullptr) {
+                    llvm::raw_string_ostream os(bitcode[t]);
+                    llvm::WriteBitcodeToFile(module.get(), os);
+                    os.flush();
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1);
+        for (size_t t = 1; t < nThreads; ++t) {
+            threads.emplace_back(compile, t);
+        }
+        compile(0);
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        for (const std::exception_ptr& e : errors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+        /**
+         * load the bitcode into the main context
+         */
+        for (size_t t = 0; t < nThreads; ++t) {
+            if (bitcode[t].empty())
+                continue;
+
+            llvm::MemoryBufferRef buffer(bitcode[t], "thread_" + std::to_string(t));
+            llvm::Expected<std::unique_ptr<llvm::Module>> moduleOrError = llvm::parseBitcodeFile(buffer, *_context.get());
+            if (!moduleOrError) {
+                std::ostringstream error;
+                size_t nError = 0;
+                llvm::handleAllErrors(moduleOrError.takeError(), [&](llvm::ErrorInfoBase& eib) {
+                    if (nError > 0) error << "; ";
+                    error << eib.message();
+                    nError++;
+                });
+                throw CGException(error.str());
+            }
+
+            linkLlvmModule(std::move(moduleOrError.get()));
+        }
+    }
+
     virtual void createLlvmModule(const std::string& filename,
                                   const std::string& source) {
+        linkLlvmModule(parseLlvmModule(source, *_context.get()));
+    }
+
+    /**
+     * Links a module into the module of the library.
+     *
+     * @param module a module in the main LLVM context
+     */
+    virtual void linkLlvmModule(std::unique_ptr<llvm::Module> module) {
+        if (_linker.get() == nullptr) {
+            _module.reset(module.release());
+            _linker.reset(new llvm::Linker(*_module.get()));
+        } else {
+            if (_linker->linkInModule(std::move(module))) {
+                throw CGException("LLVM failed to link module");
+            }
+        }
+    }
+
+    /**
+     * Creates a LLVM module from a C source file.
+     * It can be called simultaneously from several threads as long as
+     * different LLVM contexts are used.
+     *
+     * @param source the source file content
+     * @param context the LLVM context of the new module
+     * @return the new module
+     */
+    virtual std::unique_ptr<llvm::Module> parseLlvmModule(const std::string& source,
+                                                          llvm::LLVMContext& context) {
         using namespace llvm;
         using namespace clang;
 
@@ -248,7 +555,7 @@ protected:
             hso.AddPath(llvm::StringRef(_includePaths[s]), clang::frontend::Angled, false, false);
 
         // Create and execute the frontend to generate an LLVM bitcode module.
-        clang::EmitLLVMOnlyAction action(_context.get());
+        clang::EmitLLVMOnlyAction action(&context);
         if (!compiler.ExecuteAction(action))
             throw CGException("Failed to emit LLVM bitcode");
 
@@ -256,18 +563,10 @@ protected:
         if (module.get() == nullptr)
             throw CGException("No module");
 
-        if (_linker.get() == nullptr) {
-            _module.reset(module.release());
-            _linker.reset(new llvm::Linker(*_module.get()));
-        } else {
-            if (_linker->linkInModule(std::move(module))) {
-                throw CGException("LLVM failed to link module");
-            }
-        }
-
-        // NO delete module;
         // NO delete invocation;
         //llvm::llvm_shutdown();
+
+        return module;
     }
 
 };
@@ -0,0 +1,201 @@
+#ifndef CPPAD_CG_LLVM_LAZY_MODEL_LIBRARY_IMPL_INCLUDED
+#define CPPAD_CG_LLVM_LAZY_MODEL_LIBRARY_IMPL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base> class LlvmModel;
+
+/**
+ * Class used to load models JIT'ed lazily by LLVM 5.0 and 6.0 (ORC).
+ *
+ * Each function is only optimized and compiled into machine code when it
+ * is called for the first time (loading a function only provides the
+ * address of a compile-on-demand stub).
+ * This reduces the time to the first evaluation when only a few of the
+ * generated functions are used.
+ *
+ * Module-level optimizations are not performed since each function is
+ * compiled separately.
+ * The compilation of functions is not thread-safe, therefore the thread
+ * pool is disabled by default: it should only be enabled after all the
+ * required functions were called at least once.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LlvmLazyModelLibraryImpl : public LlvmModelLibrary<Base> {
+protected:
+    using ObjectLayer = llvm::orc::RTDyldObjectLinkingLayer;
+    using CompileLayer = llvm::orc::IRCompileLayer<ObjectLayer, llvm::orc::SimpleCompiler>;
+    using OptimizeFunction = std::function<std::shared_ptr<llvm::Module>(std::shared_ptr<llvm::Module>)>;
+    using OptimizeLayer = llvm::orc::IRTransformLayer<CompileLayer, OptimizeFunction>;
+    using CompileOnDemandLayer = llvm::orc::CompileOnDemandLayer<OptimizeLayer>;
+protected:
+    std::shared_ptr<llvm::LLVMContext> _context; // must be deleted after all the layers (it must come first)
+    LlvmJitOptions _options;
+    std::unique_ptr<llvm::TargetMachine> _targetMachine;
+    const llvm::DataLayout _dataLayout;
+    ObjectLayer _objectLayer;
+    CompileLayer _compileLayer;
+    OptimizeLayer _optimizeLayer;
+    std::unique_ptr<llvm::orc::JITCompileCallbackManager> _callbackManager;
+    std::unique_ptr<CompileOnDemandLayer> _codLayer;
+public:
+
+    LlvmLazyModelLibraryImpl(std::unique_ptr<llvm::Module> module,
+                             std::shared_ptr<llvm::LLVMContext> context,
+                             const LlvmJitOptions& options = LlvmJitOptions()) :
+        _context(context),
+        _options(options),
+        _targetMachine(createTargetMachine(options)),
+        _dataLayout(_targetMachine->createDataLayout()),
+        _objectLayer([]() { return std::make_shared<llvm::SectionMemoryManager>(); }),
+        _compileLayer(_objectLayer, llvm::orc::SimpleCompiler(*_targetMachine)),
+        _optimizeLayer(_compileLayer, [this](std::shared_ptr<llvm::Module> m) {
+            return optimizeModule(std::move(m));
+        }) {
+        using namespace llvm;
+
+        const Triple& triple = _targetMachine->getTargetTriple();
+
+        _callbackManager = orc::createLocalCompileCallbackManager(triple, 0);
+        if (_callbackManager.get() == nullptr) {
+            throw CGException("Lazy JIT compilation is not supported for the target '", triple.str(), "'");
+        }
+
+        _codLayer.reset(new CompileOnDemandLayer(_optimizeLayer,
+                                                 [](Function& f) {
+                                                     return std::set<Function*>({&f});
+                                                 },
+                                                 *_callbackManager,
+                                                 orc::createLocalIndirectStubsManagerBuilder(triple)));
+
+        // symbols from the host process (e.g. the math library)
+        sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+
+        module->setDataLayout(_dataLayout);
+
+        auto resolver = orc::createLambdaResolver(
+                [this](const std::string& name) {
+                    if (auto sym = _codLayer->findSymbol(name, false))
+                        return sym;
+                    return JITSymbol(nullptr);
+                },
+                [](const std::string& name) {
+                    if (auto addr = RTDyldMemoryManager::getSymbolAddressInProcess(name))
+                        return JITSymbol(addr, JITSymbolFlags::Exported);
+                    return JITSymbol(nullptr);
+                });
+
+        auto handle = _codLayer->addModule(std::shared_ptr<Module>(std::move(module)), std::move(resolver));
+        if (!handle) {
+            throw CGException("Failed to add module to the JIT: ", toString(handle.takeError()));
+        }
+
+        /**
+         *
+         */
+        this->validate();
+
+        this->setThreadPoolDisabled(true);
+    }
+
+    LlvmLazyModelLibraryImpl(const LlvmLazyModelLibraryImpl&) = delete;
+    LlvmLazyModelLibraryImpl& operator=(const LlvmLazyModelLibraryImpl&) = delete;
+
+    inline virtual ~LlvmLazyModelLibraryImpl() {
+        this->cleanUp();
+    }
+
+    /**
+     * Provides the options used to optimize and JIT compile the functions
+     */
+    inline const LlvmJitOptions& getOptions() const {
+        return _options;
+    }
+
+    void* loadFunction(const std::string& functionName, bool required = true) override {
+        std::string mangledName;
+        llvm::raw_string_ostream os(mangledName);
+        llvm::Mangler::getNameWithPrefix(os, functionName, _dataLayout);
+        os.flush();
+
+        // provides a stub which compiles the function when it is first called
+        llvm::JITSymbol symbol = _codLayer->findSymbol(mangledName, true);
+        if (!symbol) {
+            if (required)
+                throw CGException("Unable to find function '", functionName, "' in LLVM module");
+            return nullptr;
+        }
+
+        llvm::Expected<llvm::JITTargetAddress> address = symbol.getAddress();
+        if (!address) {
+            throw CGException("Unable to determine the address of function '", functionName, "': ",
+                              llvm::toString(address.takeError()));
+        }
+
+        return (void*) *address;
+    }
+
+protected:
+
+    /**
+     * Optimizes a module which contains a single function (called just
+     * before it is compiled)
+     */
+    virtual std::shared_ptr<llvm::Module> optimizeModule(std::shared_ptr<llvm::Module> module) {
+        llvm::legacy::FunctionPassManager fpm(module.get());
+        fpm.add(llvm::createTargetTransformInfoWrapperPass(_targetMachine->getTargetIRAnalysis()));
+
+        llvm::PassManagerBuilder builder;
+        builder.OptLevel = _options.getOptimizationLevel();
+        builder.SizeLevel = 0;
+        _targetMachine->adjustPassManager(builder);
+        builder.populateFunctionPassManager(fpm);
+
+        fpm.doInitialization();
+        for (llvm::Function& f : *module) {
+            if (!f.isDeclaration())
+                fpm.run(f);
+        }
+        fpm.doFinalization();
+
+        return module;
+    }
+
+    static inline llvm::TargetMachine* createTargetMachine(const LlvmJitOptions& options) {
+        using namespace llvm;
+
+        EngineBuilder engineBuilder;
+        LlvmModelLibraryImpl<Base>::prepareEngineBuilder(engineBuilder, options);
+
+        TargetMachine* tm = engineBuilder.selectTarget();
+        if (tm == nullptr) {
+            throw CGException("Failed to create the target machine for the JIT");
+        }
+        return tm;
+    }
+
+    friend class LlvmModel<Base>;
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -33,34 +33,63 @@ protected:
     std::shared_ptr<llvm::LLVMContext> _context;
     std::unique_ptr<llvm::ExecutionEngine> _executionEngine;
     std::unique_ptr<llvm::legacy::FunctionPassManager> _fpm;
+    LlvmJitOptions _options;
+    bool _precompiled; // whether or not the machine code was loaded from a cache
+    bool _optimized; // whether or not all functions in the module were already optimized
 public:
 
     LlvmModelLibraryImpl(std::unique_ptr<llvm::Module> module,
-                         std::shared_ptr<llvm::LLVMContext> context) :
+                         std::shared_ptr<llvm::LLVMContext> context,
+                         const LlvmJitOptions& options = LlvmJitOptions(),
+                         LlvmObjectCache* objectCache = nullptr) :
         _module(module.get()),
-        _context(context) {
+        _context(context),
+        _options(options),
+        _precompiled(false),
+        _optimized(false) {
         using namespace llvm;
 
-        // Create the JIT.  This takes ownership of the module.
+        EngineBuilder engineBuilder(std::move(module));
         std::string errStr;
-        _executionEngine.reset(EngineBuilder(std::move(module))
-                               .setErrorStr(&errStr)
-                               .setEngineKind(EngineKind::JIT)
+        engineBuilder.setErrorStr(&errStr)
+                .setEngineKind(EngineKind::JIT)
 #ifndef NDEBUG
                 .setVerifyModules(true)
 #endif
-                // .setMCJITMemoryManager(llvm::make_unique<llvm::SectionMemoryManager>())
-                               .create());
+                ;
+        // .setMCJITMemoryManager(llvm::make_unique<llvm::SectionMemoryManager>())
+
+        prepareEngineBuilder(engineBuilder, options);
+
+        // Create the JIT.  This takes ownership of the module.
+        _executionEngine.reset(engineBuilder.create());
         if (!_executionEngine.get()) {
             throw CGException("Could not create ExecutionEngine: ", errStr);
         }
 
+        if (objectCache != nullptr) {
+            _executionEngine->setObjectCache(objectCache);
+
+            std::string key = LlvmObjectCache::getKey(*_module);
+            _precompiled = _module->empty() && !key.empty() && objectCache->contains(key);
+        }
+
         _fpm.reset(new llvm::legacy::FunctionPassManager(_module));
 
         preparePassManager();
 
         _fpm->doInitialization();
 
+        if (_precompiled) {
+            // load the cached object code
+            _executionEngine->finalizeObject();
+        } else if (options.isModuleOptimizations()) {
+            optimizeModule();
+        } else if (objectCache != nullptr) {
+            // the cached object code must contain all functions optimized
+            optimizeFunctions();
+        }
+
         /**
          *
          */
@@ -74,17 +103,127 @@ public:
         this->cleanUp();
     }
 
+    /**
+     * Provides the options used to optimize and JIT compile the module
+     */
+    inline const LlvmJitOptions& getOptions() const {
+        return _options;
+    }
+
     /**
      * Set up the optimizer pipeline
      */
     virtual void preparePassManager() {
         llvm::PassManagerBuilder builder;
-        builder.OptLevel = 2;
+        preparePassManagerBuilder(builder);
+
+        _fpm->add(llvm::createTargetTransformInfoWrapperPass(_executionEngine->getTargetMachine()->getTargetIRAnalysis()));
         builder.populateFunctionPassManager(*_fpm);
         //_fpm.add(new DataLayoutPass());
     }
 
+protected:
+
+    /**
+     * Defines the optimizations used by the pass managers
+     */
+    virtual void preparePassManagerBuilder(llvm::PassManagerBuilder& builder) {
+        builder.OptLevel = _options.getOptimizationLevel();
+        builder.SizeLevel = 0;
+        if (_options.isModuleOptimizations() && _options.getOptimizationLevel() > 0) {
+            builder.Inliner = llvm::createFunctionInliningPass(builder.OptLevel, builder.SizeLevel, false);
+        }
+        builder.LoopVectorize = _options.isVectorize();
+        builder.SLPVectorize = _options.isVectorize();
+
+        _executionEngine->getTargetMachine()->adjustPassManager(builder);
+    }
+
+    /**
+     * Optimizes all the functions in the module together (all functions
+     * must be optimized before the first one is JIT compiled).
+     */
+    virtual void optimizeModule() {
+        llvm::TargetMachine* tm = _executionEngine->getTargetMachine();
+
+        llvm::legacy::PassManager mpm;
+        mpm.add(llvm::createTargetTransformInfoWrapperPass(tm->getTargetIRAnalysis()));
+
+        llvm::PassManagerBuilder builder;
+        preparePassManagerBuilder(builder);
+        builder.populateModulePassManager(mpm);
+
+        optimizeFunctions();
+
+        mpm.run(*_module);
+    }
+
+    /**
+     * Runs the function-level optimizations on all functions in the module.
+     */
+    virtual void optimizeFunctions() {
+        for (llvm::Function& f : *_module) {
+            if (!f.isDeclaration())
+                _fpm->run(f);
+        }
+        _fpm->doFinalization();
+
+        _optimized = true;
+    }
+
+public:
+
+    /**
+     * Defines the code generation options of an execution engine (or of
+     * its target machine).
+     */
+    static inline void prepareEngineBuilder(llvm::EngineBuilder& engineBuilder,
+                                            const LlvmJitOptions& options) {
+        using namespace llvm;
+
+        engineBuilder.setOptLevel(codeGenOptLevel(options.getOptimizationLevel()));
+
+        if (options.isHostCpu()) {
+            engineBuilder.setMCPU(sys::getHostCPUName());
+
+            std::vector<std::string> attrs;
+            StringMap<bool> features;
+            if (sys::getHostCPUFeatures(features)) {
+                for (const auto& f : features) {
+                    attrs.push_back((f.second ? "+" : "-") + f.first().str());
+                }
+            }
+            engineBuilder.setMAttrs(attrs);
+        }
+    }
+
+protected:
+
+    static inline llvm::CodeGenOpt::Level codeGenOptLevel(unsigned int optLevel) {
+        switch (optLevel) {
+            case 0:
+                return llvm::CodeGenOpt::None;
+            case 1:
+                return llvm::CodeGenOpt::Less;
+            case 2:
+                return llvm::CodeGenOpt::Default;
+            default:
+                return llvm::CodeGenOpt::Aggressive;
+        }
+    }
+
+public:
+
     void* loadFunction(const std::string& functionName, bool required = true) override {
+        if (_precompiled) {
+            // there is no IR, only the machine code loaded from the cache
+            uint64_t fPtr = _executionEngine->getFunctionAddress(functionName);
+            if (fPtr == 0 && required) {
+                throw CGException("Unable to find function '", functionName, "' in the cached object code");
+            }
+            return (void*) fPtr;
+        }
+
         llvm::Function* func = _module->getFunction(functionName);
         if (func == nullptr) {
             if (required)
@@ -100,8 +239,9 @@ public:
             throw CGException("Function '", functionName, "' verification failed");
 #endif
 
-        // Optimize the function.
-        _fpm->run(*func);
+        // Optimize the function (unless all functions were already optimized)
+        if (!_optimized)
+            _fpm->run(*func);
 
         // JIT the function, returning a function pointer.
         uint64_t fPtr = _executionEngine->getFunctionAddress(functionName);
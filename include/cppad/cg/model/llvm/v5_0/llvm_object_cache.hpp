@@ -0,0 +1,160 @@
+#ifndef CPPAD_CG_LLVM_OBJECT_CACHE_INCLUDED
+#define CPPAD_CG_LLVM_OBJECT_CACHE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Persists the machine code emitted by the LLVM JIT on disk (LLVM 5.0 and
+ * 6.0).
+ *
+ * Only modules whose identifier was created with createModuleIdentifier()
+ * are cached.
+ * The key in the identifier is determined from the generated source files
+ * and from the JIT configuration by the model library processor, which
+ * allows it to skip the creation of the LLVM module altogether when the
+ * object code is already in the cache.
+ *
+ * @author Joao Leal
+ */
+class LlvmObjectCache : public llvm::ObjectCache {
+protected:
+    /// the folder where object files are saved
+    std::string _folder;
+public:
+
+    /**
+     * Creates a new object cache.
+     *
+     * @param folder the folder where object files are saved (it is created
+     *               if it does not exist)
+     */
+    inline explicit LlvmObjectCache(const std::string& folder) :
+        _folder(folder) {
+        CPPADCG_ASSERT_KNOWN(!folder.empty(), "Cache folder cannot be empty")
+    }
+
+    LlvmObjectCache(const LlvmObjectCache&) = delete;
+    LlvmObjectCache& operator=(const LlvmObjectCache&) = delete;
+
+    virtual ~LlvmObjectCache() = default;
+
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    /**
+     * Provides the path of the object file for a key.
+     */
+    inline std::string getObjectPath(const std::string& key) const {
+        return system::createPath(_folder, modulePrefix() + key + ".o");
+    }
+
+    /**
+     * Determines whether or not the object code for a key is in the cache.
+     */
+    inline bool contains(const std::string& key) const {
+        return system::isFile(getObjectPath(key));
+    }
+
+    /**
+     * Removes all object files from the cache.
+     */
+    inline void clear() {
+        if (!system::isDirectory(_folder))
+            return;
+
+        for (const std::string& name : system::listFiles(_folder)) {
+            if (name.compare(0, modulePrefix().size(), modulePrefix()) == 0) {
+                std::remove(system::createPath(_folder, name).c_str());
+            }
+        }
+    }
+
+    void notifyObjectCompiled(const llvm::Module* module,
+                              llvm::MemoryBufferRef obj) override {
+        std::string key = getKey(*module);
+        if (key.empty())
+            return;
+
+        system::createFolder(_folder);
+
+        std::string path = getObjectPath(key);
+
+        std::random_device rd;
+        std::string tmpPath = path + ".tmp" + std::to_string(rd());
+
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(obj.getBufferStart(), obj.getBufferSize());
+        out.close();
+
+        // failing to save an object file is not an error (it is only slower)
+        if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+            std::remove(tmpPath.c_str());
+        }
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override {
+        std::string key = getKey(*module);
+        if (key.empty())
+            return nullptr;
+
+        std::string path = getObjectPath(key);
+        if (!system::isFile(path))
+            return nullptr;
+
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+        if (!buffer)
+            return nullptr;
+
+        return std::move(buffer.get());
+    }
+
+    /**
+     * Creates the identifier of a module which should be cached.
+     *
+     * @param key the key which identifies the module contents
+     */
+    static inline std::string createModuleIdentifier(const std::string& key) {
+        return modulePrefix() + key;
+    }
+
+    /**
+     * Provides the key of a module which should be cached.
+     *
+     * @return the key or an empty string if the module should not be cached
+     */
+    static inline std::string getKey(const llvm::Module& module) {
+        const std::string& id = module.getModuleIdentifier();
+        if (id.compare(0, modulePrefix().size(), modulePrefix()) != 0)
+            return "";
+        return id.substr(modulePrefix().size());
+    }
+
+protected:
+
+    static inline const std::string& modulePrefix() {
+        static const std::string prefix = "cppadcg_jit_";
+        return prefix;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -42,12 +42,14 @@ class ModelCSourceGen {
     using TapeVarType = std::pair<size_t, size_t>; // tape independent -> reference orig independent (temporaries only)
 public:
     static const std::string FUNCTION_FORWAD_ZERO;
+    static const std::string FUNCTION_FORWARD_ZERO_BATCH;
     static const std::string FUNCTION_JACOBIAN;
     static const std::string FUNCTION_HESSIAN;
     static const std::string FUNCTION_FORWARD_ONE;
     static const std::string FUNCTION_REVERSE_ONE;
     static const std::string FUNCTION_REVERSE_TWO;
     static const std::string FUNCTION_SPARSE_JACOBIAN;
+    static const std::string FUNCTION_SPARSE_JACOBIAN_BATCH;
     static const std::string FUNCTION_SPARSE_HESSIAN;
     static const std::string FUNCTION_JACOBIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY;
@@ -58,6 +60,9 @@ public:
     static const std::string FUNCTION_FORWARD_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
+    static const std::string FUNCTION_SPARSE_FORWARD_ONE_SHARED;
+    static const std::string FUNCTION_SPARSE_REVERSE_ONE_SHARED;
+    static const std::string FUNCTION_SPARSE_REVERSE_TWO_SHARED;
     static const std::string FUNCTION_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
 protected:
@@ -113,13 +118,39 @@ protected:
          * Calculated sparsity from the model
          * (may differ from the requested sparsity)
          */
-        SparsitySetType sparsity;
+        SparsityPattern sparsity;
         // rows (in a custom order)
         std::vector<size_t> rows;
         // columns (in a custom order)
         std::vector<size_t> cols;
     };
 
+    /**
+     * The operations of a directional function (e.g. a column of the
+     * Jacobian for the forward mode) whose source code is yet to be
+     * generated
+     */
+    class DirectionalFunction {
+    public:
+        // the code handler with the operations (it can be shared with other directions)
+        CodeHandler<Base>* handler;
+        // the values computed by the function
+        std::vector<CGBase> dependents;
+        // the function name
+        std::string name;
+        // the name of the job for the job timer
+        std::string jobName;
+    };
+
+    /**
+     * Generates the source code of a directional function with the
+     * provided language (which already has the function name and where to
+     * save the sources)
+     */
+    using DirectionalCodeGenerator = std::function<void(DirectionalFunction& function,
+                                                        LanguageC<Base>& langC,
+                                                        std::vector<std::string>& atomicFunctions)>;
+
     /**
      * Used for coloring
      */
@@ -174,6 +205,11 @@ protected:
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
+    /**
+     * generate source code for the evaluation of multiple points (batch)
+     * with the zero order model and the sparse Jacobian
+     */
+    bool _batch;
     /// generate source code for a dense Jacobian
     bool _jacobian;
     /// generate source code for a dense Hessian
@@ -203,6 +239,28 @@ protected:
      * functions when _sparseHessian is true
      */
     bool _sparseHessianReusesRev2;
+    /**
+     * whether or not the values which do not depend on the direction are
+     * computed only once for all the sparse forward one, reverse one, and
+     * reverse two functions
+     */
+    bool _shareZeroOrderSweep;
+    /**
+     * the number of values shared by the directional functions of each
+     * sparse first/second order mode (missing if there are none)
+     */
+    std::map<std::string, size_t> _sharedValuesSize;
+    /**
+     * the maximum number of threads used to generate the source code of
+     * the directional functions
+     */
+    size_t _maxParallelJobs;
+    /**
+     * the maximum number of tasks into which the zero order forward and
+     * the dense Jacobian functions are split so that they can be evaluated
+     * by several threads (0 or 1 disables it)
+     */
+    size_t _parallelTasks;
     JacobianADMode _jacMode;
     /**
      * Custom Jacobian element indexes
@@ -222,6 +280,11 @@ protected:
      * The order of the atomic functions
      */
     std::vector<std::string> _atomicFunctions;
+    /**
+     * Atomic functions called directly in the generated source code
+     * (atomic function name -> C function name prefix)
+     */
+    std::map<std::string, std::string> _directAtomicFunctions;
     /**
      * Maps each atomic function ID to information regarding how the atomic function is used
      */
@@ -238,6 +301,21 @@ protected:
      * the maximum number of operations per variable assignment
      */
     size_t _maxOperationsPerAssignment;
+    /**
+     * whether or not to merge identical operations before generating
+     * source code
+     */
+    bool _eliminateCommonSubexpressions;
+    /**
+     * whether or not to replace expensive operations with cheaper
+     * equivalent ones before generating source code
+     */
+    bool _reduceOperationStrength;
+    /**
+     * whether or not the strength reduction must preserve the results of
+     * the original operations
+     */
+    bool _strictFloatingPoint;
     /**
      *
      */
@@ -280,6 +358,16 @@ protected:
      * Generated source code (maps file names to content)
      */
     std::map<std::string, std::string> _sources;
+    /**
+     * receives the generated source files as soon as they are complete
+     * (only defined while the sources are being streamed)
+     */
+    SourceFileSink* _sourceSink;
+    /**
+     * whether or not the source files were provided to a sink instead of
+     * being kept in _sources
+     */
+    bool _sourcesStreamed;
 public:
 
     /**
@@ -299,6 +387,7 @@ public:
         _multiThreading(true),
         _zero(true),
         _zeroEvaluated(false),
+        _batch(false),
         _jacobian(false),
         _hessian(false),
         _sparseJacobian(false),
@@ -309,11 +398,19 @@ public:
         _reverseTwo(false),
         _sparseJacobianReusesOne(true),
         _sparseHessianReusesRev2(true),
+        _shareZeroOrderSweep(false),
+        _maxParallelJobs(1),
+        _parallelTasks(0),
         _jacMode(JacobianADMode::Automatic),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
-        _jobTimer(nullptr) {
+        _eliminateCommonSubexpressions(false),
+        _reduceOperationStrength(false),
+        _strictFloatingPoint(true),
+        _jobTimer(nullptr),
+        _sourceSink(nullptr),
+        _sourcesStreamed(false) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty");
         CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
@@ -387,6 +484,33 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Provides the atomic functions which are called directly in the
+     * generated source code instead of through the atomic function
+     * callbacks of the model library.
+     *
+     * @return maps atomic function names to C function name prefixes
+     */
+    inline const std::map<std::string, std::string>& getDirectAtomicFunctions() const {
+        return _directAtomicFunctions;
+    }
+
+    /**
+     * Defines atomic functions which should be called directly in the
+     * generated source code instead of through the atomic function
+     * callbacks of the model library.
+     * The C functions <prefix>_forward and <prefix>_reverse must be
+     * provided by another source file compiled into the same library
+     * (see LanguageC::setDirectAtomicFunctions()).
+     * This is typically defined by ModelLibraryCSourceGen.
+     *
+     * @param functions maps atomic function names to C function name
+     *                  prefixes
+     */
+    inline void setDirectAtomicFunctions(const std::map<std::string, std::string>& functions) {
+        _directAtomicFunctions = functions;
+    }
+
     /**
      * Returns whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
@@ -428,6 +552,10 @@ public:
         return _multiThreading && _loopTapes.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
     }
 
+    inline bool isParallelTasksEnabled() const {
+        return _multiThreading && _parallelTasks > 1 && _loopTapes.empty() && (_zero || _jacobian);
+    }
+
     /**
      * Determines whether or not to generate source-code for a function
      * that evaluates a dense Hessian.
@@ -655,6 +783,106 @@ public:
         _sparseJacobianReusesOne = reuse;
     }
 
+    /**
+     * Determines whether or not the values which do not depend on the
+     * direction are computed only once for all the functions created for
+     * the sparse forward one, reverse one, and reverse two modes.
+     *
+     * @return true if the directional functions use shared values
+     */
+    inline bool isShareZeroOrderSweep() const {
+        return _shareZeroOrderSweep;
+    }
+
+    /**
+     * Defines whether or not the values which do not depend on the
+     * direction (e.g. the zero order values of the nonlinear operations)
+     * should be computed only once for all the functions created for the
+     * sparse forward one, reverse one, and reverse two modes.
+     * Operations used by several directions are moved into a new function
+     * (model_sparse_forward_one_shared, ...) which saves their values in an
+     * array.
+     * The size of this array is provided by a function with the suffix
+     * "_size".
+     * The directional functions then require this array as an additional
+     * input (after the other input arrays).
+     * The sparse Jacobian, sparse Hessian, and the dense first and second
+     * order functions evaluate the shared values once for all directions.
+     *
+     * It is only used for models without atomic functions and loops.
+     *
+     * @param share true if the directional functions should use shared
+     *              values
+     */
+    inline void setShareZeroOrderSweep(bool share) {
+        _shareZeroOrderSweep = share;
+    }
+
+    /**
+     * Provides the maximum number of threads used to generate the source
+     * code of the functions created for the sparse forward one, reverse
+     * one, and reverse two modes.
+     *
+     * @return the maximum number of simultaneous source generation jobs
+     */
+    inline size_t getMaxParallelJobs() const {
+        return _maxParallelJobs;
+    }
+
+    /**
+     * Defines the maximum number of threads used to generate the source
+     * code of the functions created for the sparse forward one, reverse
+     * one, and reverse two modes (one function per direction).
+     * The CppAD tapes are still recorded by the calling thread, only the
+     * source code generation from the operation graphs is performed
+     * simultaneously.
+     * Models without atomic functions record the directions in groups (one
+     * per thread) which increases the memory usage. They are not split
+     * when the values of the zero order sweep are shared (see
+     * setShareZeroOrderSweep()).
+     * The generated source code only depends on the number of jobs and not
+     * on the order in which the threads finish.
+     * The default is 1 (no additional threads).
+     *
+     * @param maxJobs the maximum number of simultaneous source generation
+     *                jobs (0 uses the number of concurrent threads
+     *                supported by the hardware)
+     */
+    inline void setMaxParallelJobs(size_t maxJobs) {
+        if (maxJobs == 0)
+            maxJobs = std::thread::hardware_concurrency();
+        _maxParallelJobs = std::max<size_t>(1, maxJobs);
+    }
+
+    /**
+     * Provides the maximum number of tasks into which the zero order
+     * forward and the dense Jacobian functions are split.
+     *
+     * @return the maximum number of tasks (0 or 1 if disabled)
+     */
+    inline size_t getParallelTasks() const {
+        return _parallelTasks;
+    }
+
+    /**
+     * Defines the maximum number of tasks into which the zero order
+     * forward and the dense Jacobian functions are split.
+     * Each task is placed in its own function and the tasks which do not
+     * depend on each other are evaluated simultaneously by the thread pool
+     * of the model library.
+     * It is only used when multithreading is enabled for this model (see
+     * setMultiThreading()), the model library uses PThreads, and the model
+     * does not contain loops.
+     * Operation graphs with conditional operations, atomic functions or
+     * arrays are not split.
+     * The default is 0 (disabled).
+     *
+     * @param tasks the maximum number of tasks
+     */
+    inline void setParallelTasks(size_t tasks) {
+        _parallelTasks = tasks;
+    }
+
     /**
      * Determines whether or not to generate source-code for a function
      * that evaluates the original model.
@@ -677,6 +905,43 @@ public:
         _zero = create;
     }
 
+    /**
+     * Determines whether or not to generate source-code for functions which
+     * evaluate the original model and the sparse Jacobian at several points
+     * with a single call.
+     * These functions are only created when the source-code for the
+     * corresponding single point functions is also generated.
+     *
+     * @return true if source-code for batch evaluations should be created,
+     *         false otherwise
+     */
+    inline bool isCreateBatchFunctions() const {
+        return _batch;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for functions which
+     * evaluate the original model and the sparse Jacobian at several points
+     * with a single call.
+     * These functions are only created when the source-code for the
+     * corresponding single point functions is also generated.
+     * The values for all the points are provided and returned in a
+     * structure-of-arrays layout: the value of variable j at point p is
+     * located at position [j * nPoints + p].
+     * The batch functions call the single point functions in a loop: they
+     * avoid a library call per point but the operations of different
+     * points are not vectorized.
+     *
+     * @see setCreateForwardZero()
+     * @see setCreateSparseJacobian()
+     *
+     * @param create true if source-code for batch evaluations should be
+     *               created, false otherwise
+     */
+    inline void setCreateBatchFunctions(bool create) {
+        _batch = create;
+    }
+
     /**
      * Determines whether or not to generate source-code for the
      * first-order forward mode that is used for the evaluation of the
@@ -896,6 +1161,75 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * Whether or not identical operations are merged into a single
+     * operation before generating source code.
+     *
+     * @return true if common subexpression elimination is enabled
+     */
+    inline bool isEliminateCommonSubexpressions() const {
+        return _eliminateCommonSubexpressions;
+    }
+
+    /**
+     * Defines whether or not identical operations (e.g. the same function
+     * of the same variables computed for several equations) should be
+     * merged into a single operation before generating source code.
+     * This can reduce the number of operations in the generated source
+     * code at the cost of some additional time to generate it.
+     * Operations inside loops are not affected.
+     *
+     * @param eliminate whether or not to eliminate common subexpressions
+     */
+    inline void setEliminateCommonSubexpressions(bool eliminate) {
+        _eliminateCommonSubexpressions = eliminate;
+    }
+
+    /**
+     * Whether or not expensive operations (e.g. pow() with constant
+     * exponents and divisions by constants) are replaced with cheaper
+     * equivalent ones before generating source code.
+     *
+     * @return true if strength reduction is enabled
+     */
+    inline bool isReduceOperationStrength() const {
+        return _reduceOperationStrength;
+    }
+
+    /**
+     * Defines whether or not expensive operations (e.g. pow() with
+     * constant exponents and divisions by constants) should be replaced
+     * with cheaper equivalent ones before generating source code.
+     * Operations inside loops are not affected.
+     *
+     * @param reduce whether or not to reduce the strength of operations
+     * @see setStrictFloatingPoint()
+     */
+    inline void setReduceOperationStrength(bool reduce) {
+        _reduceOperationStrength = reduce;
+    }
+
+    /**
+     * Whether or not the strength reduction only performs replacements
+     * which preserve the IEEE 754 results of the original operations.
+     */
+    inline bool isStrictFloatingPoint() const {
+        return _strictFloatingPoint;
+    }
+
+    /**
+     * Defines whether or not the strength reduction only performs
+     * replacements which preserve the IEEE 754 results of the original
+     * operations (see CodeHandler::setStrictFloatingPoint()).
+     * The default is true.
+     *
+     * @param strict whether or not to preserve the results of the original
+     *               operations
+     */
+    inline void setStrictFloatingPoint(bool strict) {
+        _strictFloatingPoint = strict;
+    }
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -922,18 +1256,65 @@ protected:
                                                                      const std::string& tmpName = "v",
                                                                      const std::string& tmpArrayName = "array");
 
+    /**
+     * Provides the source files of this model (they are generated if
+     * required).
+     *
+     * @throws CGException if the source files were already provided to a
+     *                     source sink (see streamSources())
+     */
     const std::map<std::string, std::string>& getSources(MultiThreadingType multiThreadingType,
                                                          JobTimer* timer);
 
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
+    /**
+     * Generates the source code and provides each source file to a sink
+     * as soon as it is complete instead of keeping all of them in memory.
+     * The source files are no longer available afterwards (getSources()
+     * throws an exception).
+     *
+     * @param multiThreadingType the type of multithreading used by the
+     *                           model library
+     * @param timer the job timer (possibly null)
+     * @param sink receives the source files
+     */
+    virtual void streamSources(MultiThreadingType multiThreadingType,
+                               JobTimer* timer,
+                               SourceFileSink& sink);
+
+    /**
+     * Moves the source files created so far to the source sink (if
+     * the sources are being streamed).
+     */
+    inline void flushSources();
+
     virtual void generateLoops();
 
     virtual void generateInfoSource();
 
     virtual void generateAtomicFuncNames();
 
+    /**
+     * Generates a function which evaluates an existing (single point)
+     * function for several points provided in a structure-of-arrays layout.
+     * The generated function only loops over the points, copying the
+     * values of each point into a contiguous buffer (allocated on the heap)
+     * and calling the single point function, so the operations are not
+     * vectorized across points.
+     * It returns 0 on success and -1 if memory could not be allocated.
+     *
+     * @param functionName the name of the existing function
+     * @param batchFunctionName the name of the new function
+     * @param nIn the number of elements in the input array
+     * @param nOut the number of elements in the output array
+     */
+    virtual void generateBatchSource(const std::string& functionName,
+                                     const std::string& batchFunctionName,
+                                     size_t nIn,
+                                     size_t nOut);
+
     virtual bool isAtomicsUsed();
 
     virtual const std::map<size_t, AtomicUseInfo<Base> >& getAtomicsInfo();
@@ -942,7 +1323,16 @@ protected:
      * zero order (the original model)
      **********************************************************************/
 
-    virtual void generateZeroSource();
+    virtual void generateZeroSource(MultiThreadingType multiThreadingType);
+
+    /**
+     * Prepares the code handler and the language so that the generated
+     * function is split into tasks evaluated by the thread pool (if
+     * enabled).
+     */
+    inline void prepareParallelTasks(CodeHandler<Base>& handler,
+                                     LanguageC<Base>& langC,
+                                     MultiThreadingType multiThreadingType);
 
     /**
      * Generates the operation graph for the zero order model with loops
@@ -954,7 +1344,7 @@ protected:
      * Jacobian
      **********************************************************************/
 
-    virtual void generateJacobianSource();
+    virtual void generateJacobianSource(MultiThreadingType multiThreadingType);
 
     virtual void generateSparseJacobianSource(MultiThreadingType multiThreadingType);
 
@@ -1218,6 +1608,33 @@ protected:
                                                          const std::string& function_sparsity,
                                                          const std::map<size_t, std::vector<size_t> >& elements);
 
+    /***********************************************************************
+     * Values shared by directional functions
+     **********************************************************************/
+
+    virtual std::vector<CGBase> determineSharedValues(CodeHandler<Base>& handler,
+                                                      const std::map<size_t, std::vector<CGBase> >& directions);
+
+    virtual void generateSharedValuesSource(CodeHandler<Base>& handler,
+                                            const std::string& function,
+                                            std::vector<CGBase>& shared,
+                                            VariableNameGenerator<Base>& nameGen,
+                                            const std::string& jobName);
+
+    inline size_t getSharedValuesSize(const std::string& function) const;
+
+    static inline bool isShareableOperation(CGOpCode op);
+
+    /***********************************************************************
+     * Source generation in parallel
+     **********************************************************************/
+
+    virtual void generateDirectionalSources(std::vector<std::vector<DirectionalFunction> >& groups,
+                                            const DirectionalCodeGenerator& generate);
+
+    static inline std::vector<std::map<size_t, std::vector<size_t> > > splitDirections(const std::map<size_t, std::vector<size_t> >& elements,
+                                                                                       size_t nGroups);
+
     /**
      * Loops
      */
@@ -1299,6 +1716,23 @@ protected:
     static void printLoopEndOpenMP(std::ostringstream& cache,
                                    size_t size);
 
+    /**
+     * Prints the declaration of the array with the values shared by the
+     * directional functions (allocated on the heap).
+     */
+    void printSharedValuesDeclaration(std::ostringstream& cache,
+                                      size_t nShared) const;
+
+    /**
+     * Prints the code which leaves a function without a return value when
+     * the array with the shared values could not be allocated.
+     *
+     * @param cleanup code executed before leaving the function
+     */
+    static void printSharedValuesCheck(std::ostringstream& cache,
+                                       const std::string& functionName,
+                                       const std::string& cleanup = "");
+
     /**
      *
      */
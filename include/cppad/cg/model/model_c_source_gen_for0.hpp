@@ -19,13 +19,16 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-void ModelCSourceGen<Base>::generateZeroSource() {
+void ModelCSourceGen<Base>::generateZeroSource(MultiThreadingType multiThreadingType) {
     const std::string jobName = "model (zero-order forward)";
 
     startingJob("'" + jobName + "'", JobTimer::GRAPH);
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+    handler.setReduceOperationStrength(_reduceOperationStrength);
+    handler.setStrictFloatingPoint(_strictFloatingPoint);
 
     std::vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -50,9 +53,12 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setSourceSink(_sourceSink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
+    prepareParallelTasks(handler, langC, multiThreadingType);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
@@ -60,6 +66,17 @@ void ModelCSourceGen<Base>::generateZeroSource() {
     handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
 }
 
+template<class Base>
+inline void ModelCSourceGen<Base>::prepareParallelTasks(CodeHandler<Base>& handler,
+                                                        LanguageC<Base>& langC,
+                                                        MultiThreadingType multiThreadingType) {
+    if (!isParallelTasksEnabled() || multiThreadingType != MultiThreadingType::PTHREADS)
+        return;
+
+    handler.setParallelTasks(_parallelTasks);
+    langC.setParallelTaskRunner("cppadcg_thpool_run_task_graph");
+}
+
 
 } // END cg namespace
 } // END CppAD namespace
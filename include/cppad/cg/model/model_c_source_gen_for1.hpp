@@ -72,6 +72,23 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
     const std::string jobName = "model (forward one)";
     startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
 
+    auto generate = [this, n](DirectionalFunction& f,
+                              LanguageC<Base>& langC,
+                              std::vector<std::string>& atomicFunctions) {
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
+
+        f.handler->generateCode(code, langC, f.dependents, nameGenHess, atomicFunctions, f.jobName);
+    };
+
+    /**
+     * the tapes are always recorded by this thread but the source code of
+     * up to _maxParallelJobs directions can be generated at the same time
+     */
+    std::vector<std::unique_ptr<CodeHandler<Base> > > handlers;
+    std::vector<std::vector<DirectionalFunction> > groups;
+
     for (const auto& it : elements) {
         size_t j = it.first;
         const std::vector<size_t>& rows = it.second;
@@ -82,8 +99,12 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
 
         startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
-        CodeHandler<Base> handler;
+        handlers.emplace_back(new CodeHandler<Base>());
+        CodeHandler<Base>& handler = *handlers.back();
         handler.setJobTimer(_jobTimer);
+        handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+        handler.setReduceOperationStrength(_reduceOperationStrength);
+        handler.setStrictFloatingPoint(_strictFloatingPoint);
 
         vector<CGBase> indVars(n);
         handler.makeVariables(indVars);
@@ -113,20 +134,18 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
 
         finishedJob();
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
-        langC.setGenerateFunction(_cache.str());
+        groups.push_back({DirectionalFunction{&handler, std::move(dyCustom), _cache.str(), subJobName}});
 
-        std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
-
-        handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        if (groups.size() == _maxParallelJobs) {
+            generateDirectionalSources(groups, generate);
+            groups.clear();
+            handlers.clear();
+        }
     }
+
+    generateDirectionalSources(groups, generate);
 }
 
 template<class Base>
@@ -138,82 +157,150 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
      */
     size_t n = _fun.Domain();
 
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    /**
+     * the directions are recorded in groups (one per thread) so that their
+     * source code can be generated at the same time, unless the values
+     * used by several directions must be computed in a single function
+     */
+    std::vector<std::map<size_t, std::vector<size_t> > > groupElements;
+    if (_shareZeroOrderSweep || _maxParallelJobs == 1) {
+        groupElements.push_back(elements);
+    } else {
+        groupElements = splitDirections(elements, _maxParallelJobs);
+    }
+
+    std::vector<std::unique_ptr<CodeHandler<Base> > > handlers;
+    std::vector<std::vector<DirectionalFunction> > groups;
+    std::vector<CGBase> shared;
+
+    // the set-based representation required by CppAD is shared by all groups
+    const SparsitySetType jacSparsitySet = _jacSparsity.sparsity.toSet();
+
+    _sharedValuesSize.erase(FUNCTION_SPARSE_FORWARD_ONE_SHARED);
 
-    vector<CGBase> x(n);
-    handler.makeVariables(x);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            x[i].setValue(_x[i]);
+    for (const auto& groupElem : groupElements) {
+        handlers.emplace_back(new CodeHandler<Base>());
+        CodeHandler<Base>& handler = *handlers.back();
+        handler.setJobTimer(_jobTimer);
+        handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+        handler.setReduceOperationStrength(_reduceOperationStrength);
+        handler.setStrictFloatingPoint(_strictFloatingPoint);
+
+        vector<CGBase> x(n);
+        handler.makeVariables(x);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                x[i].setValue(_x[i]);
+            }
         }
-    }
 
-    CGBase dx;
-    handler.makeVariable(dx);
-    if (_x.size() > 0) {
-        dx.setValue(Base(1.0));
-    }
+        CGBase dx;
+        handler.makeVariable(dx);
+        if (_x.size() > 0) {
+            dx.setValue(Base(1.0));
+        }
 
-    vector<CGBase> jacFlat(_jacSparsity.rows.size());
+        /**
+         * the Jacobian elements of the directions in this group
+         */
+        std::vector<size_t> rows, cols;
+        for (size_t el = 0; el < _jacSparsity.rows.size(); el++) {
+            if (groupElem.find(_jacSparsity.cols[el]) != groupElem.end()) {
+                rows.push_back(_jacSparsity.rows[el]);
+                cols.push_back(_jacSparsity.cols[el]);
+            }
+        }
 
-    CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-    _fun.SparseJacobianForward(x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jacFlat, work);
+        vector<CGBase> jacFlat(rows.size());
 
-    /**
-     * organize results
-     */
-    std::map<size_t, vector<CGBase> > jac; // by column
-    std::map<size_t, std::map<size_t, size_t> > positions; // by column
+        CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
+        _fun.SparseJacobianForward(x, jacSparsitySet, rows, cols, jacFlat, work);
 
-    for (const auto& it : elements) {
-        size_t j = it.first;
-        const std::vector<size_t>& column = it.second;
+        /**
+         * organize results
+         */
+        std::map<size_t, vector<CGBase> > jac; // by column
+        std::map<size_t, std::map<size_t, size_t> > positions; // by column
+
+        for (const auto& it : groupElem) {
+            size_t j = it.first;
+            const std::vector<size_t>& column = it.second;
 
-        jac[j].resize(column.size());
-        std::map<size_t, size_t>& pos = positions[j];
+            jac[j].resize(column.size());
+            std::map<size_t, size_t>& pos = positions[j];
 
-        for (size_t e = 0; e < column.size(); e++) {
-            size_t i = column[e];
-            pos[i] = e;
+            for (size_t e = 0; e < column.size(); e++) {
+                size_t i = column[e];
+                pos[i] = e;
+            }
+        }
+
+        for (size_t el = 0; el < rows.size(); el++) {
+            size_t i = rows[el];
+            size_t j = cols[el];
+            size_t e = positions[j].at(i);
+
+            vector<CGBase>& column = jac[j];
+            column[e] = jacFlat[el];
+        }
+
+        /**
+         * Values used by several independents/columns
+         */
+        if (_shareZeroOrderSweep) {
+            shared = determineSharedValues(handler, jac);
         }
-    }
 
-    for (size_t el = 0; el < _jacSparsity.rows.size(); el++) {
-        size_t i = _jacSparsity.rows[el];
-        size_t j = _jacSparsity.cols[el];
-        size_t e = positions[j].at(i);
+        if (!shared.empty()) {
+            std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("sh"));
+            LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
-        vector<CGBase>& column = jac[j];
-        column[e] = jacFlat[el] * dx;
+            generateSharedValuesSource(handler, FUNCTION_SPARSE_FORWARD_ONE_SHARED, shared, nameGenHess,
+                                       "model (forward one, shared)");
+        }
+
+        /**
+         * The functions for each independent/column
+         */
+        groups.emplace_back();
+        for (auto& itJ : jac) {
+            size_t j = itJ.first;
+            vector<CGBase>& dyCustom = itJ.second;
+            for (CGBase& dy : dyCustom) {
+                dy *= dx;
+            }
+
+            _cache.str("");
+            _cache << "model (forward one, indep " << j << ")";
+            const std::string subJobName = _cache.str();
+
+            _cache.str("");
+            _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
+            groups.back().push_back(DirectionalFunction{&handler, std::move(dyCustom), _cache.str(), subJobName});
+        }
     }
 
     /**
      * Create source for each independent/column
      */
-    typename std::map<size_t, vector<CGBase> >::iterator itJ;
-    for (itJ = jac.begin(); itJ != jac.end(); ++itJ) {
-        size_t j = itJ->first;
-        vector<CGBase>& dyCustom = itJ->second;
-
-        _cache.str("");
-        _cache << "model (forward one, indep " << j << ")";
-        const std::string subJobName = _cache.str();
-
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
-        _cache.str("");
-        _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
-        langC.setGenerateFunction(_cache.str());
-
+    const bool useShared = !shared.empty();
+    auto generate = [this, n, useShared](DirectionalFunction& f,
+                                         LanguageC<Base>& langC,
+                                         std::vector<std::string>& atomicFunctions) {
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
+        // the shared values are provided in an additional input array
+        LangCDefaultHessianVarNameGenerator<Base> nameGenShared(&nameGenHess, "sh", n + 1);
 
-        handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
-    }
+        if (useShared) {
+            f.handler->generateCode(code, langC, f.dependents, nameGenShared, atomicFunctions, f.jobName);
+        } else {
+            f.handler->generateCode(code, langC, f.dependents, nameGenHess, atomicFunctions, f.jobName);
+        }
+    };
+
+    generateDirectionalSources(groups, generate);
 }
 
 template<class Base>
@@ -230,13 +317,19 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::string args = langC.generateDefaultFunctionArguments();
 
+    size_t nShared = getSharedValuesSize(FUNCTION_SPARSE_FORWARD_ONE_SHARED);
+    std::string sharedFunction = _name + "_" + FUNCTION_SPARSE_FORWARD_ONE_SHARED;
+
     _cache.str("");
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
             "\n"
             "int " << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "(unsigned long pos, " << argsDcl << ");\n"
-            "void " << _name << "_" << FUNCTION_FORWARD_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n"
-            "\n";
+            "void " << _name << "_" << FUNCTION_FORWARD_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+    if (nShared > 0) {
+        _cache << "void " << sharedFunction << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
     LanguageC<Base>::printFunctionDeclaration(_cache, "int", model_function, {_baseTypeName + " const tx[]",
                                                                               _baseTypeName + " ty[]",
                                                                               langC.generateArgumentAtomicDcl()});
@@ -246,10 +339,13 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "   unsigned long* txPos;\n"
             "   unsigned long* txPosTmp;\n"
             "   unsigned long nnzTx;\n"
-            "   " << _baseTypeName << " const * in[2];\n"
+            "   " << _baseTypeName << " const * in[" << (nShared > 0 ? 3 : 2) << "];\n"
             "   " << _baseTypeName << "* out[1];\n"
-            "   " << _baseTypeName << " x[" << n << "];\n"
-            "   " << _baseTypeName << "* compressed;\n"
+            "   " << _baseTypeName << " x[" << n << "];\n";
+    if (nShared > 0) {
+        _cache << "   " << _baseTypeName << "* shared;\n";
+    }
+    _cache << "   " << _baseTypeName << "* compressed;\n"
             "   int ret;\n"
             "\n"
             "   txPos = 0;\n"
@@ -282,12 +378,29 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "      return 0; //nothing to do\n"
             "   }\n"
             "\n"
-            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n"
-            "\n"
+            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n";
+    if (nShared > 0) {
+        _cache << "   shared = (" << _baseTypeName << "*) malloc(" << nShared << " * sizeof(" << _baseTypeName << "));\n"
+                "   if (compressed == NULL || shared == NULL) {\n"
+                "      free(compressed);\n"
+                "      free(shared);\n"
+                "      free(txPos);\n"
+                "      return -1; // failure to allocate memory\n"
+                "   }\n";
+    }
+    _cache << "\n"
             "   for (j = 0; j < " << n << "; j++)\n"
             "      x[j] = tx[j * 2];\n"
-            "\n"
-            "   for (ej = 0; ej < nnzTx; ej++) {\n"
+            "\n";
+    if (nShared > 0) {
+        _cache << "   in[0] = x;\n"
+                "   in[1] = &tx[txPos[0] * 2 + 1];\n"
+                "   in[2] = shared;\n"
+                "   out[0] = shared;\n"
+                "   " << sharedFunction << "(" << args << ");\n"
+                "\n";
+    }
+    _cache << "   for (ej = 0; ej < nnzTx; ej++) {\n"
             "      j = txPos[ej];\n"
             "      " << _name << "_" << FUNCTION_FORWARD_ONE_SPARSITY << "(j, &pos, &nnz);\n"
             "\n"
@@ -303,8 +416,11 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "\n"
             "      if (ret != 0) {\n"
             "         free(compressed);\n"
-            "         free(txPos);\n"
-            "         return ret;\n"
+            "         free(txPos);\n";
+    if (nShared > 0) {
+        _cache << "         free(shared);\n";
+    }
+    _cache << "         return ret;\n"
             "      }\n"
             "\n"
             "      for (ePos = 0; ePos < nnz; ePos++) {\n"
@@ -313,8 +429,11 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "\n"
             "   }\n"
             "   free(compressed);\n"
-            "   free(txPos);\n"
-            "   return 0;\n"
+            "   free(txPos);\n";
+    if (nShared > 0) {
+        _cache << "   free(shared);\n";
+    }
+    _cache << "   return 0;\n"
             "}\n";
     _sources[model_function + ".c"] = _cache.str();
     _cache.str("");
@@ -28,6 +28,9 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+    handler.setReduceOperationStrength(_reduceOperationStrength);
+    handler.setStrictFloatingPoint(_strictFloatingPoint);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -64,8 +67,10 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setSourceSink(_sourceSink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
     std::ostringstream code;
@@ -162,6 +167,9 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+    handler.setReduceOperationStrength(_reduceOperationStrength);
+    handler.setStrictFloatingPoint(_strictFloatingPoint);
 
     // independent variables
     vector<CGBase> indVars(n);
@@ -189,7 +197,8 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
         // (some values could be zeroed)
         work.color_method = "cppad.general";
         vector<CGBase> lowerHess(lowerHessRows.size());
-        _fun.SparseHessian(indVars, w, _hessSparsity.sparsity, lowerHessRows, lowerHessCols, lowerHess, work);
+        const SparsitySetType hessSparsitySet = _hessSparsity.sparsity.toSet(); // only used by CppAD
+        _fun.SparseHessian(indVars, w, hessSparsitySet, lowerHessRows, lowerHessCols, lowerHess, work);
 
         for (size_t i = 0; i < lowerHessOrder.size(); i++) {
             hess[lowerHessOrder[i]] = lowerHess[i];
@@ -212,8 +221,10 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setSourceSink(_sourceSink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
 
     std::ostringstream code;
@@ -311,31 +322,49 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2SingleThreadSource(c
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
 
+    size_t nShared = getSharedValuesSize(FUNCTION_SPARSE_REVERSE_TWO_SHARED);
+
     _cache.str("");
-    _cache << "#include <stdlib.h>\n"
-            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    _cache << "#include <stdlib.h>\n";
+    if (nShared > 0) {
+        _cache << "#include <stdio.h>\n";
+    }
+    _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
     generateFunctionDeclarationSource(_cache, functionRev2, rev2Suffix, hessInfo, argsDcl);
+    if (nShared > 0) {
+        _cache << "void " << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO_SHARED << "(" << argsDcl << ");\n";
+    }
     _cache << "\n";
     LanguageC<Base>::printFunctionDeclaration(_cache, "void", functionName, argsDcl2);
     _cache << " {\n"
-            "   " << _baseTypeName << " const * inLocal[3];\n"
+            "   " << _baseTypeName << " const * inLocal[" << (nShared > 0 ? 4 : 3) << "];\n"
             "   " << _baseTypeName << " inLocal1 = 1;\n"
             "   " << _baseTypeName << " * outLocal[1];\n";
     if (maxCompressedSize > 0) {
         _cache << "   " << _baseTypeName << " compressed[" << maxCompressedSize << "];\n";
     }
+    if (nShared > 0) {
+        printSharedValuesDeclaration(_cache, nShared);
+    }
     _cache << "   " << _baseTypeName << " * hess = out[0];\n"
             "\n"
             "   inLocal[0] = in[0];\n"
             "   inLocal[1] = &inLocal1;\n"
             "   inLocal[2] = in[1];\n";
-    if (maxCompressedSize > 0) {
-        _cache << "   outLocal[0] = compressed;";
-    }
 
     langC.setArgumentIn("inLocal");
     langC.setArgumentOut("outLocal");
     std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+    if (nShared > 0) {
+        printSharedValuesCheck(_cache, functionName);
+        _cache << "   inLocal[3] = shared;\n"
+                "   outLocal[0] = shared;\n"
+                "   " << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO_SHARED << "(" << argsLocal << ");\n";
+    }
+    if (maxCompressedSize > 0) {
+        _cache << "   outLocal[0] = compressed;";
+    }
     bool previousCompressed = true;
     for (auto& it : hessInfo) {
         size_t index = it.first;
@@ -364,6 +393,10 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2SingleThreadSource(c
         previousCompressed = compressed;
     }
 
+    if (nShared > 0) {
+        _cache << "\n"
+                "   free(shared);\n";
+    }
     _cache << "\n"
             "}\n";
     return _cache.str();
@@ -384,10 +417,16 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
 
+    size_t nShared = getSharedValuesSize(FUNCTION_SPARSE_REVERSE_TWO_SHARED);
+
     _cache.str("");
     _cache << "#include <stdlib.h>\n"
+           << (nShared > 0 ? "#include <stdio.h>\n" : "")
            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
     generateFunctionDeclarationSource(_cache, functionRev2, rev2Suffix, hessInfo, argsDcl);
+    if (nShared > 0) {
+        _cache << "void " << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO_SHARED << "(" << argsDcl << ");\n";
+    }
 
 
     langC.setArgumentIn("inLocal");
@@ -411,7 +450,7 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         std::string functionNameWrap = functionRev2 + "_" + rev2Suffix + std::to_string(index) + "_wrap";
         LanguageC<Base>::printFunctionDeclaration(_cache, "void", functionNameWrap, argsDcl2);
         _cache << " {\n"
-                "   " << _baseTypeName << " const * inLocal[3];\n"
+                "   " << _baseTypeName << " const * inLocal[" << (nShared > 0 ? 4 : 3) << "];\n"
                 "   " << _baseTypeName << " inLocal1 = 1;\n"
                 "   " << _baseTypeName << " * outLocal[1];\n"
                 "   " << _baseTypeName << " compressed[" << it.second.indexes.size() << "];\n"
@@ -419,8 +458,11 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
                 "\n"
                 "   inLocal[0] = in[0];\n"
                 "   inLocal[1] = &inLocal1;\n"
-                "   inLocal[2] = in[1];\n"
-                "   outLocal[0] = compressed;\n";
+                "   inLocal[2] = in[2];\n";
+        if (nShared > 0) {
+            _cache << "   inLocal[3] = in[3];\n";
+        }
+        _cache << "   outLocal[0] = compressed;\n";
         _cache << "   " << functionRev2 << "_" << rev2Suffix << index << "(" << argsLocal << ");\n";
         for (size_t e = 0; e < els.size(); e++) {
             _cache << "   ";
@@ -476,16 +518,36 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         }
     }
     _cache << "};\n"
-            "   " << _baseTypeName << " inLocal1 = 1;\n"
-            "   " << _baseTypeName << " const * inLocal[3] = {in[0], &inLocal1, in[1]};\n"
-            "   " << _baseTypeName << " * outLocal[1];\n";
+            "   " << _baseTypeName << " inLocal1 = 1;\n";
+    if (nShared > 0) {
+        printSharedValuesDeclaration(_cache, nShared);
+        _cache << "   " << _baseTypeName << " const * inLocal[4] = {in[0], &inLocal1, in[1], shared};\n";
+    } else {
+        _cache << "   " << _baseTypeName << " const * inLocal[3] = {in[0], &inLocal1, in[1]};\n";
+    }
+    _cache << "   " << _baseTypeName << " * outLocal[1];\n";
     _cache << "   " << _baseTypeName << " * hess = out[0];\n"
             "   long i;\n"
             "\n";
 
+    // the shared values are evaluated before starting the threads
+    std::string sharedCall;
+    if (nShared > 0) {
+        sharedCall = "   outLocal[0] = shared;\n"
+                     "   " + _name + "_" + FUNCTION_SPARSE_REVERSE_TWO_SHARED + "(" + argsLocal + ");\n"
+                     "\n";
+    }
+    std::ostringstream sharedCheck;
+
     if(multiThreadingType == MultiThreadingType::OPENMP) {
         printFunctionStartOpenMP(_cache, hessInfo.size());
-        _cache << "\n";
+        if (nShared > 0) {
+            printSharedValuesCheck(sharedCheck, functionName,
+                                   "      if(enabled) {\n"
+                                   "         omp_set_schedule(old_kind, old_modifier);\n"
+                                   "      }\n");
+        }
+        _cache << "\n" << sharedCheck.str() << sharedCall;
         printLoopStartOpenMP(_cache, hessInfo.size());
         _cache << "      outLocal[0] = &hess[offset[i]];\n"
                 "      (*p[i])(" << argsLocal << ");\n";
@@ -496,7 +558,10 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         assert(multiThreadingType == MultiThreadingType::PTHREADS);
 
         printFunctionStartPThreads(_cache, hessInfo.size());
-        _cache << "\n"
+        if (nShared > 0) {
+            printSharedValuesCheck(sharedCheck, functionName);
+        }
+        _cache << "\n" << sharedCheck.str() << sharedCall <<
                 "   for(i = 0; i < " << hessInfo.size() << "; ++i) {\n"
                 "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
                 "      args[i]->func = p[i];\n"
@@ -508,6 +573,10 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         printFunctionEndPThreads(_cache, hessInfo.size());
     }
 
+    if (nShared > 0) {
+        _cache << "\n"
+                "   free(shared);\n";
+    }
     _cache << "\n"
             "}\n";
     return _cache.str();
@@ -527,8 +596,7 @@ void ModelCSourceGen<Base>::determineSecondOrderElements4Eval(std::vector<size_t
     for (size_t e = 0; e < _hessSparsity.rows.size(); e++) {
         size_t i = _hessSparsity.rows[e];
         size_t j = _hessSparsity.cols[e];
-        if (_hessSparsity.sparsity[i].find(j) == _hessSparsity.sparsity[i].end() &&
-                _hessSparsity.sparsity[j].find(i) != _hessSparsity.sparsity[j].end()) {
+        if (!_hessSparsity.sparsity.contains(i, j) && _hessSparsity.sparsity.contains(j, i)) {
             // only the symmetric value is available
             // (it can be caused by atomic functions which may only be providing a partial hessian)
             evalRows.push_back(j);
@@ -542,7 +610,7 @@ void ModelCSourceGen<Base>::determineSecondOrderElements4Eval(std::vector<size_t
 
 template<class Base>
 void ModelCSourceGen<Base>::determineHessianSparsity() {
-    if (_hessSparsity.sparsity.size() > 0) {
+    if (_hessSparsity.sparsity.rows() > 0) {
         return;
     }
 
@@ -561,7 +629,8 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
     for (size_t i = 0; i < m; i++) {
         s[0].insert(i);
     }
-    _hessSparsity.sparsity = _fun.RevSparseHes(n, s, false);
+    _hessSparsity.sparsity = SparsityPattern::fromSet(_fun.RevSparseHes(n, s, false), n);
+    _hessSparsity.sparsity.useBitsets(); // the symmetry of the elements is checked with contains()
     //printSparsityPattern(_hessSparsity.sparsity, "hessian");
 
     if (_hessianByEquation || _reverseTwo) {
@@ -588,11 +657,10 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
 
         /**
          * For each individual equation
+         * (only the non-zero elements are collected before creating the
+         * compressed sparsity patterns)
          */
-        _hessSparsities.resize(m);
-        for (size_t i = 0; i < m; i++) {
-            _hessSparsities[i].sparsity.resize(n);
-        }
+        std::vector<std::vector<size_t> > eqRows(m), eqCols(m);
 
         for (size_t c = 0; c < colors.size(); c++) {
             const Color& color = colors[c];
@@ -620,26 +688,32 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
             for (size_t j : color.forbiddenRows) { //used variables
                 if (sparsityc[j].size() > 0) {
                     size_t i = var2Eq.at(j);
-                    _hessSparsities[i].sparsity[j].insert(sparsityc[j].begin(),
-                                                          sparsityc[j].end());
+                    eqRows[i].insert(eqRows[i].end(), sparsityc[j].size(), j);
+                    eqCols[i].insert(eqCols[i].end(), sparsityc[j].begin(), sparsityc[j].end());
                 }
             }
 
         }
 
+        _hessSparsities.resize(m);
         for (size_t i = 0; i < m; i++) {
             LocalSparsityInfo& hessSparsitiesi = _hessSparsities[i];
+            hessSparsitiesi.sparsity = SparsityPattern(n, n, eqRows[i], eqCols[i]);
+            std::vector<size_t>().swap(eqRows[i]);
+            std::vector<size_t>().swap(eqCols[i]);
 
             if (!_custom_hess.defined) {
                 generateSparsityIndexes(hessSparsitiesi.sparsity,
                                         hessSparsitiesi.rows, hessSparsitiesi.cols);
 
             } else {
+                hessSparsitiesi.sparsity.useBitsets();
+
                 size_t nnz = _custom_hess.row.size();
                 for (size_t e = 0; e < nnz; e++) {
                     size_t i1 = _custom_hess.row[e];
                     size_t i2 = _custom_hess.col[e];
-                    if (hessSparsitiesi.sparsity[i1].find(i2) != hessSparsitiesi.sparsity[i1].end()) {
+                    if (hessSparsitiesi.sparsity.contains(i1, i2)) {
                         hessSparsitiesi.rows.push_back(i1);
                         hessSparsitiesi.cols.push_back(i2);
                     }
@@ -23,6 +23,9 @@ namespace cg {
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO = "forward_zero";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_BATCH = "forward_zero_batch";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN = "jacobian";
 
@@ -41,6 +44,9 @@ const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO = "reverse_two";
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN = "sparse_jacobian";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN_BATCH = "sparse_jacobian_batch";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN = "sparse_hessian";
 
@@ -71,6 +77,15 @@ const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY = "revers
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY = "sparse_reverse_two_sparsity";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE_SHARED = "sparse_forward_one_shared";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE_SHARED = "sparse_reverse_one_shared";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO_SHARED = "sparse_reverse_two_shared";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 
@@ -91,12 +106,44 @@ VariableNameGenerator<Base>* ModelCSourceGen<Base>::createVariableNameGenerator(
 template<class Base>
 const std::map<std::string, std::string>& ModelCSourceGen<Base>::getSources(MultiThreadingType multiThreadingType,
                                                                             JobTimer* timer) {
+    if (_sourcesStreamed) {
+        throw CGException("The source files of model '", _name, "' were provided to a source sink and are no longer available");
+    }
     if (_sources.empty()) {
         generateSources(multiThreadingType, timer);
     }
     return _sources;
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::streamSources(MultiThreadingType multiThreadingType,
+                                          JobTimer* timer,
+                                          SourceFileSink& sink) {
+    CPPADCG_ASSERT_KNOWN(_sources.empty() && !_sourcesStreamed, "The model sources were already generated")
+
+    _sourceSink = &sink;
+    try {
+        generateSources(multiThreadingType, timer);
+        flushSources();
+    } catch (...) {
+        _sourceSink = nullptr;
+        throw;
+    }
+    _sourceSink = nullptr;
+    _sourcesStreamed = true;
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::flushSources() {
+    if (_sourceSink == nullptr)
+        return;
+
+    for (auto& it : _sources) {
+        _sourceSink->addSource(it.first, std::move(it.second));
+    }
+    _sources.clear();
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingType,
                                             JobTimer* timer) {
@@ -107,47 +154,70 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
     startingJob("'" + _name + "'", JobTimer::SOURCE_FOR_MODEL);
 
     if (_zero) {
-        generateZeroSource();
+        generateZeroSource(multiThreadingType);
         _zeroEvaluated = true;
+
+        if (_batch) {
+            generateBatchSource(_name + "_" + FUNCTION_FORWAD_ZERO,
+                                _name + "_" + FUNCTION_FORWARD_ZERO_BATCH,
+                                _fun.Domain(), _fun.Range());
+        }
+        flushSources();
     }
 
     if (_jacobian) {
-        generateJacobianSource();
+        generateJacobianSource(multiThreadingType);
+        flushSources();
     }
 
     if (_hessian) {
         generateHessianSource();
+        flushSources();
     }
 
     if (_forwardOne) {
         generateSparseForwardOneSources();
         generateForwardOneSources();
+        flushSources();
     }
 
     if (_reverseOne) {
         generateSparseReverseOneSources();
         generateReverseOneSources();
+        flushSources();
     }
 
     if (_reverseTwo) {
         generateSparseReverseTwoSources();
         generateReverseTwoSources();
+        flushSources();
     }
 
     if (_sparseJacobian) {
         generateSparseJacobianSource(multiThreadingType);
+
+        if (_batch) {
+            determineJacobianSparsity();
+            generateBatchSource(_name + "_" + FUNCTION_SPARSE_JACOBIAN,
+                                _name + "_" + FUNCTION_SPARSE_JACOBIAN_BATCH,
+                                _fun.Domain(), _jacSparsity.rows.size());
+        }
+        flushSources();
     }
 
     if (_sparseHessian) {
         generateSparseHessianSource(multiThreadingType);
+        flushSources();
     }
 
     if (_sparseJacobian || _forwardOne || _reverseOne) {
         generateJacobianSparsitySource();
+        flushSources();
     }
 
     if (_sparseHessian || _reverseTwo) {
         generateHessianSparsitySource();
+        flushSources();
     }
 
     generateInfoSource();
@@ -167,6 +237,9 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+    handler.setReduceOperationStrength(_reduceOperationStrength);
+    handler.setStrictFloatingPoint(_strictFloatingPoint);
 
     std::vector<CGBase> xx(_fun.Domain());
     handler.makeVariables(xx);
@@ -234,6 +307,75 @@ void ModelCSourceGen<Base>::generateAtomicFuncNames() {
     _sources[funcName + ".c"] = _cache.str();
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateBatchSource(const std::string& functionName,
+                                                const std::string& batchFunctionName,
+                                                size_t nIn,
+                                                size_t nOut) {
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+    CPPADCG_ASSERT_KNOWN(nameGen->getIndependent().size() == 1 && nameGen->getDependent().size() == 1,
+                         "Batch functions can only be created for models with a single independent and a single dependent array");
+
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
+
+    langC.setArgumentIn("inLocal");
+    langC.setArgumentOut("outLocal");
+    std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+            "\n"
+           << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+            "\n"
+            "void " << functionName << "(" << argsDcl << ");\n"
+            "\n";
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", batchFunctionName, {"unsigned long nPoints"}, argsDcl2);
+    _cache << " {\n"
+            "   unsigned long p" << (nIn > 0 || nOut > 0 ? ", j" : "") << ";\n";
+    if (nIn > 0) {
+        _cache << "   " << _baseTypeName << " const * x = in[0];\n";
+    }
+    if (nOut > 0) {
+        _cache << "   " << _baseTypeName << " * y = out[0];\n";
+    }
+    _cache << "   " << _baseTypeName << "* xLocal;\n"
+            "   " << _baseTypeName << "* yLocal;\n"
+            "   " << _baseTypeName << " const * inLocal[1];\n"
+            "   " << _baseTypeName << " * outLocal[1];\n"
+            "\n"
+            "   xLocal = (" << _baseTypeName << "*) malloc(" << (nIn + nOut + 1) << " * sizeof(" << _baseTypeName << "));\n"
+            "   if (xLocal == NULL)\n"
+            "      return -1; // failure to allocate memory\n"
+            "   yLocal = xLocal + " << nIn << ";\n"
+            "\n"
+            "   inLocal[0] = xLocal;\n"
+            "   outLocal[0] = yLocal;\n"
+            "\n"
+            "   for(p = 0; p < nPoints; p++) {\n";
+    if (nIn > 0) {
+        _cache << "      for(j = 0; j < " << nIn << "; j++) {\n"
+                "         xLocal[j] = x[j * nPoints + p];\n"
+                "      }\n"
+                "\n";
+    }
+    _cache << "      " << functionName << "(" << argsLocal << ");\n";
+    if (nOut > 0) {
+        _cache << "\n"
+                "      for(j = 0; j < " << nOut << "; j++) {\n"
+                "         y[j * nPoints + p] = yLocal[j];\n"
+                "      }\n";
+    }
+    _cache << "   }\n"
+            "\n"
+            "   free(xLocal);\n"
+            "   return 0;\n"
+            "}\n";
+
+    _sources[batchFunctionName + ".c"] = _cache.str();
+}
+
 template<class Base>
 bool ModelCSourceGen<Base>::isAtomicsUsed() {
     if (_zeroEvaluated) {
@@ -747,6 +889,23 @@ void ModelCSourceGen<Base>::printFunctionStartOpenMP(std::ostringstream& cache,
             "   }\n";
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::printSharedValuesDeclaration(std::ostringstream& cache,
+                                                         size_t nShared) const {
+    cache << "   " << _baseTypeName << "* shared = (" << _baseTypeName << "*) malloc(" << nShared << " * sizeof(" << _baseTypeName << "));\n";
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::printSharedValuesCheck(std::ostringstream& cache,
+                                                   const std::string& functionName,
+                                                   const std::string& cleanup) {
+    cache << "   if (shared == NULL) {\n"
+             "      fprintf(stderr, \"" << functionName << "(): Could not allocate memory for the shared values\\n\");\n"
+          << cleanup <<
+             "      return;\n"
+             "   }\n";
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::printLoopStartOpenMP(std::ostringstream& cache,
                                                  size_t size) {
@@ -19,7 +19,7 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-void ModelCSourceGen<Base>::generateJacobianSource() {
+void ModelCSourceGen<Base>::generateJacobianSource(MultiThreadingType multiThreadingType) {
     using std::vector;
 
     const std::string jobName = "Jacobian";
@@ -28,6 +28,9 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+    handler.setReduceOperationStrength(_reduceOperationStrength);
+    handler.setStrictFloatingPoint(_strictFloatingPoint);
 
     vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -53,9 +56,12 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setSourceSink(_sourceSink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
+    prepareParallelTasks(handler, langC, multiThreadingType);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
@@ -110,6 +116,9 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+    handler.setReduceOperationStrength(_reduceOperationStrength);
+    handler.setStrictFloatingPoint(_strictFloatingPoint);
 
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
@@ -123,10 +132,11 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
     if (_loopTapes.empty()) {
         //printSparsityPattern(_jacSparsity.sparsity, "jac sparsity");
         CppAD::sparse_jacobian_work work;
+        const SparsitySetType jacSparsitySet = _jacSparsity.sparsity.toSet(); // only used by CppAD
         if (forward) {
-            _fun.SparseJacobianForward(indVars, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jac, work);
+            _fun.SparseJacobianForward(indVars, jacSparsitySet, _jacSparsity.rows, _jacSparsity.cols, jac, work);
         } else {
-            _fun.SparseJacobianReverse(indVars, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jac, work);
+            _fun.SparseJacobianReverse(indVars, jacSparsitySet, _jacSparsity.rows, _jacSparsity.cols, jac, work);
         }
 
     } else {
@@ -137,8 +147,10 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setSourceSink(_sourceSink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
 
     std::ostringstream code;
@@ -261,28 +273,47 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevSingleThreadSourc
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
 
+    const std::string& sharedName = forward ? FUNCTION_SPARSE_FORWARD_ONE_SHARED : FUNCTION_SPARSE_REVERSE_ONE_SHARED;
+    size_t nShared = getSharedValuesSize(sharedName);
+
     _cache.str("");
-    _cache << "#include <stdlib.h>\n"
-            "\n"
+    _cache << "#include <stdlib.h>\n";
+    if (nShared > 0) {
+        _cache << "#include <stdio.h>\n";
+    }
+    _cache << "\n"
            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
     generateFunctionDeclarationSource(_cache, functionRevFor, revForSuffix, jacInfo, argsDcl);
+    if (nShared > 0) {
+        _cache << "void " << _name << "_" << sharedName << "(" << argsDcl << ");\n";
+    }
     _cache << "\n";
     LanguageC<Base>::printFunctionDeclaration(_cache, "void", functionName, argsDcl2);
     _cache << " {\n"
-              "   " << _baseTypeName << " const * inLocal[2];\n"
+              "   " << _baseTypeName << " const * inLocal[" << (nShared > 0 ? 3 : 2) << "];\n"
               "   " << _baseTypeName << " inLocal1 = 1;\n"
               "   " << _baseTypeName << " * outLocal[1];\n"
-              "   " << _baseTypeName << " compressed[" << maxCompressedSize << "];\n"
-              "   " << _baseTypeName << " * jac = out[0];\n"
+              "   " << _baseTypeName << " compressed[" << maxCompressedSize << "];\n";
+    if (nShared > 0) {
+        printSharedValuesDeclaration(_cache, nShared);
+    }
+    _cache << "   " << _baseTypeName << " * jac = out[0];\n"
               "\n"
               "   inLocal[0] = in[0];\n"
-              "   inLocal[1] = &inLocal1;\n"
-              "   outLocal[0] = compressed;\n";
+              "   inLocal[1] = &inLocal1;\n";
 
     langC.setArgumentIn("inLocal");
     langC.setArgumentOut("outLocal");
     std::string argsLocal = langC.generateDefaultFunctionArguments();
 
+    if (nShared > 0) {
+        printSharedValuesCheck(_cache, functionName);
+        _cache << "   inLocal[2] = shared;\n"
+                  "   outLocal[0] = shared;\n"
+                  "   " << _name << "_" << sharedName << "(" << argsLocal << ");\n";
+    }
+    _cache << "   outLocal[0] = compressed;\n";
+
     bool previousCompressed = true;
     for (const auto& it : jacInfo) {
         size_t index = it.first;
@@ -310,6 +341,10 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevSingleThreadSourc
         previousCompressed = compressed;
     }
 
+    if (nShared > 0) {
+        _cache << "\n"
+                  "   free(shared);\n";
+    }
     _cache << "\n"
             "}\n";
 
@@ -328,11 +363,18 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
 
+    const std::string& sharedName = forward ? FUNCTION_SPARSE_FORWARD_ONE_SHARED : FUNCTION_SPARSE_REVERSE_ONE_SHARED;
+    size_t nShared = getSharedValuesSize(sharedName);
+
     _cache.str("");
     _cache << "#include <stdlib.h>\n"
-            "\n"
+           << (nShared > 0 ? "#include <stdio.h>\n" : "")
+           << "\n"
            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
     generateFunctionDeclarationSource(_cache, functionRevFor, revForSuffix, jacInfo, argsDcl);
+    if (nShared > 0) {
+        _cache << "void " << _name << "_" << sharedName << "(" << argsDcl << ");\n";
+    }
 
     langC.setArgumentIn("inLocal");
     langC.setArgumentOut("outLocal");
@@ -355,15 +397,18 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         std::string functionNameWrap = functionRevFor + "_" + revForSuffix + std::to_string(index) + "_wrap";
         LanguageC<Base>::printFunctionDeclaration(_cache, "void", functionNameWrap, argsDcl2);
         _cache << " {\n"
-                "   " << _baseTypeName << " const * inLocal[2];\n"
+                "   " << _baseTypeName << " const * inLocal[" << (nShared > 0 ? 3 : 2) << "];\n"
                         "   " << _baseTypeName << " inLocal1 = 1;\n"
                         "   " << _baseTypeName << " * outLocal[1];\n"
                         "   " << _baseTypeName << " compressed[" << it.second.indexes.size() << "];\n"
                         "   " << _baseTypeName << " * jac = out[0];\n"
                         "\n"
                         "   inLocal[0] = in[0];\n"
-                        "   inLocal[1] = &inLocal1;\n"
-                        "   outLocal[0] = compressed;\n";
+                        "   inLocal[1] = &inLocal1;\n";
+        if (nShared > 0) {
+            _cache << "   inLocal[2] = in[2];\n";
+        }
+        _cache << "   outLocal[0] = compressed;\n";
 
         _cache << "   " << functionRevFor << "_" << revForSuffix << index << "(" << argsLocal << ");\n";
         for (size_t e = 0; e < els.size(); e++) {
@@ -419,16 +464,36 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         }
     }
     _cache << "};\n"
-            "   " << _baseTypeName << " inLocal1 = 1;\n"
-            "   " << _baseTypeName << " const * inLocal[2] = {in[0], &inLocal1};\n"
-            "   " << _baseTypeName << " * outLocal[1];\n"
+            "   " << _baseTypeName << " inLocal1 = 1;\n";
+    if (nShared > 0) {
+        printSharedValuesDeclaration(_cache, nShared);
+        _cache << "   " << _baseTypeName << " const * inLocal[3] = {in[0], &inLocal1, shared};\n";
+    } else {
+        _cache << "   " << _baseTypeName << " const * inLocal[2] = {in[0], &inLocal1};\n";
+    }
+    _cache << "   " << _baseTypeName << " * outLocal[1];\n"
             "   " << _baseTypeName << " * jac = out[0];\n"
             "   long i;\n"
             "\n";
 
+    // the shared values are evaluated before starting the threads
+    std::string sharedCall;
+    if (nShared > 0) {
+        sharedCall = "   outLocal[0] = shared;\n"
+                     "   " + _name + "_" + sharedName + "(" + argsLocal + ");\n"
+                     "\n";
+    }
+    std::ostringstream sharedCheck;
+
     if(multiThreadingType == MultiThreadingType::OPENMP) {
         printFunctionStartOpenMP(_cache, jacInfo.size());
-        _cache << "\n";
+        if (nShared > 0) {
+            printSharedValuesCheck(sharedCheck, functionName,
+                                   "      if(enabled) {\n"
+                                   "         omp_set_schedule(old_kind, old_modifier);\n"
+                                   "      }\n");
+        }
+        _cache << "\n" << sharedCheck.str() << sharedCall;
         printLoopStartOpenMP(_cache, jacInfo.size());
         _cache << "      outLocal[0] = &jac[offset[i]];\n"
                 "      (*p[i])(" << argsLocal << ");\n";
@@ -439,7 +504,10 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         assert(multiThreadingType == MultiThreadingType::PTHREADS);
 
         printFunctionStartPThreads(_cache, jacInfo.size());
-        _cache << "\n"
+        if (nShared > 0) {
+            printSharedValuesCheck(sharedCheck, functionName);
+        }
+        _cache << "\n" << sharedCheck.str() << sharedCall <<
                 "   for(i = 0; i < " << jacInfo.size() << "; ++i) {\n"
                 "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
                 "      args[i]->func = p[i];\n"
@@ -451,6 +519,10 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         printFunctionEndPThreads(_cache, jacInfo.size());
     }
 
+    if (nShared > 0) {
+        _cache << "\n"
+                "   free(shared);\n";
+    }
     _cache << "\n"
             "}\n";
 
@@ -459,14 +531,14 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
 
 template<class Base>
 void ModelCSourceGen<Base>::determineJacobianSparsity() {
-    if (_jacSparsity.sparsity.size() > 0) {
+    if (_jacSparsity.sparsity.rows() > 0) {
         return;
     }
 
     /**
      * Determine the sparsity pattern
      */
-    _jacSparsity.sparsity = jacobianSparsitySet<SparsitySetType, CGBase> (_fun);
+    _jacSparsity.sparsity = jacobianSparsityPattern(_fun);
 
     if (!_custom_jac.defined) {
         generateSparsityIndexes(_jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols);
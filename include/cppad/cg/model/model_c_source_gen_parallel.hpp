@@ -0,0 +1,217 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_PARALLEL_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_PARALLEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Generates the source code of directional functions using up to
+ * _maxParallelJobs threads.
+ * The functions in the same group share a code handler and therefore they
+ * are generated one after the other by the same thread.
+ * Different groups must use different code handlers.
+ *
+ * The sources are added to _sources in the order of the groups and progress
+ * is only reported from the calling thread.
+ *
+ * @param groups the directional functions (grouped by code handler)
+ * @param generate generates the source code of a single function
+ */
+template<class Base>
+void ModelCSourceGen<Base>::generateDirectionalSources(std::vector<std::vector<DirectionalFunction> >& groups,
+                                                       const DirectionalCodeGenerator& generate) {
+    using namespace std::chrono;
+
+    auto createLanguage = [this](const DirectionalFunction& f,
+                                 std::map<std::string, std::string>& sources) {
+        std::unique_ptr<LanguageC<Base> > langC(new LanguageC<Base>(_baseTypeName));
+        langC->setMaxAssignmentsPerFunction(_maxAssignPerFunc, &sources);
+        langC->setSourceSink(_sourceSink);
+        langC->setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC->setParameterPrecision(_parameterPrecision);
+        langC->setDirectAtomicFunctions(_directAtomicFunctions);
+        langC->setGenerateFunction(f.name);
+        return langC;
+    };
+
+    const size_t nThreads = std::min<size_t>(_maxParallelJobs, groups.size());
+
+    if (nThreads <= 1) {
+        for (std::vector<DirectionalFunction>& group : groups) {
+            for (DirectionalFunction& f : group) {
+                f.handler->setJobTimer(_jobTimer);
+                std::unique_ptr<LanguageC<Base> > langC = createLanguage(f, _sources);
+                generate(f, *langC, _atomicFunctions);
+            }
+        }
+        return;
+    }
+
+    /**
+     * the atomic functions must have the same index in all the functions
+     */
+    for (const std::vector<DirectionalFunction>& group : groups) {
+        for (const DirectionalFunction& f : group) {
+            for (const auto& it : f.handler->getAtomicFunctions()) {
+                const std::string& atomicName = it.second->afun_name();
+                if (std::find(_atomicFunctions.begin(), _atomicFunctions.end(), atomicName) == _atomicFunctions.end())
+                    _atomicFunctions.push_back(atomicName);
+            }
+        }
+    }
+
+    /**
+     * A group of functions generated by a worker thread
+     */
+    struct GroupJob {
+        std::map<std::string, std::string> sources;
+        std::vector<std::string> atomicFunctions;
+    };
+
+    /**
+     * A function whose source code was generated
+     */
+    struct FinishedFunction {
+        const DirectionalFunction* function;
+        steady_clock::time_point beginTime;
+    };
+
+    std::vector<GroupJob> jobs(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        jobs[g].atomicFunctions = _atomicFunctions;
+        for (DirectionalFunction& f : groups[g]) {
+            f.handler->setJobTimer(nullptr); // a job timer cannot be used by several threads
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable finishedCond;
+    std::deque<FinishedFunction> finished; // generated functions not yet reported
+    size_t next = 0; // the next group to start
+    size_t running = nThreads;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        while (true) {
+            size_t g;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (next == groups.size() || error != nullptr)
+                    break;
+                g = next++;
+            }
+
+            GroupJob& job = jobs[g];
+            for (DirectionalFunction& f : groups[g]) {
+                FinishedFunction done{&f, steady_clock::now()};
+                try {
+                    std::unique_ptr<LanguageC<Base> > langC = createLanguage(f, job.sources);
+                    generate(f, *langC, job.atomicFunctions);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (error == nullptr)
+                        error = std::current_exception();
+                    break;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.push_back(done);
+                finishedCond.notify_one();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running--;
+        finishedCond.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back(worker);
+    }
+
+    // report progress from the calling thread only
+    while (true) {
+        FinishedFunction done;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finishedCond.wait(lock, [&] { return !finished.empty() || running == 0; });
+            if (finished.empty())
+                break; // all threads finished
+            done = finished.front();
+            finished.pop_front();
+        }
+
+        if (_jobTimer != nullptr) {
+            _jobTimer->completedJob("source for '" + done.function->jobName + "'", JobTypeHolder<>::DEFAULT, "", done.beginTime);
+        }
+    }
+
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    for (GroupJob& job : jobs) {
+        CPPADCG_ASSERT_UNKNOWN(job.atomicFunctions.size() == _atomicFunctions.size())
+        for (auto& it : job.sources) {
+            _sources[it.first] = std::move(it.second);
+        }
+    }
+}
+
+/**
+ * Splits the directions (e.g. the columns of the Jacobian for the forward
+ * mode) into groups of consecutive directions with a similar number of
+ * elements.
+ *
+ * @param elements the elements of each direction
+ * @param nGroups the maximum number of groups
+ * @return the elements of each direction in each group (no empty groups)
+ */
+template<class Base>
+inline std::vector<std::map<size_t, std::vector<size_t> > > ModelCSourceGen<Base>::splitDirections(const std::map<size_t, std::vector<size_t> >& elements,
+                                                                                                    size_t nGroups) {
+    nGroups = std::max<size_t>(1, std::min(nGroups, elements.size()));
+
+    size_t nnz = 0;
+    for (const auto& it : elements) {
+        nnz += it.second.size();
+    }
+
+    std::vector<std::map<size_t, std::vector<size_t> > > groups(1);
+
+    size_t nnzGroup = 0; // the number of elements in the previous groups and the current group
+    for (const auto& it : elements) {
+        if (nnzGroup * nGroups >= nnz * groups.size() && !groups.back().empty() && groups.size() < nGroups) {
+            groups.emplace_back();
+        }
+        groups.back().insert(it);
+        nnzGroup += it.second.size();
+    }
+
+    return groups;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
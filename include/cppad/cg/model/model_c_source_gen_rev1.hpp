@@ -76,6 +76,23 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
     const std::string jobName = "model (reverse one)";
     startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
 
+    auto generate = [this, n](DirectionalFunction& f,
+                              LanguageC<Base>& langC,
+                              std::vector<std::string>& atomicFunctions) {
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+
+        f.handler->generateCode(code, langC, f.dependents, nameGenHess, atomicFunctions, f.jobName);
+    };
+
+    /**
+     * the tapes are always recorded by this thread but the source code of
+     * up to _maxParallelJobs directions can be generated at the same time
+     */
+    std::vector<std::unique_ptr<CodeHandler<Base> > > handlers;
+    std::vector<std::vector<DirectionalFunction> > groups;
+
     for (const auto& it : elements) {
         size_t i = it.first;
         const std::vector<size_t>& cols = it.second;
@@ -86,8 +103,12 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
 
         startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
-        CodeHandler<Base> handler;
+        handlers.emplace_back(new CodeHandler<Base>());
+        CodeHandler<Base>& handler = *handlers.back();
         handler.setJobTimer(_jobTimer);
+        handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+        handler.setReduceOperationStrength(_reduceOperationStrength);
+        handler.setStrictFloatingPoint(_strictFloatingPoint);
 
         vector<CGBase> indVars(_fun.Domain());
         handler.makeVariables(indVars);
@@ -118,20 +139,18 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
 
         finishedJob();
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
-        langC.setGenerateFunction(_cache.str());
+        groups.push_back({DirectionalFunction{&handler, std::move(dwCustom), _cache.str(), subJobName}});
 
-        std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
-
-        handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
+        if (groups.size() == _maxParallelJobs) {
+            generateDirectionalSources(groups, generate);
+            groups.clear();
+            handlers.clear();
+        }
     }
+
+    generateDirectionalSources(groups, generate);
 }
 
 template<class Base>
@@ -144,82 +163,150 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    /**
+     * the directions are recorded in groups (one per thread) so that their
+     * source code can be generated at the same time, unless the values
+     * used by several directions must be computed in a single function
+     */
+    std::vector<std::map<size_t, std::vector<size_t> > > groupElements;
+    if (_shareZeroOrderSweep || _maxParallelJobs == 1) {
+        groupElements.push_back(elements);
+    } else {
+        groupElements = splitDirections(elements, _maxParallelJobs);
+    }
+
+    std::vector<std::unique_ptr<CodeHandler<Base> > > handlers;
+    std::vector<std::vector<DirectionalFunction> > groups;
+    std::vector<CGBase> shared;
+
+    // the set-based representation required by CppAD is shared by all groups
+    const SparsitySetType jacSparsitySet = _jacSparsity.sparsity.toSet();
+
+    _sharedValuesSize.erase(FUNCTION_SPARSE_REVERSE_ONE_SHARED);
 
-    vector<CGBase> x(n);
-    handler.makeVariables(x);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            x[i].setValue(_x[i]);
+    for (const auto& groupElem : groupElements) {
+        handlers.emplace_back(new CodeHandler<Base>());
+        CodeHandler<Base>& handler = *handlers.back();
+        handler.setJobTimer(_jobTimer);
+        handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+        handler.setReduceOperationStrength(_reduceOperationStrength);
+        handler.setStrictFloatingPoint(_strictFloatingPoint);
+
+        vector<CGBase> x(n);
+        handler.makeVariables(x);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                x[i].setValue(_x[i]);
+            }
         }
-    }
 
-    CGBase py;
-    handler.makeVariable(py);
-    if (_x.size() > 0) {
-        py.setValue(Base(1.0));
-    }
+        CGBase py;
+        handler.makeVariable(py);
+        if (_x.size() > 0) {
+            py.setValue(Base(1.0));
+        }
 
-    vector<CGBase> jacFlat(_jacSparsity.rows.size());
+        /**
+         * the Jacobian elements of the directions in this group
+         */
+        std::vector<size_t> rows, cols;
+        for (size_t el = 0; el < _jacSparsity.rows.size(); el++) {
+            if (groupElem.find(_jacSparsity.rows[el]) != groupElem.end()) {
+                rows.push_back(_jacSparsity.rows[el]);
+                cols.push_back(_jacSparsity.cols[el]);
+            }
+        }
 
-    CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-    _fun.SparseJacobianReverse(x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jacFlat, work);
+        vector<CGBase> jacFlat(rows.size());
 
-    /**
-     * organize results
-     */
-    std::map<size_t, vector<CGBase> > jac; // by row
-    std::vector<std::map<size_t, size_t> > positions(m); // by row
+        CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
+        _fun.SparseJacobianReverse(x, jacSparsitySet, rows, cols, jacFlat, work);
 
-    for (const auto& it : elements) {
-        size_t i = it.first;
-        const std::vector<size_t>& row = it.second;
+        /**
+         * organize results
+         */
+        std::map<size_t, vector<CGBase> > jac; // by row
+        std::vector<std::map<size_t, size_t> > positions(m); // by row
+
+        for (const auto& it : groupElem) {
+            size_t i = it.first;
+            const std::vector<size_t>& row = it.second;
 
-        jac[i].resize(row.size());
-        std::map<size_t, size_t>& pos = positions[i];
+            jac[i].resize(row.size());
+            std::map<size_t, size_t>& pos = positions[i];
 
-        for (size_t e = 0; e < row.size(); e++) {
-            size_t j = row[e];
-            pos[j] = e;
+            for (size_t e = 0; e < row.size(); e++) {
+                size_t j = row[e];
+                pos[j] = e;
+            }
+        }
+
+        for (size_t el = 0; el < rows.size(); el++) {
+            size_t i = rows[el];
+            size_t j = cols[el];
+            size_t e = positions[i].at(j);
+
+            vector<CGBase>& row = jac[i];
+            row[e] = jacFlat[el];
+        }
+
+        /**
+         * Values used by several equations/rows
+         */
+        if (_shareZeroOrderSweep) {
+            shared = determineSharedValues(handler, jac);
+        }
+
+        if (!shared.empty()) {
+            std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("sh"));
+            LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+
+            generateSharedValuesSource(handler, FUNCTION_SPARSE_REVERSE_ONE_SHARED, shared, nameGenHess,
+                                       "model (reverse one, shared)");
         }
-    }
 
-    for (size_t el = 0; el < _jacSparsity.rows.size(); el++) {
-        size_t i = _jacSparsity.rows[el];
-        size_t j = _jacSparsity.cols[el];
-        size_t e = positions[i].at(j);
+        /**
+         * The functions for each equation/row
+         */
+        groups.emplace_back();
+        for (auto& itI : jac) {
+            size_t i = itI.first;
+            vector<CGBase>& dwCustom = itI.second;
+            for (CGBase& dw : dwCustom) {
+                dw *= py;
+            }
 
-        vector<CGBase>& row = jac[i];
-        row[e] = jacFlat[el] * py;
+            _cache.str("");
+            _cache << "model (reverse one, dep " << i << ")";
+            const std::string subJobName = _cache.str();
+
+            _cache.str("");
+            _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
+            groups.back().push_back(DirectionalFunction{&handler, std::move(dwCustom), _cache.str(), subJobName});
+        }
     }
 
     /**
      * Create source for each equation/row
      */
-    typename std::map<size_t, vector<CGBase> >::iterator itI;
-    for (itI = jac.begin(); itI != jac.end(); ++itI) {
-        size_t i = itI->first;
-        vector<CGBase>& dwCustom = itI->second;
-
-        _cache.str("");
-        _cache << "model (reverse one, dep " << i << ")";
-        const std::string subJobName = _cache.str();
-
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
-        _cache.str("");
-        _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
-        langC.setGenerateFunction(_cache.str());
-
+    const bool useShared = !shared.empty();
+    auto generate = [this, n, useShared](DirectionalFunction& f,
+                                         LanguageC<Base>& langC,
+                                         std::vector<std::string>& atomicFunctions) {
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+        // the shared values are provided in an additional input array
+        LangCDefaultHessianVarNameGenerator<Base> nameGenShared(&nameGenHess, "sh", n + 1);
 
-        handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
-    }
+        if (useShared) {
+            f.handler->generateCode(code, langC, f.dependents, nameGenShared, atomicFunctions, f.jobName);
+        } else {
+            f.handler->generateCode(code, langC, f.dependents, nameGenHess, atomicFunctions, f.jobName);
+        }
+    };
+
+    generateDirectionalSources(groups, generate);
 }
 
 template<class Base>
@@ -236,12 +323,18 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::string args = langC.generateDefaultFunctionArguments();
 
+    size_t nShared = getSharedValuesSize(FUNCTION_SPARSE_REVERSE_ONE_SHARED);
+    std::string sharedFunction = _name + "_" + FUNCTION_SPARSE_REVERSE_ONE_SHARED;
+
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
             "\n"
             "int " << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "(unsigned long pos, " << argsDcl << ");\n"
-            "void " << _name << "_" << FUNCTION_REVERSE_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n"
-            "\n";
+            "void " << _name << "_" << FUNCTION_REVERSE_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+    if (nShared > 0) {
+        _cache << "void " << sharedFunction << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
     LanguageC<Base>::printFunctionDeclaration(_cache, "int", model_function, {_baseTypeName + " const x[]",
                                                                               _baseTypeName + " const ty[]",
                                                                               _baseTypeName + " px[]",
@@ -253,9 +346,12 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "   unsigned long* pyPos;\n"
             "   unsigned long* pyPosTmp;\n"
             "   unsigned long nnzPy;\n"
-            "   " << _baseTypeName << " const * in[2];\n"
-            "   " << _baseTypeName << "* out[1];\n"
-            "   " << _baseTypeName << "* compressed;\n"
+            "   " << _baseTypeName << " const * in[" << (nShared > 0 ? 3 : 2) << "];\n"
+            "   " << _baseTypeName << "* out[1];\n";
+    if (nShared > 0) {
+        _cache << "   " << _baseTypeName << "* shared;\n";
+    }
+    _cache << "   " << _baseTypeName << "* compressed;\n"
             "   int ret;\n"
             "\n"
             "   pyPos = 0;\n"
@@ -288,9 +384,26 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "      return 0; //nothing to do\n"
             "   }\n"
             "\n"
-            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n"
-            "\n"
-            "   for (ei = 0; ei < nnzPy; ei++) {\n"
+            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n";
+    if (nShared > 0) {
+        _cache << "   shared = (" << _baseTypeName << "*) malloc(" << nShared << " * sizeof(" << _baseTypeName << "));\n"
+                "   if (compressed == NULL || shared == NULL) {\n"
+                "      free(compressed);\n"
+                "      free(shared);\n"
+                "      free(pyPos);\n"
+                "      return -1; // failure to allocate memory\n"
+                "   }\n";
+    }
+    _cache << "\n";
+    if (nShared > 0) {
+        _cache << "   in[0] = x;\n"
+                "   in[1] = &py[pyPos[0]];\n"
+                "   in[2] = shared;\n"
+                "   out[0] = shared;\n"
+                "   " << sharedFunction << "(" << args << ");\n"
+                "\n";
+    }
+    _cache << "   for (ei = 0; ei < nnzPy; ei++) {\n"
             "      i = pyPos[ei];\n"
             "      " << _name << "_" << FUNCTION_REVERSE_ONE_SPARSITY << "(i, &pos, &nnz);\n"
             "\n"
@@ -306,8 +419,11 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "\n"
             "      if (ret != 0) {\n"
             "         free(compressed);\n"
-            "         free(pyPos);\n"
-            "         return ret;\n"
+            "         free(pyPos);\n";
+    if (nShared > 0) {
+        _cache << "         free(shared);\n";
+    }
+    _cache << "         return ret;\n"
             "      }\n"
             "\n"
             "      for (ePos = 0; ePos < nnz; ePos++) {\n"
@@ -316,8 +432,11 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "\n"
             "   }\n"
             "   free(compressed);\n"
-            "   free(pyPos);\n"
-            "   return 0;\n"
+            "   free(pyPos);\n";
+    if (nShared > 0) {
+        _cache << "   free(shared);\n";
+    }
+    _cache << "   return 0;\n"
             "}\n";
     _sources[model_function + ".c"] = _cache.str();
     _cache.str("");
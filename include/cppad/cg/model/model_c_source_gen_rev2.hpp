@@ -76,6 +76,23 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
     vector<CGBase> tx1v(n);
 
+    auto generate = [this, n](DirectionalFunction& f,
+                              LanguageC<Base>& langC,
+                              std::vector<std::string>& atomicFunctions) {
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
+        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+
+        f.handler->generateCode(code, langC, f.dependents, nameGenRev2, atomicFunctions, f.jobName);
+    };
+
+    /**
+     * the tapes are always recorded by this thread but the source code of
+     * up to _maxParallelJobs directions can be generated at the same time
+     */
+    std::vector<std::unique_ptr<CodeHandler<Base> > > handlers;
+    std::vector<std::vector<DirectionalFunction> > groups;
+
     for (const auto& it : elements) {
         size_t j = it.first;
         const std::vector<size_t>& cols = it.second;
@@ -86,8 +103,12 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
         startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
-        CodeHandler<Base> handler;
+        handlers.emplace_back(new CodeHandler<Base>());
+        CodeHandler<Base>& handler = *handlers.back();
         handler.setJobTimer(_jobTimer);
+        handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+        handler.setReduceOperationStrength(_reduceOperationStrength);
+        handler.setStrictFloatingPoint(_strictFloatingPoint);
 
         vector<CGBase> tx0(n);
         handler.makeVariables(tx0);
@@ -126,20 +147,18 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
         finishedJob();
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
-        langC.setGenerateFunction(_cache.str());
-
-        std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
-        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+        groups.push_back({DirectionalFunction{&handler, std::move(pxCustom), _cache.str(), subJobName}});
 
-        handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        if (groups.size() == _maxParallelJobs) {
+            generateDirectionalSources(groups, generate);
+            groups.clear();
+            handlers.clear();
+        }
     }
+
+    generateDirectionalSources(groups, generate);
 }
 
 template<class Base>
@@ -164,85 +183,151 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         }
     }
 
-    // we can use a new handler to reduce memory usage
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
+    /**
+     * the directions are recorded in groups (one per thread) so that their
+     * source code can be generated at the same time, unless the values
+     * used by several directions must be computed in a single function
+     */
+    std::vector<std::map<size_t, std::vector<size_t> > > groupElements;
+    if (_shareZeroOrderSweep || _maxParallelJobs == 1) {
+        groupElements.push_back(elements);
+    } else {
+        groupElements = splitDirections(elements, _maxParallelJobs);
+    }
+
+    std::vector<std::unique_ptr<CodeHandler<Base> > > handlers;
+    std::vector<std::vector<DirectionalFunction> > groups;
+    std::vector<CGBase> shared;
+
+    // the set-based representation required by CppAD is shared by all groups
+    const SparsitySetType hessSparsitySet = _hessSparsity.sparsity.toSet();
+
+    _sharedValuesSize.erase(FUNCTION_SPARSE_REVERSE_TWO_SHARED);
+
+    for (const auto& groupElem : groupElements) {
+        // we can use a new handler to reduce memory usage
+        handlers.emplace_back(new CodeHandler<Base>());
+        CodeHandler<Base>& handler = *handlers.back();
+        handler.setJobTimer(_jobTimer);
+        handler.setEliminateCommonSubexpressions(_eliminateCommonSubexpressions);
+        handler.setReduceOperationStrength(_reduceOperationStrength);
+        handler.setStrictFloatingPoint(_strictFloatingPoint);
 
-    vector<CGBase> tx0(n);
-    handler.makeVariables(tx0);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            tx0[i].setValue(_x[i]);
+        vector<CGBase> tx0(n);
+        handler.makeVariables(tx0);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                tx0[i].setValue(_x[i]);
+            }
         }
-    }
 
-    CGBase tx1;
-    handler.makeVariable(tx1);
-    if (_x.size() > 0) {
-        tx1.setValue(Base(1.0));
-    }
+        CGBase tx1;
+        handler.makeVariable(tx1);
+        if (_x.size() > 0) {
+            tx1.setValue(Base(1.0));
+        }
 
-    vector<CGBase> py(m); // (k+1)*m is not used because we are not interested in all values
-    handler.makeVariables(py);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < m; i++) {
-            py[i].setValue(Base(1.0));
+        vector<CGBase> py(m); // (k+1)*m is not used because we are not interested in all values
+        handler.makeVariables(py);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < m; i++) {
+                py[i].setValue(Base(1.0));
+            }
+        }
+
+        /**
+         * the Hessian elements of the directions in this group
+         */
+        std::vector<size_t> rows, cols;
+        for (size_t el = 0; el < evalRows.size(); el++) {
+            if (groupElem.find(evalRows[el]) != groupElem.end()) {
+                rows.push_back(evalRows[el]);
+                cols.push_back(evalCols[el]);
+            }
         }
-    }
 
-    vector<CGBase> hessFlat(evalRows.size());
+        vector<CGBase> hessFlat(rows.size());
 
-    CppAD::sparse_hessian_work work; // temporary structure for CPPAD
-    // "cppad.symmetric" may have missing values for functions using atomic 
-    // functions which only provide half of the elements, but there is none here
-    work.color_method = "cppad.symmetric";
-    _fun.SparseHessian(tx0, py, _hessSparsity.sparsity, evalRows, evalCols, hessFlat, work);
+        CppAD::sparse_hessian_work work; // temporary structure for CPPAD
+        // "cppad.symmetric" may have missing values for functions using atomic
+        // functions which only provide half of the elements, but there is none here
+        work.color_method = "cppad.symmetric";
+        _fun.SparseHessian(tx0, py, hessSparsitySet, rows, cols, hessFlat, work);
 
-    std::map<size_t, vector<CGBase> > hess;
-    for (const auto& itJ1 : elements) {
-        size_t j1 = itJ1.first;
-        hess[j1].resize(itJ1.second.size());
-    }
+        std::map<size_t, vector<CGBase> > hess;
+        for (const auto& itJ1 : groupElem) {
+            size_t j1 = itJ1.first;
+            hess[j1].resize(itJ1.second.size());
+        }
 
-    // organize hessian elements
-    for (size_t el = 0; el < evalRows.size(); el++) {
-        size_t j1 = evalRows[el];
-        size_t j2 = evalCols[el];
-        size_t e = positions[j1][j2];
+        // organize hessian elements
+        for (size_t el = 0; el < rows.size(); el++) {
+            size_t j1 = rows[el];
+            size_t j2 = cols[el];
+            size_t e = positions[j1][j2];
 
-        hess[j1][e] = hessFlat[el];
-    }
+            hess[j1][e] = hessFlat[el];
+        }
 
-    /**
-     * Generate one function for each independent variable
-     */
-    for (const auto& it : hess) {
-        size_t j = it.first;
-        const vector<CGBase>& row = it.second;
+        /**
+         * Values used by several independents/rows
+         */
+        if (_shareZeroOrderSweep) {
+            shared = determineSharedValues(handler, hess);
+        }
 
-        _cache.str("");
-        _cache << "model (reverse two, indep " << j << ")";
-        const std::string subJobName = _cache.str();
+        if (!shared.empty()) {
+            std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("sh"));
+            LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
-        vector<CGBase> pxCustom(row.size());
-        for (size_t e = 0; e < row.size(); e++) {
-            pxCustom[e] = row[e] * tx1;
+            generateSharedValuesSource(handler, FUNCTION_SPARSE_REVERSE_TWO_SHARED, shared, nameGenRev2,
+                                       "model (reverse two, shared)");
         }
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
-        _cache.str("");
-        _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
-        langC.setGenerateFunction(_cache.str());
+        /**
+         * One function for each independent variable
+         */
+        groups.emplace_back();
+        for (const auto& it : hess) {
+            size_t j = it.first;
+            const vector<CGBase>& row = it.second;
+
+            _cache.str("");
+            _cache << "model (reverse two, indep " << j << ")";
+            const std::string subJobName = _cache.str();
+
+            vector<CGBase> pxCustom(row.size());
+            for (size_t e = 0; e < row.size(); e++) {
+                pxCustom[e] = row[e] * tx1;
+            }
+
+            _cache.str("");
+            _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
+            groups.back().push_back(DirectionalFunction{&handler, std::move(pxCustom), _cache.str(), subJobName});
+        }
+    }
 
+    /**
+     * Generate one function for each independent variable
+     */
+    const bool useShared = !shared.empty();
+    auto generate = [this, n, m, useShared](DirectionalFunction& f,
+                                            LanguageC<Base>& langC,
+                                            std::vector<std::string>& atomicFunctions) {
         std::ostringstream code;
         std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+        // the shared values are provided in an additional input array
+        LangCDefaultHessianVarNameGenerator<Base> nameGenShared(&nameGenRev2, "sh", n + 1 + m);
 
-        handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
-    }
+        if (useShared) {
+            f.handler->generateCode(code, langC, f.dependents, nameGenShared, atomicFunctions, f.jobName);
+        } else {
+            f.handler->generateCode(code, langC, f.dependents, nameGenRev2, atomicFunctions, f.jobName);
+        }
+    };
+
+    generateDirectionalSources(groups, generate);
 }
 
 template<class Base>
@@ -259,12 +344,18 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
     std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
     std::string args = langC.generateDefaultFunctionArguments();
 
+    size_t nShared = getSharedValuesSize(FUNCTION_SPARSE_REVERSE_TWO_SHARED);
+    std::string sharedFunction = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO_SHARED;
+
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
             "\n"
             "int " << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "(unsigned long pos, " << argsDcl << ");\n"
-            "void " << _name << "_" << FUNCTION_REVERSE_TWO_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n"
-            "\n";
+            "void " << _name << "_" << FUNCTION_REVERSE_TWO_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+    if (nShared > 0) {
+        _cache << "void " << sharedFunction << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
     LanguageC<Base>::printFunctionDeclaration(_cache, "int", model_function, {_baseTypeName + " const tx[]",
                                                                               _baseTypeName + " const ty[]",
                                                                               _baseTypeName + " px[]",
@@ -276,11 +367,14 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "    unsigned long* txPos;\n"
             "    unsigned long* txPosTmp;\n"
             "    unsigned long nnzTx;\n"
-            "    " << _baseTypeName << " const * in[3];\n"
+            "    " << _baseTypeName << " const * in[" << (nShared > 0 ? 4 : 3) << "];\n"
             "    " << _baseTypeName << "* out[1];\n"
             "    " << _baseTypeName << " x[" << n << "];\n"
-            "    " << _baseTypeName << " w[" << m << "];\n"
-            "    " << _baseTypeName << "* compressed;\n"
+            "    " << _baseTypeName << " w[" << m << "];\n";
+    if (nShared > 0) {
+        _cache << "    " << _baseTypeName << "* shared;\n";
+    }
+    _cache << "    " << _baseTypeName << "* compressed;\n"
             "    int nonZeroW;\n"
             "    int ret;\n"
             "\n"
@@ -330,9 +424,27 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "    for (j = 0; j < " << n << "; j++)\n"
             "        x[j] = tx[j * 2];\n"
             "\n"
-            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n"
-            "\n"
-            "   for (ej = 0; ej < nnzTx; ej++) {\n"
+            "   compressed = (" << _baseTypeName << "*) malloc(nnzMax * sizeof(" << _baseTypeName << "));\n";
+    if (nShared > 0) {
+        _cache << "   shared = (" << _baseTypeName << "*) malloc(" << nShared << " * sizeof(" << _baseTypeName << "));\n"
+                "   if (compressed == NULL || shared == NULL) {\n"
+                "      free(compressed);\n"
+                "      free(shared);\n"
+                "      free(txPos);\n"
+                "      return -1; // failure to allocate memory\n"
+                "   }\n";
+    }
+    _cache << "\n";
+    if (nShared > 0) {
+        _cache << "   in[0] = x;\n"
+                "   in[1] = &tx[txPos[0] * 2 + 1];\n"
+                "   in[2] = w;\n"
+                "   in[3] = shared;\n"
+                "   out[0] = shared;\n"
+                "   " << sharedFunction << "(" << args << ");\n"
+                "\n";
+    }
+    _cache << "   for (ej = 0; ej < nnzTx; ej++) {\n"
             "      j = txPos[ej];\n"
             "      " << _name << "_" << FUNCTION_REVERSE_TWO_SPARSITY << "(j, &pos, &nnz);\n"
             "\n"
@@ -349,8 +461,11 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "\n"
             "      if (ret != 0) {\n"
             "         free(compressed);\n"
-            "         free(txPos);\n"
-            "         return ret;\n"
+            "         free(txPos);\n";
+    if (nShared > 0) {
+        _cache << "         free(shared);\n";
+    }
+    _cache << "         return ret;\n"
             "      }\n"
             "\n"
             "      for (ePos = 0; ePos < nnz; ePos++) {\n"
@@ -359,8 +474,11 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "\n"
             "   }\n"
             "   free(compressed);\n"
-            "   free(txPos);\n"
-            "   return 0;\n"
+            "   free(txPos);\n";
+    if (nShared > 0) {
+        _cache << "   free(shared);\n";
+    }
+    _cache << "   return 0;\n"
             "};\n";
 
     _sources[model_function + ".c"] = _cache.str();
@@ -0,0 +1,239 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_SHARED_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_SHARED_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines the operations used by more than one directional function
+ * which must be evaluated in a separate function.
+ * Only the shared operations required by operations which are not shared
+ * (or by the directional functions directly) are returned.
+ *
+ * @param handler the code handler which owns all the operations
+ * @param directions the values computed by each directional function
+ *                   (they cannot depend on the direction)
+ * @return the values which should be computed once for all directions
+ *         (sorted by their position in the code handler)
+ */
+template<class Base>
+std::vector<CG<Base> > ModelCSourceGen<Base>::determineSharedValues(CodeHandler<Base>& handler,
+                                                                     const std::map<size_t, std::vector<CGBase> >& directions) {
+    using Node = OperationNode<Base>;
+
+    std::vector<CGBase> shared;
+    if (directions.size() < 2)
+        return shared;
+
+    const size_t nNodes = handler.getManagedNodesCount();
+    const size_t none = (std::numeric_limits<size_t>::max)();
+
+    /**
+     * count the number of directions which use each operation
+     */
+    std::vector<size_t> count(nNodes, 0);
+    std::vector<size_t> lastDirection(nNodes, none);
+    std::vector<Node*> reached;
+    std::vector<Node*> stack;
+
+    auto visit = [&](Node* node, size_t d) {
+        size_t pos = node->getHandlerPosition();
+        if (lastDirection[pos] == d)
+            return;
+        lastDirection[pos] = d;
+        if (count[pos] == 0)
+            reached.push_back(node);
+        count[pos]++;
+        stack.push_back(node);
+    };
+
+    size_t d = 0;
+    for (const auto& it : directions) {
+        for (const CGBase& v : it.second) {
+            if (v.getOperationNode() != nullptr)
+                visit(v.getOperationNode(), d);
+        }
+
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            for (const Argument<Base>& a : node->getArguments()) {
+                if (a.getOperation() != nullptr)
+                    visit(a.getOperation(), d);
+            }
+        }
+        d++;
+    }
+
+    auto isShared = [&](const Node& node) {
+        return count[node.getHandlerPosition()] > 1 && isShareableOperation(node.getOperationType());
+    };
+
+    /**
+     * the shared operations used by operations which are not shared
+     */
+    std::vector<bool> frontier(nNodes, false);
+
+    for (const auto& it : directions) {
+        for (const CGBase& v : it.second) {
+            Node* node = v.getOperationNode();
+            if (node != nullptr && isShared(*node))
+                frontier[node->getHandlerPosition()] = true;
+        }
+    }
+
+    for (Node* node : reached) {
+        if (isShared(*node))
+            continue;
+        for (const Argument<Base>& a : node->getArguments()) {
+            Node* arg = a.getOperation();
+            if (arg != nullptr && isShared(*arg))
+                frontier[arg->getHandlerPosition()] = true;
+        }
+    }
+
+    for (size_t pos = 0; pos < nNodes; ++pos) {
+        if (frontier[pos])
+            shared.push_back(CGBase(*handler.getManagedNodes()[pos]));
+    }
+
+    return shared;
+}
+
+/**
+ * Generates the function which computes the values shared by the
+ * directional functions and a function which provides the number of
+ * shared values.
+ * The shared operations are then replaced by new independent variables so
+ * that the directional functions generated afterwards with the same code
+ * handler read them from an additional input array.
+ *
+ * @param handler the code handler which owns all the operations
+ * @param function the name of the function with the shared values
+ *                 (without the model name)
+ * @param shared the values which should be computed once for all
+ *               directions (they become aliases of new independent
+ *               variables)
+ * @param nameGen the variable name generator for the shared function
+ *                (the same inputs as the directional functions)
+ * @param jobName the name of the job for the job timer
+ */
+template<class Base>
+void ModelCSourceGen<Base>::generateSharedValuesSource(CodeHandler<Base>& handler,
+                                                       const std::string& function,
+                                                       std::vector<CGBase>& shared,
+                                                       VariableNameGenerator<Base>& nameGen,
+                                                       const std::string& jobName) {
+    const std::string sharedFunction = _name + "_" + function;
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setSourceSink(_sourceSink);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
+    langC.setGenerateFunction(sharedFunction);
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, shared, nameGen, _atomicFunctions, jobName);
+
+    /**
+     * replace the shared operations with the new input array
+     */
+    std::vector<CGBase> values(shared.size());
+    handler.makeVariables(values);
+    for (size_t k = 0; k < shared.size(); ++k) {
+        shared[k].getOperationNode()->makeAlias(Argument<Base>(*values[k].getOperationNode()));
+    }
+
+    _sharedValuesSize[function] = shared.size();
+
+    /**
+     * the size of the shared array
+     */
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", sharedFunction + "_size", {"unsigned long* size"});
+    _cache << " {\n"
+            "   *size = " << shared.size() << ";\n"
+            "}\n";
+    _sources[sharedFunction + "_size.c"] = _cache.str();
+    _cache.str("");
+}
+
+/**
+ * @param function the name of the function with the shared values
+ *                 (without the model name)
+ * @return the number of values shared by the directional functions
+ *         (zero if there is no shared function)
+ */
+template<class Base>
+inline size_t ModelCSourceGen<Base>::getSharedValuesSize(const std::string& function) const {
+    auto it = _sharedValuesSize.find(function);
+    if (it == _sharedValuesSize.end())
+        return 0;
+    return it->second;
+}
+
+/**
+ * @return whether or not an operation with this type can be evaluated in
+ *         the function with the shared values
+ */
+template<class Base>
+inline bool ModelCSourceGen<Base>::isShareableOperation(CGOpCode op) {
+    switch (op) {
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
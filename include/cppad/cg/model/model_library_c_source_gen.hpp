@@ -41,6 +41,8 @@ public:
     static const std::string FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK;
     static const std::string FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS;
     static const std::string FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS;
+    static const std::string FUNCTION_SETTHREADPOOLAFFINITY;
+    static const std::string FUNCTION_GETTHREADPOOLAFFINITY;
     static const unsigned long API_VERSION;
 protected:
     static const std::string CONST;
@@ -63,6 +65,11 @@ protected:
      * Parallelization can be disabled locally for each model.
      */
     MultiThreadingType _multiThreading;
+    /**
+     * Whether or not models in this library call other models in this
+     * library (used as atomic functions) directly
+     */
+    bool _directExternalModelCalls;
     /**
      * temporary stream to generate source code
      */
@@ -77,7 +84,8 @@ public:
      *              this object)
      */
     inline ModelLibraryCSourceGen(ModelCSourceGen<Base>& model):
-        _multiThreading(MultiThreadingType::NONE) {
+        _multiThreading(MultiThreadingType::NONE),
+        _directExternalModelCalls(false) {
         CPPADCG_ASSERT_KNOWN(_models.find(model.getName()) == _models.end(),
                              "Another model with the same name was already registered");
 
@@ -158,6 +166,42 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Whether or not the models in this library call the other models in
+     * this library, which they use as atomic functions, directly.
+     *
+     * @return true if direct calls are generated
+     */
+    inline bool isDirectExternalModelCalls() const {
+        return _directExternalModelCalls;
+    }
+
+    /**
+     * Defines whether or not the models in this library should call the
+     * other models in this library, which they use as atomic functions
+     * (e.g. through CGAtomicGenericModel), directly.
+     * Atomic functions are matched to models using their names.
+     *
+     * Without this option every call goes through the LangCAtomicFun
+     * callbacks and the atomic function wrappers defined at runtime.
+     * With this option the generated source code calls C functions which
+     * are generated for the library and which call the forward zero,
+     * sparse forward one, sparse reverse one and sparse reverse two
+     * functions of the other model.
+     * The callbacks are still used when the other model does not provide
+     * the required function or when it uses atomic functions itself.
+     * Therefore, the atomic functions must still be registered in the
+     * loaded models (e.g. with GenericModel::addExternalModel()).
+     *
+     * This option must be defined before the source code is generated.
+     *
+     * @param direct whether or not to generate direct calls
+     */
+    inline void setDirectExternalModelCalls(bool direct) {
+        _directExternalModelCalls = direct;
+        _libSources.clear(); // must regenerate library sources again
+    }
+
     /**
      * Saves the generated C source code into several files.
      * 
@@ -186,6 +230,60 @@ protected:
 
     virtual void generateThreadPoolSources(std::map<std::string, std::string>& sources);
 
+    virtual void generateDirectAtomicSources(std::map<std::string, std::string>& sources);
+
+    /**
+     * Generates the C functions used by other models to call a model
+     * directly (see setDirectExternalModelCalls()).
+     *
+     * @param model the model called by other models
+     */
+    virtual void generateDirectAtomicSource(ModelCSourceGen<Base>& model,
+                                            std::map<std::string, std::string>& sources);
+
+    /**
+     * Provides the source code for a model (generating it if needed).
+     */
+    virtual const std::map<std::string, std::string>& getModelSources(ModelCSourceGen<Base>& model);
+
+    /**
+     * Generates the source code for a model if it was not generated yet
+     * (either kept by the model or already provided to a source sink).
+     */
+    virtual void prepareModelSources(ModelCSourceGen<Base>& model);
+
+    /**
+     * Generates the source code for a model and provides each source file
+     * to a sink as soon as it is complete (the sources are not kept).
+     */
+    virtual void streamModelSources(ModelCSourceGen<Base>& model,
+                                    SourceFileSink& sink);
+
+    /**
+     * Generates the source code for a model using the direct calls to the
+     * other models in this library (see setDirectExternalModelCalls()).
+     * The direct atomic functions defined by the user in the model are
+     * restored afterwards.
+     *
+     * @param generate the function which generates the source code
+     */
+    template<class Generate>
+    void generateModelSources(ModelCSourceGen<Base>& model,
+                              Generate generate);
+
+    /**
+     * Determines the atomic functions called directly by a model, i.e.
+     * the ones defined by the user and, if enabled, the other models in
+     * this library.
+     *
+     * @return maps atomic function names to C function name prefixes
+     */
+    virtual std::map<std::string, std::string> directAtomicFunctions(const ModelCSourceGen<Base>& model) const;
+
+    static inline std::string directAtomicPrefix(const std::string& modelName) {
+        return modelName + "_atomic";
+    }
+
     static void saveSources(const std::string& sourcesFolder,
                             const std::map<std::string, std::string>& sources);
 
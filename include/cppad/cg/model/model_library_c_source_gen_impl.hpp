@@ -68,6 +68,12 @@ const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTI
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS = "cppad_cg_thpool_get_number_of_time_meas";
 
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLAFFINITY = "cppad_cg_thpool_set_affinity";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAFFINITY = "cppad_cg_thpool_get_affinity";
+
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::CONST = "const";
 
@@ -79,7 +85,7 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder)
 
     // save/generate model sources
     for (const auto& it : _models) {
-        saveSources(sourcesFolder, it.second->getSources());
+        saveSources(sourcesFolder, getModelSources(*it.second));
     }
 
     // save/generate library sources
@@ -110,10 +116,14 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
         generateOnCloseSource(_libSources);
         generateThreadPoolSources(_libSources);
 
+        if (_directExternalModelCalls) {
+            generateDirectAtomicSources(_libSources);
+        }
+
         if(_multiThreading != MultiThreadingType::NONE) {
             bool usingMultiThreading = false;
             for (const auto& it : _models) {
-                if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+                if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() || it.second->isParallelTasksEnabled()) {
                     usingMultiThreading = true;
                     break;
                 }
@@ -133,6 +143,64 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
     return _libSources;
 }
 
+template<class Base>
+const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getModelSources(ModelCSourceGen<Base>& model) {
+    prepareModelSources(model);
+
+    return model.getSources(_multiThreading, this);
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::prepareModelSources(ModelCSourceGen<Base>& model) {
+    if (model._sources.empty() && !model._sourcesStreamed) {
+        generateModelSources(model, [&]() {
+            model.getSources(_multiThreading, this);
+        });
+    }
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::streamModelSources(ModelCSourceGen<Base>& model,
+                                                      SourceFileSink& sink) {
+    generateModelSources(model, [&]() {
+        model.streamSources(_multiThreading, this, sink);
+    });
+}
+
+template<class Base>
+template<class Generate>
+void ModelLibraryCSourceGen<Base>::generateModelSources(ModelCSourceGen<Base>& model,
+                                                        Generate generate) {
+    if (!_directExternalModelCalls) {
+        generate();
+        return;
+    }
+
+    // the direct calls to the other models only apply to this library
+    std::map<std::string, std::string> userDirect = model.getDirectAtomicFunctions();
+    model.setDirectAtomicFunctions(directAtomicFunctions(model));
+    try {
+        generate();
+    } catch (...) {
+        model.setDirectAtomicFunctions(userDirect);
+        throw;
+    }
+    model.setDirectAtomicFunctions(userDirect);
+}
+
+template<class Base>
+std::map<std::string, std::string> ModelLibraryCSourceGen<Base>::directAtomicFunctions(const ModelCSourceGen<Base>& model) const {
+    std::map<std::string, std::string> direct = model.getDirectAtomicFunctions();
+    if (_directExternalModelCalls) {
+        for (const auto& it : _models) {
+            if (it.second != &model) {
+                direct.emplace(it.first, directAtomicPrefix(it.first)); // keep user defined functions
+            }
+        }
+    }
+    return direct;
+}
+
 template<class Base>
 void ModelLibraryCSourceGen<Base>::generateVersionSource(std::map<std::string, std::string>& sources) {
     _cache.str("");
@@ -170,7 +238,7 @@ void ModelLibraryCSourceGen<Base>::generateOnCloseSource(std::map<std::string, s
     bool pthreads = false;
     if(_multiThreading == MultiThreadingType::PTHREADS) {
         for (const auto& it : _models) {
-            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() || it.second->isParallelTasksEnabled()) {
                 pthreads = true;
                 break;
             }
@@ -196,7 +264,7 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
     bool usingMultiThreading = false;
     if(_multiThreading != MultiThreadingType::NONE) {
         for (const auto& it : _models) {
-            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled()) {
+            if (it.second->isJacobianMultiThreadingEnabled() || it.second->isHessianMultiThreadingEnabled() || it.second->isParallelTasksEnabled()) {
                 usingMultiThreading = true;
                 break;
             }
@@ -255,6 +323,14 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return cppadcg_thpool_get_n_time_meas();\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLAFFINITY << "(int a, const int cpus[], int nCpus) {\n";
+        _cache << "   cppadcg_thpool_set_affinity((enum ThreadAffinity) a, cpus, nCpus);\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_GETTHREADPOOLAFFINITY << "() {\n";
+        _cache << "   return cppadcg_thpool_get_affinity();\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else if(usingMultiThreading && _multiThreading == MultiThreadingType::OPENMP) {
@@ -312,7 +388,7 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
 
     } else {
         _cache.str("");
-        _cache << "enum ScheduleStrategy {SCHED_STATIC = 1, SCHED_DYNAMIC = 2, SCHED_GUIDED = 3};\n"
+        _cache << "enum ScheduleStrategy {SCHED_STATIC = 1, SCHED_DYNAMIC = 2, SCHED_GUIDED = 3, SCHED_WORK_STEALING = 4};\n"
                 "\n";
         _cache << "void " << FUNCTION_SETTHREADPOOLDISABLED << "(int disabled) {\n";
         _cache << "}\n\n";
@@ -360,6 +436,261 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
     }
 }
 
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateDirectAtomicSources(std::map<std::string, std::string>& sources) {
+    // only the models used as atomic functions by other models in this library
+    std::set<std::string> called;
+    for (const auto& it : _models) {
+        prepareModelSources(*it.second); // the sources might have already been streamed
+
+        const std::map<std::string, std::string> direct = directAtomicFunctions(*it.second);
+        for (const std::string& atomicName : it.second->_atomicFunctions) {
+            auto itDirect = direct.find(atomicName);
+            if (itDirect != direct.end() && itDirect->second == directAtomicPrefix(atomicName) &&
+                _models.find(atomicName) != _models.end())
+                called.insert(atomicName);
+        }
+    }
+
+    for (const std::string& name : called) {
+        generateDirectAtomicSource(*_models.at(name), sources);
+    }
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateDirectAtomicSource(ModelCSourceGen<Base>& model,
+                                                              std::map<std::string, std::string>& sources) {
+    using MCG = ModelCSourceGen<Base>;
+
+    const std::string& name = model.getName();
+    const std::string prefix = directAtomicPrefix(name);
+    const std::string baseType = MCG::baseTypeName();
+    const size_t n = model._fun.Domain();
+    const size_t m = model._fun.Range();
+
+    /**
+     * a model which uses atomic functions must be called with its own
+     * atomic function callbacks
+     */
+    const bool atomics = model.isAtomicsUsed();
+    const bool zero = model._zero && !atomics;
+    const bool for1 = model._forwardOne && !atomics;
+    const bool rev1 = model._reverseOne && !atomics;
+    const bool rev2 = model._reverseTwo && !atomics;
+
+    // the number of values shared by the directional functions (zero if they are not shared)
+    const size_t for1Shared = for1 ? model.getSharedValuesSize(MCG::FUNCTION_SPARSE_FORWARD_ONE_SHARED) : 0;
+    const size_t rev1Shared = rev1 ? model.getSharedValuesSize(MCG::FUNCTION_SPARSE_REVERSE_ONE_SHARED) : 0;
+    const size_t rev2Shared = rev2 ? model.getSharedValuesSize(MCG::FUNCTION_SPARSE_REVERSE_TWO_SHARED) : 0;
+
+    LanguageC<Base> langC(baseType);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+    /**
+     * the compressed results and the values shared by the directional
+     * functions are kept on the stack unless they are too large, in which
+     * case they are only created once per thread
+     */
+    const size_t maxStackSize = 1024;
+    auto printArrayDcl = [&](const std::string& array, size_t size) {
+        size = std::max<size_t>(size, 1);
+        _cache << (size <= maxStackSize ? "   " : "   static __thread ") << baseType << " " << array << "[" << size << "];\n";
+    };
+
+    _cache.str("");
+    _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    if (zero) {
+        _cache << "void " << name << "_" << MCG::FUNCTION_FORWAD_ZERO << "(" << argsDcl << ");\n";
+    }
+    if (for1) {
+        _cache << "int " << name << "_" << MCG::FUNCTION_SPARSE_FORWARD_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                "void " << name << "_" << MCG::FUNCTION_FORWARD_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        if (for1Shared > 0)
+            _cache << "void " << name << "_" << MCG::FUNCTION_SPARSE_FORWARD_ONE_SHARED << "(" << argsDcl << ");\n";
+    }
+    if (rev1) {
+        _cache << "int " << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                "void " << name << "_" << MCG::FUNCTION_REVERSE_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        if (rev1Shared > 0)
+            _cache << "void " << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_ONE_SHARED << "(" << argsDcl << ");\n";
+    }
+    if (rev2) {
+        _cache << "int " << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_TWO << "(unsigned long pos, " << argsDcl << ");\n"
+                "void " << name << "_" << MCG::FUNCTION_REVERSE_TWO_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        if (rev2Shared > 0)
+            _cache << "void " << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_TWO_SHARED << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
+
+    /**
+     * forward mode
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", prefix + "_forward", {"struct LangCAtomicFun atomicFun",
+                                                                                   "int atomicIndex",
+                                                                                   "int q",
+                                                                                   "int p",
+                                                                                   "const Array tx[]",
+                                                                                   "Array* ty"});
+    _cache << " {\n";
+    if (zero || for1) {
+        _cache << "   " << baseType << " const * in[3];\n"
+                "   " << baseType << "* out[1];\n";
+    }
+    if (for1) {
+        _cache << "   unsigned long ePos, ej, i, j, nnz;\n"
+                "   unsigned long const* pos;\n"
+                "   " << baseType << " const * tx1;\n"
+                "   " << baseType << "* ty1;\n";
+        printArrayDcl("compressed", m);
+        if (for1Shared > 0)
+            printArrayDcl("shared", for1Shared);
+    }
+    _cache << "\n";
+    if (zero) {
+        _cache << "   if (p == 0) {\n"
+                "      in[0] = (" << baseType << " const *) tx[0].data;\n"
+                "      out[0] = (" << baseType << "*) ty->data;\n"
+                "      " << name << "_" << MCG::FUNCTION_FORWAD_ZERO << "(in, out, atomicFun);\n"
+                "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    if (for1) {
+        _cache << "   if (p == 1 && tx[1].sparse) {\n"
+                "      tx1 = (" << baseType << " const *) tx[1].data;\n"
+                "      ty1 = (" << baseType << "*) ty->data;\n"
+                "      for (i = 0; i < " << m << "; i++)\n"
+                "         ty1[i] = 0;\n"
+                "\n"
+                "      in[0] = (" << baseType << " const *) tx[0].data;\n";
+        if (for1Shared > 0) {
+            _cache << "      in[1] = tx1;\n"
+                    "      in[2] = shared;\n"
+                    "      out[0] = shared;\n"
+                    "      " << name << "_" << MCG::FUNCTION_SPARSE_FORWARD_ONE_SHARED << "(in, out, atomicFun);\n";
+        }
+        _cache << "      out[0] = compressed;\n"
+                "      for (ej = 0; ej < tx[1].nnz; ej++) {\n"
+                "         j = tx[1].idx[ej];\n"
+                "         " << name << "_" << MCG::FUNCTION_FORWARD_ONE_SPARSITY << "(j, &pos, &nnz);\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            compressed[ePos] = 0;\n"
+                "\n"
+                "         in[1] = &tx1[ej];\n"
+                "         if (" << name << "_" << MCG::FUNCTION_SPARSE_FORWARD_ONE << "(j, in, out, atomicFun) != 0) {\n"
+                "            return 0; // failure\n"
+                "         }\n"
+                "\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            ty1[pos[ePos]] += compressed[ePos];\n"
+                "      }\n"
+                "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    _cache << "   return atomicFun.forward(atomicFun.libModel, atomicIndex, q, p, tx, ty);\n"
+            "}\n\n";
+
+    /**
+     * reverse mode
+     */
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", prefix + "_reverse", {"struct LangCAtomicFun atomicFun",
+                                                                                   "int atomicIndex",
+                                                                                   "int p",
+                                                                                   "const Array tx[]",
+                                                                                   "Array* px",
+                                                                                   "const Array py[]"});
+    _cache << " {\n";
+    if (rev1 || rev2) {
+        _cache << "   unsigned long ePos, j, nnz;\n"
+                "   unsigned long const* pos;\n";
+        if (rev1)
+            _cache << "   unsigned long ei, i;\n";
+        if (rev2)
+            _cache << "   unsigned long ej;\n";
+        _cache << "   " << baseType << " const * in[4];\n"
+                "   " << baseType << "* out[1];\n"
+                "   " << baseType << " const * v;\n"
+                "   " << baseType << "* pxb;\n";
+        printArrayDcl("compressed", n);
+        if (rev1Shared > 0 || rev2Shared > 0)
+            printArrayDcl("shared", std::max(rev1Shared, rev2Shared));
+        _cache << "\n";
+    }
+    if (rev1) {
+        _cache << "   if (p == 0 && py[0].sparse) {\n"
+                "      v = (" << baseType << " const *) py[0].data;\n"
+                "      pxb = (" << baseType << "*) px->data;\n"
+                "      for (j = 0; j < " << n << "; j++)\n"
+                "         pxb[j] = 0;\n"
+                "\n"
+                "      in[0] = (" << baseType << " const *) tx[0].data;\n";
+        if (rev1Shared > 0) {
+            _cache << "      in[1] = v;\n"
+                    "      in[2] = shared;\n"
+                    "      out[0] = shared;\n"
+                    "      " << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_ONE_SHARED << "(in, out, atomicFun);\n";
+        }
+        _cache << "      out[0] = compressed;\n"
+                "      for (ei = 0; ei < py[0].nnz; ei++) {\n"
+                "         i = py[0].idx[ei];\n"
+                "         " << name << "_" << MCG::FUNCTION_REVERSE_ONE_SPARSITY << "(i, &pos, &nnz);\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            compressed[ePos] = 0;\n"
+                "\n"
+                "         in[1] = &v[ei];\n"
+                "         if (" << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_ONE << "(i, in, out, atomicFun) != 0) {\n"
+                "            return 0; // failure\n"
+                "         }\n"
+                "\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            pxb[pos[ePos]] += compressed[ePos];\n"
+                "      }\n"
+                "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    if (rev2) {
+        _cache << "   if (p == 1 && tx[1].sparse && py[0].nnz == 0 && !py[1].sparse) {\n"
+                "      v = (" << baseType << " const *) tx[1].data;\n"
+                "      pxb = (" << baseType << "*) px->data;\n"
+                "      for (j = 0; j < " << n << "; j++)\n"
+                "         pxb[j] = 0;\n"
+                "\n"
+                "      in[0] = (" << baseType << " const *) tx[0].data;\n"
+                "      in[2] = (" << baseType << " const *) py[1].data;\n";
+        if (rev2Shared > 0) {
+            _cache << "      in[1] = v;\n"
+                    "      in[3] = shared;\n"
+                    "      out[0] = shared;\n"
+                    "      " << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_TWO_SHARED << "(in, out, atomicFun);\n";
+        }
+        _cache << "      out[0] = compressed;\n"
+                "      for (ej = 0; ej < tx[1].nnz; ej++) {\n"
+                "         j = tx[1].idx[ej];\n"
+                "         " << name << "_" << MCG::FUNCTION_REVERSE_TWO_SPARSITY << "(j, &pos, &nnz);\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            compressed[ePos] = 0;\n"
+                "\n"
+                "         in[1] = &v[ej];\n"
+                "         if (" << name << "_" << MCG::FUNCTION_SPARSE_REVERSE_TWO << "(j, in, out, atomicFun) != 0) {\n"
+                "            return 0; // failure\n"
+                "         }\n"
+                "\n"
+                "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                "            pxb[pos[ePos]] += compressed[ePos];\n"
+                "      }\n"
+                "      return 1;\n"
+                "   }\n"
+                "\n";
+    }
+    _cache << "   return atomicFun.reverse(atomicFun.libModel, atomicIndex, p, tx, px, py);\n"
+            "}\n\n";
+
+    sources[prefix + ".c"] = _cache.str();
+    _cache.str("");
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
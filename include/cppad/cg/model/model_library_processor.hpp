@@ -43,7 +43,12 @@ protected:
     }
 
     inline const std::map<std::string, std::string>& getSources(ModelCSourceGen<Base>& model) {
-        return model.getSources(modelLibraryHelper_->getMultiThreading(), modelLibraryHelper_);
+        return modelLibraryHelper_->getModelSources(model);
+    }
+
+    inline void streamSources(ModelCSourceGen<Base>& model,
+                              SourceFileSink& sink) {
+        modelLibraryHelper_->streamModelSources(model, sink);
     }
 
 };
@@ -20,6 +20,9 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <utime.h>
 
 namespace CppAD {
 namespace cg {
@@ -67,11 +70,24 @@ public:
     FDHandler write;
 public:
 
+    /**
+     * Creates a new pipe whose file descriptors are closed on exec so that
+     * executables started concurrently from other threads do not inherit
+     * them (which would prevent the end-of-file from ever being reached).
+     */
     inline void create() {
         int fd[2]; /** file descriptors used to communicate between processes*/
+#if defined(__linux__) && defined(O_CLOEXEC)
+        if (pipe2(fd, O_CLOEXEC) < 0) {
+            throw CGException("Failed to create pipe");
+        }
+#else
         if (pipe(fd) < 0) {
             throw CGException("Failed to create pipe");
         }
+        fcntl(fd[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+#endif
         read.fd = fd[0];
         read.closed = false;
         write.fd = fd[1];
@@ -179,6 +195,46 @@ inline bool isFile(const std::string& path) {
     return false;
 }
 
+inline std::vector<std::string> listFiles(const std::string& folder) {
+    DIR* dir = opendir(folder.c_str());
+    if (dir == nullptr) {
+        const char* error = strerror(errno);
+        throw CGException("Failed to open directory '", folder, "': ", error);
+    }
+
+    std::vector<std::string> files;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (isFile(createPath(folder, name))) {
+            files.push_back(name);
+        }
+    }
+    closedir(dir);
+
+    return files;
+}
+
+inline bool getFileInfo(const std::string& path,
+                        size_t& size,
+                        time_t& modificationTime) {
+    struct stat sts;
+    if (stat(path.c_str(), &sts) != 0) {
+        return false;
+    }
+
+    size = sts.st_size;
+    modificationTime = sts.st_mtime;
+    return true;
+}
+
+inline void touchFile(const std::string& path) {
+    if (utime(path.c_str(), nullptr) != 0) {
+        const char* error = strerror(errno);
+        throw CGException("Failed to update the modification time of '", path, "': ", error);
+    }
+}
+
 inline void callExecutable(const std::string& executable,
                            const std::vector<std::string>& args,
                            std::string* stdOutErrMessage,
@@ -326,9 +382,10 @@ inline void callExecutable(const std::string& executable,
         ssize_t n;
         if(stdOutErrMessage != nullptr) {
             while ((n = read(pipeStdOutErr.read.fd, buffer, sizeof (buffer))) > 0) {
+                // keep draining the pipe so that the child never blocks on a full pipe
+                if (size > 1e4) continue;
                 messageStdOutErr.write(buffer, n);
                 size += n;
-                if (size > 1e4) break;
             }
         }
 
@@ -361,6 +418,9 @@ inline void callExecutable(const std::string& executable,
             std::ostringstream s;
             s << "Executable '" << executable << "' (pid " << pid << ") exited with code " << WEXITSTATUS(status);
             if (size > 0) s << ": " << messageErr.str();
+            if (stdOutErrMessage != nullptr && !messageStdOutErr.str().empty()) {
+                s << "\n" << messageStdOutErr.str();
+            }
             throw CGException(s.str());
         }
     } else if (WIFSIGNALED(status)) {
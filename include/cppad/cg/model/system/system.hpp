@@ -86,6 +86,38 @@ inline bool isDirectory(const std::string& path);
  */
 inline bool isFile(const std::string& path);
 
+/**
+ * Provides the names of the regular files inside a folder (system dependent)
+ *
+ * @param folder the path to the folder
+ * @return the file names (without the folder path)
+ * @throws CGException on failure to read the folder contents
+ */
+inline std::vector<std::string> listFiles(const std::string& folder);
+
+/**
+ * Provides the size and the time of the last modification of a file
+ * (system dependent)
+ *
+ * @param path the file path
+ * @param size the file size in bytes
+ * @param modificationTime the time of the last modification in seconds
+ *                         since the epoch
+ * @return true if the file exists and its information could be read
+ */
+inline bool getFileInfo(const std::string& path,
+                        size_t& size,
+                        time_t& modificationTime);
+
+/**
+ * Sets the modification time of an existing file to the current time
+ * (system dependent)
+ *
+ * @param path the file path
+ * @throws CGException on failure to update the file
+ */
+inline void touchFile(const std::string& path);
+
 /**
  * Calls an external executable (system dependent).
  * In the case of an error during execution an exception will be thrown.
@@ -18,6 +18,10 @@
  *  https://github.com/Pithikos/C-Thread-Pool/blob/master/thpool.c
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* required for pthread_setaffinity_np() */
+#endif
+
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -28,28 +32,43 @@
 #include <sys/prctl.h>
 #include <time.h>
 #include <sys/time.h>
+#ifndef __USE_GNU
 #define __USE_GNU /* required before including  resource.h */
+#endif
 #include <sys/resource.h>
+#include <sched.h>
 #endif
 
 enum ScheduleStrategy {SCHED_STATIC = 1,
                        SCHED_DYNAMIC = 2,
-                       SCHED_GUIDED = 3
+                       SCHED_GUIDED = 3,
+                       SCHED_WORK_STEALING = 4
                        };
 
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
                            ELAPSED_TIME_MIN};
 
+enum ThreadAffinity {AFFINITY_NONE = 0,
+                     AFFINITY_COMPACT = 1,
+                     AFFINITY_SCATTER = 2,
+                     AFFINITY_EXPLICIT = 3
+                     };
+
 typedef struct ThPool ThPool;
 typedef void (* thpool_function_type)(void*);
 
 static ThPool* volatile cppadcg_pool = NULL;
+static __thread int cppadcg_pool_worker = 0; // whether or not the current thread belongs to the pool
 static int cppadcg_pool_n_threads = 2;
 static int cppadcg_pool_disabled = 0; // false
 static int cppadcg_pool_verbose = 0; // false
 static enum ElapsedTimeReference cppadcg_pool_time_update = ELAPSED_TIME_MIN;
 static unsigned int cppadcg_pool_time_meas = 10; // default number of time measurements
 static float cppadcg_pool_guided_maxgroupwork = 0.75;
+static enum ThreadAffinity cppadcg_pool_affinity = AFFINITY_NONE;
+static int* cppadcg_pool_affinity_cpus = NULL; // the CPU used by each thread (repeated if there are more threads)
+static int cppadcg_pool_affinity_n_cpus = 0;
+static pthread_mutex_t cppadcg_pool_affinity_lock = PTHREAD_MUTEX_INITIALIZER; // protects the CPU list
 
 static enum ScheduleStrategy schedule_strategy = SCHED_DYNAMIC;
 
@@ -75,8 +94,14 @@ static int thpool_add_jobs(ThPool*,
 
 static void thpool_wait(ThPool*);
 
+static void thpool_apply_affinity(ThPool*);
+
 static void thpool_destroy(ThPool*);
 
+static int affinity_create_cpu_list(enum ThreadAffinity a,
+                                    int** cpus,
+                                    int* nCpus);
+
 /* ========================== STRUCTURES ============================ */
 /* Binary semaphore */
 typedef struct BSem {
@@ -96,6 +121,7 @@ typedef struct Job {
     struct timespec startTime;           /* initial time (verbose only)          */
     struct timespec endTime;             /* final time (verbose only)            */
     int id;                              /* a job identifier used for debugging  */
+    int thread_id;                       /* the thread which executed the job (SCHED_WORK_STEALING and verbose only) */
 } Job;
 
 /* Work group */
@@ -107,12 +133,33 @@ typedef struct WorkGroup {
     struct timespec endTime;             /* final time (verbose only)      */
 } WorkGroup;
 
+/* Chase-Lev deque with the jobs initially assigned to a single thread (SCHED_WORK_STEALING scheduling only).
+ * Jobs are only added before the deque is shared with the other threads. */
+typedef struct WorkDeque {
+    Job** jobs;                          /* jobs (the owner starts from the bottom)         */
+    volatile long top;                   /* position of the next job to be stolen           */
+    volatile long bottom;                /* one past the position of the next job to be popped by the owner */
+} WorkDeque;
+
+/* Jobs added at once with the SCHED_WORK_STEALING scheduling */
+typedef struct WorkStealingBatch {
+    struct WorkStealingBatch* prev;      /* pointer to previous batch      */
+    WorkDeque* deques;                   /* one deque for each thread      */
+    int num_deques;                      /* number of deques               */
+    Job* jobs;                           /* jobs                           */
+    Job** job_slots;                     /* storage used by the deques     */
+    int size;                            /* number of jobs                 */
+    volatile int stolen;                 /* number of stolen jobs (verbose only) */
+} WorkStealingBatch;
+
 /* Job queue */
 typedef struct JobQueue {
     pthread_mutex_t rwmutex;             /* used for queue r/w access */
     Job  *front;                         /* pointer to front of queue */
     Job  *rear;                          /* pointer to rear  of queue */
     WorkGroup* group_front;              /* previously created work groups (SCHED_STATIC scheduling only)*/
+    WorkStealingBatch* volatile ws_front; /* previously created batches (SCHED_WORK_STEALING scheduling only)*/
+    volatile int ws_pending;             /* number of jobs in the batches which were not yet taken by a thread */
     BSem *has_jobs;                      /* flag as binary semaphore  */
     int   len;                           /* number of jobs in queue   */
     float total_time;                    /* total expected time to complete the work */
@@ -126,6 +173,9 @@ typedef struct Thread {
     pthread_t pthread;                   /* pointer to actual thread             */
     struct ThPool* thpool;               /* access to ThPool                     */
     WorkGroup* processed_groups;         /* processed work groups (verbose only) */
+#if defined(__linux__)
+    cpu_set_t original_mask;             /* the CPUs allowed when the thread was created */
+#endif
 } Thread;
 
 
@@ -215,6 +265,53 @@ void cppadcg_thpool_set_n_time_meas(unsigned int n) {
     cppadcg_pool_time_meas = n;
 }
 
+void cppadcg_thpool_set_affinity(enum ThreadAffinity a,
+                                 const int cpus[],
+                                 int nCpus) {
+    int i;
+    int* newCpus = NULL;
+    int* oldCpus;
+
+    if (a == AFFINITY_EXPLICIT) {
+        if (cpus == NULL || nCpus <= 0) {
+            fprintf(stderr, "cppadcg_thpool_set_affinity(): a list of CPUs is required for an explicit affinity\n");
+            return;
+        }
+        newCpus = (int*) malloc(nCpus * sizeof(int));
+        if (newCpus == NULL) {
+            fprintf(stderr, "cppadcg_thpool_set_affinity(): Could not allocate memory\n");
+            return;
+        }
+        for (i = 0; i < nCpus; ++i) {
+            newCpus[i] = cpus[i];
+        }
+    } else if (a == AFFINITY_COMPACT || a == AFFINITY_SCATTER) {
+        if (affinity_create_cpu_list(a, &newCpus, &nCpus) != 0) {
+            return;
+        }
+    } else {
+        nCpus = 0;
+    }
+
+    pthread_mutex_lock(&cppadcg_pool_affinity_lock);
+    oldCpus = cppadcg_pool_affinity_cpus;
+    cppadcg_pool_affinity_cpus = newCpus;
+    cppadcg_pool_affinity_n_cpus = nCpus;
+    cppadcg_pool_affinity = a;
+    pthread_mutex_unlock(&cppadcg_pool_affinity_lock);
+
+    /* the CPU list is only read while holding the lock */
+    free(oldCpus);
+
+    if (cppadcg_pool != NULL) {
+        thpool_apply_affinity(cppadcg_pool);
+    }
+}
+
+enum ThreadAffinity cppadcg_thpool_get_affinity() {
+    return cppadcg_pool_affinity;
+}
+
 void cppadcg_thpool_set_verbose(int v) {
     cppadcg_pool_verbose = v;
 }
@@ -282,6 +379,136 @@ void cppadcg_thpool_wait() {
     }
 }
 
+/**
+ * Jobs which can only start after other jobs have finished (e.g. the parts
+ * of a single large function)
+ */
+typedef struct TaskGraph TaskGraph;
+
+typedef struct TaskGraphJob {
+    TaskGraph* graph;                    /* the graph with this task             */
+    int task;                            /* the task index                       */
+} TaskGraphJob;
+
+struct TaskGraph {
+    thpool_function_type function;       /* function used to run every task      */
+    void** args;                         /* the argument of each task            */
+    const int* succStart;                /* the first successor of each task     */
+    const int* succ;                     /* the successors of all tasks          */
+    int* pending;                        /* unfinished dependencies of each task */
+    TaskGraphJob* jobs;                  /* the job of each task                 */
+    pthread_mutex_t mutex;               /* used to update remaining             */
+    pthread_cond_t finished;             /* signals the end of the last task     */
+    int remaining;                       /* number of tasks not yet finished     */
+};
+
+static void task_graph_run(void* arg) {
+    TaskGraphJob* job = (TaskGraphJob*) arg;
+    TaskGraph* graph = job->graph;
+    int t = job->task;
+    int s;
+    int next;
+
+    (*graph->function)(graph->args[t]);
+
+    /* start the tasks which no longer depend on other tasks */
+    for (s = graph->succStart[t]; s < graph->succStart[t + 1]; ++s) {
+        next = graph->succ[s];
+        if (__atomic_sub_fetch(&graph->pending[next], 1, __ATOMIC_ACQ_REL) == 0) {
+            thpool_add_job(cppadcg_pool, task_graph_run, &graph->jobs[next], NULL, NULL);
+        }
+    }
+
+    /* the graph can no longer be used after the last task is finished */
+    pthread_mutex_lock(&graph->mutex);
+    graph->remaining--;
+    if (graph->remaining == 0) {
+        pthread_cond_signal(&graph->finished);
+    }
+    pthread_mutex_unlock(&graph->mutex);
+}
+
+/**
+ * Runs tasks with dependencies between them and waits for all of them to
+ * finish.
+ * A task is added to the pool once all the tasks it depends on are
+ * finished.
+ * The tasks are executed by the calling thread (in the provided order) if
+ * the pool is disabled or if it is called from inside a job of the pool.
+ *
+ * @param function   the function used to run every task
+ * @param args       the argument of each task
+ * @param nDeps      the number of tasks each task depends on
+ * @param succStart  the position in succ of the first task which depends on
+ *                   each task (nTasks + 1 elements)
+ * @param succ       the tasks which depend on each task
+ * @param nTasks     the number of tasks (in a valid evaluation order)
+ */
+void cppadcg_thpool_run_task_graph(thpool_function_type function,
+                                   void* args[],
+                                   const int nDeps[],
+                                   const int succStart[],
+                                   const int succ[],
+                                   int nTasks) {
+    TaskGraph graph;
+    int t;
+
+    if (!cppadcg_pool_disabled && !cppadcg_pool_worker && nTasks > 1) {
+        cppadcg_thpool_prepare();
+    }
+
+    if (cppadcg_pool_disabled || cppadcg_pool_worker || nTasks <= 1 || cppadcg_pool == NULL) {
+        // thread pool not used (waiting for the pool inside a job would never end)
+        for (t = 0; t < nTasks; ++t) {
+            (*function)(args[t]);
+        }
+        return;
+    }
+
+    graph.function = function;
+    graph.args = args;
+    graph.succStart = succStart;
+    graph.succ = succ;
+    graph.pending = (int*) malloc(nTasks * sizeof(int));
+    graph.jobs = (TaskGraphJob*) malloc(nTasks * sizeof(TaskGraphJob));
+    if (graph.pending == NULL || graph.jobs == NULL) {
+        fprintf(stderr, "cppadcg_thpool_run_task_graph(): Could not allocate memory for the tasks\n");
+        free(graph.pending);
+        free(graph.jobs);
+        for (t = 0; t < nTasks; ++t) {
+            (*function)(args[t]);
+        }
+        return;
+    }
+
+    pthread_mutex_init(&graph.mutex, NULL);
+    pthread_cond_init(&graph.finished, NULL);
+    graph.remaining = nTasks;
+
+    for (t = 0; t < nTasks; ++t) {
+        graph.pending[t] = nDeps[t];
+        graph.jobs[t].graph = &graph;
+        graph.jobs[t].task = t;
+    }
+
+    for (t = 0; t < nTasks; ++t) {
+        if (nDeps[t] == 0) {
+            thpool_add_job(cppadcg_pool, task_graph_run, &graph.jobs[t], NULL, NULL);
+        }
+    }
+
+    pthread_mutex_lock(&graph.mutex);
+    while (graph.remaining > 0) {
+        pthread_cond_wait(&graph.finished, &graph.mutex);
+    }
+    pthread_mutex_unlock(&graph.mutex);
+
+    pthread_mutex_destroy(&graph.mutex);
+    pthread_cond_destroy(&graph.finished);
+    free(graph.pending);
+    free(graph.jobs);
+}
+
 typedef struct pair_double_int {
     float val;
     int index;
@@ -368,6 +595,8 @@ static int  thread_init(ThPool* thpool,
                         Thread** thread,
                         int id);
 static void* thread_do(Thread* thread);
+static void  thread_set_affinity(pthread_t pthread,
+                                 const Thread* thread);
 static void  thread_destroy(Thread* thread);
 
 static int   jobqueue_init(ThPool* thpool);
@@ -383,7 +612,12 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
                                      int jobs2thread[],
                                      int nJobs,
                                      int lastElapsedChanged);
+static int jobqueue_push_work_stealing_jobs(ThPool* thpool,
+                                            Job* newjobs[],
+                                            int nJobs);
 static WorkGroup* jobqueue_pull(ThPool* thpool, int id);
+static Job* jobqueue_steal(ThPool* thpool, int id);
+static void jobqueue_release_batches(ThPool* thpool);
 static void  jobqueue_destroy(ThPool* thpool);
 
 static void  bsem_init(BSem *bsem, int value);
@@ -439,6 +673,115 @@ void timespec_diff(struct timespec* end,
     }
 }
 
+/* ============================ AFFINITY ============================ */
+
+/* Location of a CPU */
+typedef struct CpuLocation {
+    int cpu;                             /* the CPU index                        */
+    int package;                         /* the physical package (socket)        */
+    int rank;                            /* the position of the CPU in its package */
+} CpuLocation;
+
+static int compareCpuCompact(const void* a, const void* b) {
+    const CpuLocation* l1 = (const CpuLocation*) a;
+    const CpuLocation* l2 = (const CpuLocation*) b;
+    if (l1->package != l2->package)
+        return l1->package < l2->package ? -1 : 1;
+    if (l1->cpu != l2->cpu)
+        return l1->cpu < l2->cpu ? -1 : 1;
+    return 0;
+}
+
+static int compareCpuScatter(const void* a, const void* b) {
+    const CpuLocation* l1 = (const CpuLocation*) a;
+    const CpuLocation* l2 = (const CpuLocation*) b;
+    if (l1->rank != l2->rank)
+        return l1->rank < l2->rank ? -1 : 1;
+    if (l1->package != l2->package)
+        return l1->package < l2->package ? -1 : 1;
+    return 0;
+}
+
+/**
+ * Determines the order in which the CPUs available to this process are
+ * assigned to the threads.
+ * With AFFINITY_COMPACT all the CPUs in a socket are used before the next
+ * socket while with AFFINITY_SCATTER consecutive threads are placed in
+ * different sockets.
+ *
+ * @param a the affinity type (AFFINITY_COMPACT or AFFINITY_SCATTER)
+ * @param cpus the CPU list (allocated by this function)
+ * @param nCpus the number of elements in the CPU list
+ * @return 0 on success, -1 otherwise.
+ */
+static int affinity_create_cpu_list(enum ThreadAffinity a,
+                                    int** cpus,
+                                    int* nCpus) {
+#if defined(__linux__)
+    cpu_set_t mask;
+    CpuLocation* locations;
+    char path[128];
+    FILE* f;
+    int cpu, i, n;
+
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &mask) != 0) {
+        fprintf(stderr, "affinity_create_cpu_list(): failed sched_getaffinity()\n");
+        return -1;
+    }
+
+    n = CPU_COUNT(&mask);
+    locations = (CpuLocation*) malloc(n * sizeof(CpuLocation));
+    *cpus = (int*) malloc(n * sizeof(int));
+    if (locations == NULL || *cpus == NULL) {
+        fprintf(stderr, "affinity_create_cpu_list(): Could not allocate memory\n");
+        free(locations);
+        free(*cpus);
+        *cpus = NULL;
+        return -1;
+    }
+
+    i = 0;
+    for (cpu = 0; cpu < CPU_SETSIZE && i < n; ++cpu) {
+        if (!CPU_ISSET(cpu, &mask))
+            continue;
+
+        locations[i].cpu = cpu;
+        locations[i].package = 0;
+        sprintf(path, "/sys/devices/system/cpu/cpu%i/topology/physical_package_id", cpu);
+        f = fopen(path, "r");
+        if (f != NULL) {
+            if (fscanf(f, "%i", &locations[i].package) != 1)
+                locations[i].package = 0;
+            fclose(f);
+        }
+        i++;
+    }
+
+    qsort(locations, n, sizeof(CpuLocation), compareCpuCompact);
+
+    if (a == AFFINITY_SCATTER) {
+        for (i = 0; i < n; ++i) {
+            if (i > 0 && locations[i].package == locations[i - 1].package)
+                locations[i].rank = locations[i - 1].rank + 1;
+            else
+                locations[i].rank = 0;
+        }
+        qsort(locations, n, sizeof(CpuLocation), compareCpuScatter);
+    }
+
+    for (i = 0; i < n; ++i) {
+        (*cpus)[i] = locations[i].cpu;
+    }
+    *nCpus = n;
+
+    free(locations);
+    return 0;
+#else
+    fprintf(stderr, "affinity_create_cpu_list(): thread affinity is not supported on this system\n");
+    return -1;
+#endif
+}
+
 /* ========================== THREADPOOL ============================ */
 
 /**
@@ -607,6 +950,8 @@ static int thpool_add_jobs(ThPool* thpool,
     /* add jobs to queue */
     if (schedule_strategy == SCHED_STATIC && avgElapsed != NULL && order != NULL && nJobs > 0 && avgElapsed[0] > 0) {
         return jobqueue_push_static_jobs(thpool, newjobs, avgElapsed, job2Thread, nJobs, lastElapsedChanged);
+    } else if (schedule_strategy == SCHED_WORK_STEALING && nJobs > 1) {
+        return jobqueue_push_work_stealing_jobs(thpool, newjobs, nJobs);
     } else {
         jobqueue_multipush(thpool->jobqueue, newjobs, nJobs);
         return 0;
@@ -765,6 +1110,144 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
     return 0;
 }
 
+/**
+ * Distribute jobs among the deques of each thread considering the elapsed
+ * time of each job (when available).
+ * Jobs are assigned to the thread with the lowest expected work so that
+ * the longest jobs are executed first by their owner thread while idle
+ * threads steal the shortest jobs from the top of the other deques.
+ */
+static int jobqueue_push_work_stealing_jobs(ThPool* thpool,
+                                            Job* newjobs[],
+                                            int nJobs) {
+    int i, j, k, iBest;
+    int num_threads = thpool->num_threads;
+    int use_time = 1; // true
+    struct pair_double_int elapsedOrder[nJobs];
+    int* n_jobs;
+    int* job2thread;
+    float* durations;
+    JobQueue* queue = thpool->jobqueue;
+    WorkStealingBatch* batch;
+    WorkDeque* deque;
+
+    batch = (WorkStealingBatch*) malloc(sizeof(WorkStealingBatch));
+    n_jobs = (int*) malloc(num_threads * sizeof(int));
+    job2thread = (int*) malloc(nJobs * sizeof(int));
+    durations = (float*) malloc(num_threads * sizeof(float));
+    if (batch == NULL || n_jobs == NULL || job2thread == NULL || durations == NULL) {
+        fprintf(stderr, "jobqueue_push_work_stealing_jobs(): Could not allocate memory\n");
+        free(batch);
+        free(n_jobs);
+        free(job2thread);
+        free(durations);
+        return -1;
+    }
+
+    batch->prev = NULL;
+    batch->num_deques = num_threads;
+    batch->size = nJobs;
+    batch->stolen = 0;
+    batch->deques = (WorkDeque*) malloc(num_threads * sizeof(WorkDeque));
+    batch->jobs = (Job*) malloc(nJobs * sizeof(Job));
+    batch->job_slots = (Job**) malloc(nJobs * sizeof(Job*));
+    if (batch->deques == NULL || batch->jobs == NULL || batch->job_slots == NULL) {
+        fprintf(stderr, "jobqueue_push_work_stealing_jobs(): Could not allocate memory\n");
+        free(batch->deques);
+        free(batch->jobs);
+        free(batch->job_slots);
+        free(batch);
+        free(n_jobs);
+        free(job2thread);
+        free(durations);
+        return -1;
+    }
+
+    for (j = 0; j < nJobs; ++j) {
+        if (newjobs[j]->avgElapsed == NULL || *newjobs[j]->avgElapsed <= 0) {
+            use_time = 0; // false
+        }
+        elapsedOrder[j].val = use_time ? -*newjobs[j]->avgElapsed : 0;
+        elapsedOrder[j].index = j;
+    }
+
+    if (use_time) {
+        // decreasing elapsed time
+        qsort(elapsedOrder, nJobs, sizeof(struct pair_double_int), comparePair);
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        n_jobs[i] = 0;
+        durations[i] = 0;
+    }
+
+    // decide in which deque to place each job (longest jobs first)
+    for (k = 0; k < nJobs; ++k) {
+        j = elapsedOrder[k].index;
+        iBest = 0;
+        for (i = 1; i < num_threads; ++i) {
+            if (durations[i] < durations[iBest]) {
+                iBest = i;
+            }
+        }
+        durations[iBest] += use_time ? *newjobs[j]->avgElapsed : 1.0f;
+        n_jobs[iBest]++;
+        job2thread[j] = iBest;
+    }
+
+    // the first job assigned to a thread is placed at the bottom of its deque
+    j = 0;
+    for (i = 0; i < num_threads; ++i) {
+        deque = &batch->deques[i];
+        deque->jobs = &batch->job_slots[j];
+        deque->top = 0;
+        deque->bottom = 0;
+        j += n_jobs[i];
+    }
+
+    for (k = 0; k < nJobs; ++k) {
+        j = elapsedOrder[k].index;
+        batch->jobs[j] = *newjobs[j]; // copy
+        free(newjobs[j]);
+        i = job2thread[j];
+        deque = &batch->deques[i];
+        deque->jobs[n_jobs[i] - 1 - deque->bottom] = &batch->jobs[j];
+        deque->bottom++;
+    }
+
+    if (cppadcg_pool_verbose) {
+        for (i = 0; i < num_threads; ++i) {
+            if (use_time) {
+                fprintf(stdout, "jobqueue_push_work_stealing_jobs(): deque %i with %i jobs for %e s\n", i, n_jobs[i], durations[i]);
+            } else {
+                fprintf(stdout, "jobqueue_push_work_stealing_jobs(): deque %i with %i jobs\n", i, n_jobs[i]);
+            }
+        }
+    }
+
+    /**
+     * add to the queue
+     */
+    pthread_mutex_lock(&queue->rwmutex);
+
+    batch->prev = queue->ws_front;
+    __atomic_store_n(&queue->ws_front, batch, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&queue->ws_pending, nJobs, __ATOMIC_RELEASE);
+
+    /* wake up a single thread: each thread which steals a job wakes up
+     * another one while there are jobs left in the deques */
+    bsem_post(queue->has_jobs);
+
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    // clean up
+    free(n_jobs);
+    free(job2thread);
+    free(durations);
+
+    return 0;
+}
+
 /**
  * @brief Wait for all queued jobs to finish
  *
@@ -793,7 +1276,7 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
  */
 static void thpool_wait(ThPool* thpool) {
     pthread_mutex_lock(&thpool->thcount_lock);
-    while (thpool->jobqueue->len || thpool->jobqueue->group_front || thpool->num_threads_working) {  //// PROBLEM HERE!!!! len is not locked!!!!
+    while (thpool->jobqueue->len || thpool->jobqueue->group_front || thpool->jobqueue->ws_pending || thpool->num_threads_working) {  //// PROBLEM HERE!!!! len is not locked!!!!
         pthread_cond_wait(&thpool->threads_all_idle, &thpool->thcount_lock);
     }
     thpool->jobqueue->total_time = 0;
@@ -801,6 +1284,8 @@ static void thpool_wait(ThPool* thpool) {
     pthread_mutex_unlock(&thpool->thcount_lock);
 
     thpool_cleanup(thpool);
+
+    jobqueue_release_batches(thpool);
 }
 
 
@@ -857,6 +1342,19 @@ void thpool_cleanup(ThPool* thpool) {
     }
 }
 
+/**
+ * Pins all the threads in a thread pool to the CPUs defined by the current
+ * affinity.
+ *
+ * @param thpool the thread pool
+ */
+static void thpool_apply_affinity(ThPool* thpool) {
+    int n;
+    for (n = 0; n < thpool->num_threads; n++) {
+        thread_set_affinity(thpool->threads[n]->pthread, thpool->threads[n]);
+    }
+}
+
 /**
  * @brief Destroy the threadpool
  *
@@ -946,11 +1444,55 @@ static int thread_init(ThPool* thpool,
     (*thread)->id = id;
     (*thread)->processed_groups = NULL;
 
+#if defined(__linux__)
+    /* the new thread inherits the affinity of the current thread */
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &(*thread)->original_mask) != 0) {
+        int cpu;
+        CPU_ZERO(&(*thread)->original_mask);
+        for (cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &(*thread)->original_mask);
+        }
+    }
+#endif
+
     pthread_create(&(*thread)->pthread, NULL, (void*) thread_do, (*thread));
     pthread_detach((*thread)->pthread);
     return 0;
 }
 
+/* Executes a single job (and measures its elapsed time if requested)
+ *
+ * @param job           the job to execute
+ */
+static void thread_run_job(Job* job) {
+    float elapsed;
+    int info;
+    struct timespec cputime;
+
+    if (cppadcg_pool_verbose) {
+        get_monotonic_time2(&job->startTime);
+    }
+
+    int do_benchmark = job->elapsed != NULL;
+    if (do_benchmark) {
+        elapsed = -get_thread_time(&cputime, &info);
+    }
+
+    /* Execute the job */
+    (*job->function)(job->arg);
+
+    if (do_benchmark && info == 0) {
+        elapsed += get_thread_time(&cputime, &info);
+        if (info == 0) {
+            (*job->elapsed) = elapsed;
+        }
+    }
+
+    if (cppadcg_pool_verbose) {
+        get_monotonic_time2(&job->endTime);
+    }
+}
+
 /* What each thread is doing
 *
 * In principle this is an endless loop. The only time this loop gets interrupted is once
@@ -960,14 +1502,10 @@ static int thread_init(ThPool* thpool,
 * @return nothing
 */
 static void* thread_do(Thread* thread) {
-    float elapsed;
-    int info;
-    struct timespec cputime;
     JobQueue* queue;
     WorkGroup* workGroup;
     Job* job;
-    thpool_function_type func_buff;
-    void* arg_buff;
+    int woke_others;
     int i;
 
     /* Set thread name for profiling and debugging */
@@ -983,9 +1521,17 @@ static void* thread_do(Thread* thread) {
     fprintf(stderr, "thread_do(): pthread_setname_np is not supported on this system");
 #endif
 
+    /* Pin the thread before it uses any memory so that its data is placed in
+     * the NUMA node where it runs (first-touch) */
+    if (cppadcg_pool_affinity != AFFINITY_NONE) {
+        thread_set_affinity(pthread_self(), thread);
+    }
+
     /* Assure all threads have been created before starting serving */
     ThPool* thpool = thread->thpool;
 
+    cppadcg_pool_worker = 1; // true
+
     /* Mark thread as alive (initialized) */
     pthread_mutex_lock(&thpool->thcount_lock);
     thpool->num_threads_alive += 1;
@@ -1005,7 +1551,24 @@ static void* thread_do(Thread* thread) {
         thpool->num_threads_working++;
         pthread_mutex_unlock(&thpool->thcount_lock);
 
+        woke_others = 0; // false
+
         while (thpool->threads_keepalive) {
+            /* Take a job from the work stealing deques (without locks) */
+            if (__atomic_load_n(&queue->ws_pending, __ATOMIC_ACQUIRE) > 0) {
+                job = jobqueue_steal(thpool, thread->id);
+                if (job != NULL) {
+                    if (!woke_others && __atomic_load_n(&queue->ws_pending, __ATOMIC_ACQUIRE) > 0) {
+                        /* other threads are only woken up once there is work for them */
+                        bsem_post(queue->has_jobs);
+                        woke_others = 1; // true
+                    }
+                    job->thread_id = thread->id;
+                    thread_run_job(job);
+                    continue;
+                }
+            }
+
             /* Read job from queue and execute it */
             pthread_mutex_lock(&queue->rwmutex);
             workGroup = jobqueue_pull(thpool, thread->id);
@@ -1019,32 +1582,7 @@ static void* thread_do(Thread* thread) {
             }
 
             for (i = 0; i < workGroup->size; ++i) {
-                job = &workGroup->jobs[i];
-
-                if (cppadcg_pool_verbose) {
-                    get_monotonic_time2(&job->startTime);
-                }
-
-                int do_benchmark = job->elapsed != NULL;
-                if (do_benchmark) {
-                    elapsed = -get_thread_time(&cputime, &info);
-                }
-
-                /* Execute the job */
-                func_buff = job->function;
-                arg_buff = job->arg;
-                func_buff(arg_buff);
-
-                if (do_benchmark && info == 0) {
-                    elapsed += get_thread_time(&cputime, &info);
-                    if (info == 0) {
-                        (*job->elapsed) = elapsed;
-                    }
-                }
-
-                if (cppadcg_pool_verbose) {
-                    get_monotonic_time2(&job->endTime);
-                }
+                thread_run_job(&workGroup->jobs[i]);
             }
 
             if (cppadcg_pool_verbose) {
@@ -1078,6 +1616,42 @@ static void* thread_do(Thread* thread) {
 }
 
 
+/* Pins a thread to the CPU defined by the current affinity
+ * (or restores the CPUs allowed when it was created without an affinity)
+ *
+ * @param pthread       the thread
+ * @param thread        the thread in the pool
+ */
+static void thread_set_affinity(pthread_t pthread,
+                                const Thread* thread) {
+#if defined(__linux__)
+    cpu_set_t mask;
+    int cpu = -1;
+    int id = thread->id;
+    int info;
+
+    pthread_mutex_lock(&cppadcg_pool_affinity_lock);
+    if (cppadcg_pool_affinity == AFFINITY_NONE || cppadcg_pool_affinity_n_cpus == 0) {
+        mask = thread->original_mask;
+    } else {
+        cpu = cppadcg_pool_affinity_cpus[id % cppadcg_pool_affinity_n_cpus];
+        CPU_ZERO(&mask);
+        CPU_SET(cpu, &mask);
+    }
+
+    info = pthread_setaffinity_np(pthread, sizeof(cpu_set_t), &mask);
+    pthread_mutex_unlock(&cppadcg_pool_affinity_lock);
+
+    if (info != 0) {
+        fprintf(stderr, "thread_set_affinity(): failed to set the affinity of thread %i (error %i)\n", id, info);
+    } else if (cppadcg_pool_verbose && cpu >= 0) {
+        fprintf(stdout, "thread_set_affinity(): thread %i pinned to CPU %i\n", id, cpu);
+    }
+#else
+    fprintf(stderr, "thread_set_affinity(): thread affinity is not supported on this system\n");
+#endif
+}
+
 /* Frees a thread  */
 static void thread_destroy(Thread* thread) {
     free(thread);
@@ -1099,6 +1673,8 @@ static int jobqueue_init(ThPool* thpool) {
     queue->front = NULL;
     queue->rear = NULL;
     queue->group_front = NULL;
+    queue->ws_front = NULL;
+    queue->ws_pending = 0;
     queue->total_time = 0;
     queue->highest_expected_return = 0;
 
@@ -1130,6 +1706,8 @@ static void jobqueue_clear(ThPool* thpool) {
         }
     } while (size > 0);
 
+    jobqueue_release_batches(thpool);
+
     thpool->jobqueue->front = NULL;
     thpool->jobqueue->rear = NULL;
     bsem_reset(thpool->jobqueue->has_jobs);
@@ -1266,7 +1844,7 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
         // nothing to do
         group = NULL;
 
-    } else if (schedule_strategy == SCHED_DYNAMIC || queue->len == 1 || queue->total_time <= 0) {
+    } else if (schedule_strategy == SCHED_DYNAMIC || schedule_strategy == SCHED_WORK_STEALING || queue->len == 1 || queue->total_time <= 0) {
         // SCHED_DYNAMIC
         group = (WorkGroup*) malloc(sizeof(WorkGroup));
         group->prev = NULL;
@@ -1358,6 +1936,153 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
 }
 
 
+/**
+ * Removes the job at the bottom of a deque (only used by the thread which
+ * owns the deque).
+ *
+ * @return the job or NULL if the deque is empty
+ */
+static Job* workdeque_pop(WorkDeque* deque) {
+    Job* job;
+    long t;
+    long b = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+
+    __atomic_store_n(&deque->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    t = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+    if (t < b) {
+        return deque->jobs[b];
+    }
+
+    job = NULL;
+    if (t == b) {
+        /* last job: compete with the other threads */
+        job = deque->jobs[b];
+        if (!__atomic_compare_exchange_n(&deque->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            job = NULL;
+        }
+    }
+    __atomic_store_n(&deque->bottom, b + 1, __ATOMIC_RELAXED);
+
+    return job;
+}
+
+/**
+ * Removes the job at the top of a deque (used by threads which do not own
+ * the deque).
+ *
+ * @param lost set to 1 if the deque was not empty but the job was taken by
+ *             another thread
+ * @return the job or NULL if no job could be taken
+ */
+static Job* workdeque_steal(WorkDeque* deque,
+                            int* lost) {
+    Job* job;
+    long t = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long b = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+    if (t < b) {
+        job = deque->jobs[t];
+        if (__atomic_compare_exchange_n(&deque->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            return job;
+        }
+        *lost = 1; // true
+    }
+
+    return NULL;
+}
+
+/**
+ * Get a single job from the work stealing batches (removes it from the
+ * batch). The job is taken from the thread's own deque, or from the deques
+ * of other threads when the thread's deque is empty.
+ *
+ * Notice: Caller does NOT need to hold a mutex
+ */
+static Job* jobqueue_steal(ThPool* thpool,
+                           int id) {
+    JobQueue* queue = thpool->jobqueue;
+    WorkStealingBatch* batch;
+    Job* job = NULL;
+    int lost;
+    int i, v;
+
+    batch = __atomic_load_n(&queue->ws_front, __ATOMIC_ACQUIRE);
+
+    for (; batch != NULL && job == NULL; batch = batch->prev) {
+        if (id < batch->num_deques) {
+            job = workdeque_pop(&batch->deques[id]);
+        }
+
+        while (job == NULL) {
+            lost = 0; // false
+            for (i = 1; i <= batch->num_deques && job == NULL; ++i) {
+                v = (id + i) % batch->num_deques;
+                if (v != id) {
+                    job = workdeque_steal(&batch->deques[v], &lost);
+                }
+            }
+
+            if (job != NULL) {
+                if (cppadcg_pool_verbose) {
+                    __atomic_add_fetch(&batch->stolen, 1, __ATOMIC_RELAXED);
+                }
+            } else if (!lost) {
+                break; // all deques are empty
+            }
+        }
+    }
+
+    if (job != NULL) {
+        __atomic_sub_fetch(&queue->ws_pending, 1, __ATOMIC_ACQ_REL);
+    }
+
+    return job;
+}
+
+/**
+ * Frees the work stealing batches (all their jobs must have been completed).
+ */
+static void jobqueue_release_batches(ThPool* thpool) {
+    WorkStealingBatch* batch;
+    WorkStealingBatch* batchPrev;
+    struct timespec diffTime;
+    int bid = 0;
+
+    batch = thpool->jobqueue->ws_front;
+    thpool->jobqueue->ws_front = NULL;
+    thpool->jobqueue->ws_pending = 0;
+
+    while (batch != NULL) {
+        if (cppadcg_pool_verbose) {
+            fprintf(stdout, "# Batch %i, executed %i jobs (%i stolen)\n", bid, batch->size, batch->stolen);
+
+            for (int i = 0; i < batch->size; ++i) {
+                Job* job = &batch->jobs[i];
+
+                timespec_diff(&job->endTime, &job->startTime, &diffTime);
+                fprintf(stdout, "## Thread %i, Batch %i, Job %i, started at %ld.%.9ld, ended at %ld.%.9ld, elapsed %ld.%.9ld\n",
+                        job->thread_id, bid, job->id, job->startTime.tv_sec, job->startTime.tv_nsec, job->endTime.tv_sec, job->endTime.tv_nsec, diffTime.tv_sec,
+                        diffTime.tv_nsec);
+            }
+        }
+
+        bid++;
+
+        batchPrev = batch->prev;
+
+        // clean-up
+        free(batch->deques);
+        free(batch->jobs);
+        free(batch->job_slots);
+        free(batch);
+
+        batch = batchPrev;
+    }
+}
+
 /* Free all queue resources back to the system */
 static void jobqueue_destroy(ThPool* thpool) {
     jobqueue_clear(thpool);
@@ -21,12 +21,19 @@ extern "C" {
 
 enum ScheduleStrategy {SCHED_STATIC = 1,
                        SCHED_DYNAMIC = 2,
-                       SCHED_GUIDED = 3
+                       SCHED_GUIDED = 3,
+                       SCHED_WORK_STEALING = 4
                        };
 
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
                            ELAPSED_TIME_MIN};
 
+enum ThreadAffinity {AFFINITY_NONE = 0, // threads can run on any CPU
+                     AFFINITY_COMPACT = 1, // consecutive threads are pinned to CPUs in the same socket
+                     AFFINITY_SCATTER = 2, // consecutive threads are pinned to CPUs in different sockets
+                     AFFINITY_EXPLICIT = 3 // threads are pinned to the CPUs in a user provided list
+                     };
+
 typedef void (*cppadcg_thpool_function_type)(void*);
 
 
@@ -55,6 +62,13 @@ enum ElapsedTimeReference cppadcg_thpool_get_time_meas_ref();
 void cppadcg_thpool_set_time_meas_ref(enum ElapsedTimeReference r);
 
 
+void cppadcg_thpool_set_affinity(enum ThreadAffinity a,
+                                 const int cpus[],
+                                 int nCpus);
+
+enum ThreadAffinity cppadcg_thpool_get_affinity();
+
+
 void cppadcg_thpool_set_verbose(int v);
 
 int cppadcg_thpool_is_verbose();
@@ -83,6 +97,13 @@ void cppadcg_thpool_add_jobs(cppadcg_thpool_function_type functions[],
 
 void cppadcg_thpool_wait();
 
+void cppadcg_thpool_run_task_graph(cppadcg_thpool_function_type function,
+                                   void* args[],
+                                   const int nDeps[],
+                                   const int succStart[],
+                                   const int succ[],
+                                   int nTasks);
+
 void cppadcg_thpool_update_order(float refElapsed[],
                                  unsigned int nTimeMeas,
                                  const float elapsed[],
@@ -0,0 +1,162 @@
+#ifndef CPPAD_CG_OPERATION_NODE_POOL_INCLUDED
+#define CPPAD_CG_OPERATION_NODE_POOL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Memory pool for operation nodes owned by a CodeHandler.
+ *
+ * Nodes are placed in large contiguous blocks (slabs) instead of being
+ * individually allocated in the heap, which significantly reduces the
+ * number of memory allocations and keeps nodes created sequentially
+ * close to each other in memory.
+ * The pool only provides raw memory: constructing and destroying the nodes
+ * is the responsibility of the CodeHandler.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class OperationNodePool {
+private:
+    using Node = OperationNode<Base>;
+    using Storage = typename std::aligned_storage<sizeof(Node), alignof(Node)>::type;
+private:
+    /**
+     * the initial number of nodes in a slab
+     */
+    static const size_t MIN_SLAB_SIZE = 64;
+    /**
+     * the maximum number of nodes in a slab
+     */
+    static const size_t MAX_SLAB_SIZE = 1 << 16;
+    /**
+     * the allocated blocks of memory
+     */
+    std::vector<std::unique_ptr<Storage[]> > _slabs;
+    /**
+     * maps the start of each slab to its end (used to determine if some
+     * memory belongs to this pool)
+     */
+    std::map<const Storage*, const Storage*, std::less<const Storage*> > _slabEnd;
+    /**
+     * the next unused position in the last slab
+     */
+    Storage* _next;
+    /**
+     * the end of the last slab
+     */
+    Storage* _end;
+    /**
+     * released positions which can be reused
+     */
+    std::vector<Storage*> _free;
+    /**
+     * the number of nodes in the next slab
+     */
+    size_t _nextSlabSize;
+public:
+
+    inline OperationNodePool() :
+        _next(nullptr),
+        _end(nullptr),
+        _nextSlabSize(MIN_SLAB_SIZE) {
+    }
+
+    OperationNodePool(const OperationNodePool& orig) = delete;
+    OperationNodePool& operator=(const OperationNodePool& rhs) = delete;
+
+    /**
+     * Provides memory for a new operation node.
+     *
+     * @return uninitialized memory for a single operation node
+     */
+    inline void* allocate() {
+        if (!_free.empty()) {
+            Storage* s = _free.back();
+            _free.pop_back();
+            return s;
+        }
+
+        if (_next == _end) {
+            createSlab();
+        }
+
+        return _next++;
+    }
+
+    /**
+     * Returns memory of a previously destroyed node to the pool so that it
+     * can be reused.
+     *
+     * @param p memory previously provided by allocate()
+     */
+    inline void deallocate(void* p) {
+        CPPADCG_ASSERT_UNKNOWN(contains(p));
+        _free.push_back(static_cast<Storage*>(p));
+    }
+
+    /**
+     * Determines whether or not some memory was provided by this pool.
+     *
+     * @param p the memory address of an operation node
+     * @return true if the node memory is owned by this pool
+     */
+    inline bool contains(const void* p) const {
+        if (_slabEnd.empty())
+            return false;
+
+        const Storage* s = static_cast<const Storage*>(p);
+        auto it = _slabEnd.upper_bound(s);
+        if (it == _slabEnd.begin())
+            return false;
+        --it;
+        return std::less<const Storage*>()(s, it->second);
+    }
+
+    /**
+     * Releases all the memory in this pool.
+     *
+     * @warning all nodes created with memory from this pool must have
+     *          already been destroyed
+     */
+    inline void clear() {
+        _free.clear();
+        _slabEnd.clear();
+        _slabs.clear();
+        _next = nullptr;
+        _end = nullptr;
+        _nextSlabSize = MIN_SLAB_SIZE;
+    }
+
+private:
+
+    inline void createSlab() {
+        _slabs.emplace_back(new Storage[_nextSlabSize]);
+        _next = _slabs.back().get();
+        _end = _next + _nextSlabSize;
+        _slabEnd[_next] = _end;
+
+        _nextSlabSize = std::min<size_t>(2 * _nextSlabSize, MAX_SLAB_SIZE);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
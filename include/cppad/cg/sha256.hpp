@@ -0,0 +1,192 @@
+#ifndef CPPAD_CG_SHA256_INCLUDED
+#define CPPAD_CG_SHA256_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines the SHA-256 digest of a sequence of bytes.
+ * It is used to identify content (e.g. generated source files) and it is
+ * not meant for cryptographic purposes.
+ *
+ * @author Joao Leal
+ */
+class Sha256 {
+private:
+    uint32_t _state[8];
+    unsigned char _block[64];
+    size_t _blockSize;
+    uint64_t _length; // total number of bytes
+public:
+
+    inline Sha256() {
+        reset();
+    }
+
+    /**
+     * Restarts the digest computation
+     */
+    inline void reset() {
+        static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        std::copy(init, init + 8, _state);
+        _blockSize = 0;
+        _length = 0;
+    }
+
+    /**
+     * Adds more data to the digest computation
+     *
+     * @param data the data
+     * @param size the number of bytes in data
+     */
+    inline void update(const void* data,
+                       size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        _length += size;
+
+        while (size > 0) {
+            size_t n = std::min(size, 64 - _blockSize);
+            std::copy(bytes, bytes + n, _block + _blockSize);
+            _blockSize += n;
+            bytes += n;
+            size -= n;
+
+            if (_blockSize == 64) {
+                processBlock();
+                _blockSize = 0;
+            }
+        }
+    }
+
+    inline void update(const std::string& data) {
+        update(data.data(), data.size());
+    }
+
+    /**
+     * Finishes the digest computation.
+     * Must be followed by reset() before computing a new digest.
+     *
+     * @return the digest in hexadecimal format (64 characters)
+     */
+    inline std::string finish() {
+        uint64_t bits = _length * 8;
+
+        unsigned char padding = 0x80;
+        update(&padding, 1);
+        padding = 0;
+        while (_blockSize != 56) {
+            update(&padding, 1);
+        }
+
+        unsigned char length[8];
+        for (size_t i = 0; i < 8; i++) {
+            length[i] = (unsigned char) (bits >> (56 - 8 * i));
+        }
+        update(length, 8);
+
+        std::ostringstream os;
+        os << std::hex << std::setfill('0');
+        for (uint32_t s : _state) {
+            os << std::setw(8) << s;
+        }
+        return os.str();
+    }
+
+    /**
+     * Determines the SHA-256 digest of a string.
+     *
+     * @param data the data
+     * @return the digest in hexadecimal format (64 characters)
+     */
+    static inline std::string digest(const std::string& data) {
+        Sha256 sha;
+        sha.update(data);
+        return sha.finish();
+    }
+
+private:
+
+    static inline uint32_t rotr(uint32_t x, unsigned n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    inline void processBlock() {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; i++) {
+            w[i] = (uint32_t(_block[4 * i]) << 24) | (uint32_t(_block[4 * i + 1]) << 16) |
+                   (uint32_t(_block[4 * i + 2]) << 8) | uint32_t(_block[4 * i + 3]);
+        }
+        for (size_t i = 16; i < 64; i++) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = _state[0];
+        uint32_t b = _state[1];
+        uint32_t c = _state[2];
+        uint32_t d = _state[3];
+        uint32_t e = _state[4];
+        uint32_t f = _state[5];
+        uint32_t g = _state[6];
+        uint32_t h = _state[7];
+
+        for (size_t i = 0; i < 64; i++) {
+            uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + k[i] + w[i];
+            uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        _state[0] += a;
+        _state[1] += b;
+        _state[2] += c;
+        _state[3] += d;
+        _state[4] += e;
+        _state[5] += f;
+        _state[6] += g;
+        _state[7] += h;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef CPPAD_CG_SOURCE_FILE_SINK_INCLUDED
+#define CPPAD_CG_SOURCE_FILE_SINK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Receives generated source files as soon as each one is complete (e.g.
+ * to compile them while the remaining files are still being generated)
+ * instead of keeping all of them in memory.
+ *
+ * @author Joao Leal
+ */
+class SourceFileSink {
+public:
+
+    /**
+     * Provides a complete source file.
+     * This method can be called simultaneously from different threads.
+     *
+     * @param name the source file name (unique)
+     * @param source the content of the source file
+     */
+    virtual void addSource(const std::string& name,
+                           std::string&& source) = 0;
+
+    inline virtual ~SourceFileSink() = default;
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,150 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures the time required to create a large operation graph in a
+ * CodeHandler (taping), the time to generate C source code from it, and
+ * the peak memory usage of the process.
+ *
+ * Usage: speed_code_handler [number of operations] [number of repetitions]
+ */
+#include <sys/resource.h>
+
+#include <cppad/cg.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+
+namespace {
+
+size_t parseProgramArguments(int pos, int argc, char **argv, size_t defaultValue) {
+    if (argc > pos) {
+        std::istringstream is(argv[pos]);
+        size_t value;
+        is >> value;
+        return value;
+    }
+    return defaultValue;
+}
+
+/**
+ * @return the peak resident set size of this process (in MB)
+ */
+double peakRSS() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef CPPAD_CG_SYSTEM_APPLE
+    return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+    return usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+}
+
+/**
+ * Creates an operation graph with (approximately) nOps operations.
+ */
+std::vector<CGD> model(CodeHandler<Base>& handler,
+                       std::vector<CGD>& x,
+                       size_t nOps) {
+    handler.makeVariables(x);
+
+    const size_t m = x.size();
+    std::vector<CGD> y;
+    y.reserve(nOps / 16 + 1);
+
+    CGD v = x[0];
+    for (size_t k = 1; k < nOps; ++k) {
+        const CGD& xk = x[k % m];
+        switch (k % 8) {
+            case 0:
+                v = v + xk;
+                break;
+            case 1:
+                v = v * xk;
+                break;
+            case 2:
+                v = sin(v);
+                break;
+            case 3:
+                v = v - 2.0 * xk;
+                break;
+            case 4:
+                v = v / (xk + 1.0);
+                break;
+            case 5:
+                v = exp(-v);
+                break;
+            case 6:
+                v = -v;
+                break;
+            default:
+                v = v * v;
+        }
+
+        if (k % 16 == 0) {
+            y.push_back(v);
+            v = x[(k / 16) % m];
+        }
+    }
+    y.push_back(v);
+
+    return y;
+}
+
+}
+
+int main(int argc, char **argv) {
+    using namespace std::chrono;
+
+    size_t nOps = parseProgramArguments(1, argc, argv, 1000000);
+    size_t nRepeat = parseProgramArguments(2, argc, argv, 3);
+
+    std::cout << "operations: " << nOps << "\n"
+              << "repetitions: " << nRepeat << std::endl;
+
+    duration<double> tapeTime(0);
+    duration<double> srcTime(0);
+    size_t srcSize = 0;
+
+    for (size_t r = 0; r < nRepeat; ++r) {
+        steady_clock::time_point t0 = steady_clock::now();
+
+        CodeHandler<Base> handler(nOps + 128);
+        std::vector<CGD> x(100);
+        std::vector<CGD> y = model(handler, x, nOps);
+
+        steady_clock::time_point t1 = steady_clock::now();
+
+        LanguageC<Base> langC("double");
+        LangCDefaultVariableNameGenerator<Base> nameGen;
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        steady_clock::time_point t2 = steady_clock::now();
+
+        tapeTime += t1 - t0;
+        srcTime += t2 - t1;
+        srcSize = code.str().size();
+    }
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "taping (s): " << tapeTime.count() / nRepeat << "\n"
+              << "source generation (s): " << srcTime.count() / nRepeat << "\n"
+              << "source size (bytes): " << srcSize << "\n"
+              << "peak RSS (MB): " << std::setprecision(1) << peakRSS() << std::endl;
+}
@@ -0,0 +1,239 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures the evaluation time of the zero order forward mode, sparse
+ * Jacobian and sparse Hessian of the CSTR and distillation models compiled
+ * without strength reduction, with strict strength reduction, and with
+ * relaxed strength reduction (see CodeHandler::setReduceOperationStrength()).
+ * The largest relative difference to the values without strength reduction
+ * is also reported.
+ *
+ * Usage: speed_strength_reduction [number of evaluations]
+ */
+#include <cppad/cg.hpp>
+
+#include "../../../../test/cppad/cg/models/cstr.hpp"
+#include "../../../../test/cppad/cg/models/distillation.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+namespace {
+
+size_t parseProgramArguments(int pos, int argc, char **argv, size_t defaultValue) {
+    if (argc > pos) {
+        std::istringstream is(argv[pos]);
+        size_t value;
+        is >> value;
+        return value;
+    }
+    return defaultValue;
+}
+
+struct BenchmarkModel {
+    std::string name;
+    std::vector<ADCGD> (*function)(const std::vector<ADCGD>&);
+    std::vector<Base> xNorm; // the model is evaluated with these values
+};
+
+std::vector<ADCGD> cstr(const std::vector<ADCGD>& x) {
+    return CstrFunc<CGD>(x);
+}
+
+std::vector<ADCGD> distillation(const std::vector<ADCGD>& x) {
+    return distillationFunc<CGD>(x);
+}
+
+BenchmarkModel cstrModel() {
+    return BenchmarkModel{"cstr", &cstr,
+                          {0.3, 7.82e3, 304.65, 301.15, 2.3333e-04, 6.6667e-05, 6.2e14, 10080, 2e3, 10e3,
+                           1e-11, 6.6667e-05, 294.15, 294.15, 1000, 4184, -33488, 299.15, 302.65, 7e5,
+                           1203, 3.22, 950.0, 0.48649427192323, 1000, 4184, 0.014, 1e-7}};
+}
+
+BenchmarkModel distillationModel() {
+    const size_t nStage = 8;
+
+    std::vector<Base> xNorm;
+    for (size_t i = 0; i < nStage; i++) xNorm.push_back(12000 + 100 * i); // mWater
+    for (size_t i = 0; i < nStage; i++) xNorm.push_back(12000 - 100 * i); // mEthanol
+    for (size_t i = 0; i < nStage; i++) xNorm.push_back(360 + i * 2); // T
+    for (size_t i = 0; i < nStage; i++) xNorm.push_back(0.3 + 0.05 * i); // yWater
+    for (size_t i = 0; i < nStage; i++) xNorm.push_back(0.7 - 0.05 * i); // yEthanol
+    for (size_t i = 0; i < nStage - 1; i++) xNorm.push_back(8); // V
+    xNorm.insert(xNorm.end(), {150e3, // Qc
+                               250e3, 0.1, 2.5, 4, // Qsteam, Fdistillate, reflux, Frectifier
+                               30, 1.01325e5, 0.7, 366}); // feed, P, xFWater, Tfeed
+
+    return BenchmarkModel{"distillation", &distillation, xNorm};
+}
+
+/**
+ * Generates and compiles the model functions
+ */
+std::unique_ptr<DynamicLib<Base>> createLibrary(const BenchmarkModel& model,
+                                                bool reduce,
+                                                bool strict,
+                                                const std::string& libName) {
+    const size_t n = model.xNorm.size();
+
+    std::vector<ADCGD> x(n);
+    for (size_t j = 0; j < n; j++)
+        x[j] = 1.0;
+    CppAD::Independent(x);
+
+    std::vector<ADCGD> xs(n);
+    for (size_t j = 0; j < n; j++)
+        xs[j] = x[j] * model.xNorm[j];
+
+    std::vector<ADCGD> y = model.function(xs);
+
+    ADFun<CGD> fun;
+    fun.Dependent(y);
+
+    ModelCSourceGen<Base> cgen(fun, model.name);
+    cgen.setCreateForwardZero(true);
+    cgen.setCreateSparseJacobian(true);
+    cgen.setCreateSparseHessian(true);
+    cgen.setReduceOperationStrength(reduce);
+    cgen.setStrictFloatingPoint(strict);
+
+    ModelLibraryCSourceGen<Base> libcgen(cgen);
+    DynamicModelLibraryProcessor<Base> p(libcgen, libName);
+
+    GccCompiler<Base> compiler;
+    return p.createDynamicLibrary(compiler);
+}
+
+/**
+ * Evaluation times (in seconds per evaluation) and results
+ */
+struct Results {
+    double zeroTime;
+    double jacTime;
+    double hessTime;
+    std::vector<Base> y;
+    std::vector<Base> jac;
+    std::vector<Base> hess;
+};
+
+Results evaluate(GenericModel<Base>& model,
+                 size_t nEval) {
+    using namespace std::chrono;
+
+    const size_t n = model.Domain();
+    const size_t m = model.Range();
+
+    std::vector<Base> x(n, 1.0);
+    std::vector<Base> w(m, 1.0);
+
+    std::vector<size_t> rows, cols;
+    Results r;
+    r.y.resize(m);
+    model.JacobianSparsity(rows, cols);
+    r.jac.resize(rows.size());
+    model.HessianSparsity(rows, cols);
+    r.hess.resize(rows.size());
+
+    size_t const* row;
+    size_t const* col;
+
+    steady_clock::time_point t0 = steady_clock::now();
+    for (size_t k = 0; k < nEval; k++)
+        model.ForwardZero(ArrayView<const Base>(x), ArrayView<Base>(r.y));
+
+    steady_clock::time_point t1 = steady_clock::now();
+    for (size_t k = 0; k < nEval; k++)
+        model.SparseJacobian(ArrayView<const Base>(x), ArrayView<Base>(r.jac), &row, &col);
+
+    steady_clock::time_point t2 = steady_clock::now();
+    for (size_t k = 0; k < nEval; k++)
+        model.SparseHessian(ArrayView<const Base>(x), ArrayView<const Base>(w), ArrayView<Base>(r.hess), &row, &col);
+
+    steady_clock::time_point t3 = steady_clock::now();
+
+    r.zeroTime = duration<double>(t1 - t0).count() / nEval;
+    r.jacTime = duration<double>(t2 - t1).count() / nEval;
+    r.hessTime = duration<double>(t3 - t2).count() / nEval;
+    return r;
+}
+
+/**
+ * @return the largest relative difference between two vectors
+ */
+double maxRelativeDifference(const std::vector<Base>& v,
+                             const std::vector<Base>& ref) {
+    double diff = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+        double scale = std::max(std::abs(ref[i]), std::numeric_limits<Base>::min());
+        diff = std::max(diff, std::abs(v[i] - ref[i]) / scale);
+    }
+    return diff;
+}
+
+}
+
+int main(int argc, char **argv) {
+    size_t nEval = parseProgramArguments(1, argc, argv, 100000);
+
+    std::cout << "evaluations: " << nEval << std::endl;
+
+    struct Mode {
+        std::string name;
+        bool reduce;
+        bool strict;
+    };
+    std::vector<Mode> modes{{"none", false, true},
+                            {"strict", true, true},
+                            {"relaxed", true, false}};
+
+    for (const BenchmarkModel& bm : {cstrModel(), distillationModel()}) {
+        std::cout << "\n" << bm.name << "\n"
+                  << std::setw(8) << std::left << "mode" << std::right
+                  << std::setw(14) << "zero (us)"
+                  << std::setw(14) << "jac (us)"
+                  << std::setw(14) << "hess (us)"
+                  << std::setw(14) << "max rel diff" << std::endl;
+
+        Results ref;
+        for (size_t i = 0; i < modes.size(); i++) {
+            const Mode& mode = modes[i];
+            std::unique_ptr<DynamicLib<Base>> lib = createLibrary(bm, mode.reduce, mode.strict,
+                                                                  "speed_strength_reduction_" + bm.name + "_" + mode.name);
+            std::unique_ptr<GenericModel<Base>> model = lib->model(bm.name);
+
+            Results r = evaluate(*model, nEval);
+            if (i == 0)
+                ref = r;
+
+            double diff = std::max(maxRelativeDifference(r.y, ref.y),
+                                   std::max(maxRelativeDifference(r.jac, ref.jac),
+                                            maxRelativeDifference(r.hess, ref.hess)));
+
+            std::cout << std::setw(8) << std::left << mode.name << std::right
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(14) << r.zeroTime * 1e6
+                      << std::setw(14) << r.jacTime * 1e6
+                      << std::setw(14) << r.hessTime * 1e6
+                      << std::setw(14) << std::scientific << std::setprecision(2) << diff
+                      << std::endl;
+        }
+    }
+}
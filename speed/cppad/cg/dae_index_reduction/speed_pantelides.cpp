@@ -0,0 +1,250 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures the time required by the Pantelides method to reduce the index
+ * of a train of flash units (the flash model used in the tests connected in
+ * series) with the depth-first and the Hopcroft-Karp assignment algorithms.
+ *
+ * Usage: speed_pantelides [number of flash units] [number of repetitions]
+ */
+#include <cppad/cg.hpp>
+#include <cppad/cg/dae_index_reduction/pantelides.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+namespace {
+
+size_t parseProgramArguments(int pos, int argc, char **argv, size_t defaultValue) {
+    if (argc > pos) {
+        std::istringstream is(argv[pos]);
+        size_t value;
+        is >> value;
+        return value;
+    }
+    return defaultValue;
+}
+
+/**
+ * Typical values for the flash train variables
+ */
+std::vector<double> flashTrainValues(size_t nUnits) {
+    std::vector<double> x(6 * nUnits + 6 + 3 * nUnits, 0.0);
+    for (size_t k = 0; k < nUnits; k++) {
+        x[6 * k] = 2.5; // nEthanol
+        x[6 * k + 1] = 6.4; // nWater
+        x[6 * k + 2] = 91; // T
+        x[6 * k + 3] = 0.53; // yWater
+        x[6 * k + 4] = 0.47; // yEthanol
+        x[6 * k + 5] = 6.7; // FV
+    }
+    const size_t c = 6 * nUnits;
+    x[c] = 500; // Q
+    x[c + 1] = 10; // F_feed
+    x[c + 2] = 1; // p
+    x[c + 3] = 0.5; // xFEthanol
+    x[c + 4] = 50; // T_feed
+    // time and derivatives are zero
+    return x;
+}
+
+/**
+ * A train of flash units where the liquid leaving each unit is the feed of
+ * the next unit.
+ * Each unit has the same equations as the flash model used in the index
+ * reduction tests (index 2).
+ */
+ADFun<CGD>* flashTrain(size_t nUnits,
+                       std::vector<DaeVarInfo>& daeVar,
+                       const std::vector<double>& x) {
+    std::vector<ADCGD> U(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        U[i] = x[i];
+    }
+    Independent(U);
+
+    const size_t c = 6 * nUnits;
+    const size_t d = c + 6;
+
+    daeVar.resize(U.size());
+    for (size_t k = 0; k < nUnits; k++) {
+        std::string suffix = "__" + std::to_string(k);
+        daeVar[6 * k] = DaeVarInfo("nEthanol" + suffix);
+        daeVar[6 * k + 1] = DaeVarInfo("nWater" + suffix);
+        daeVar[6 * k + 2] = DaeVarInfo("T" + suffix);
+        daeVar[6 * k + 3] = DaeVarInfo("yWater" + suffix);
+        daeVar[6 * k + 4] = DaeVarInfo("yEthanol" + suffix);
+        daeVar[6 * k + 5] = DaeVarInfo("FV" + suffix);
+        daeVar[d + 3 * k] = int(6 * k);
+        daeVar[d + 3 * k + 1] = int(6 * k + 1);
+        daeVar[d + 3 * k + 2] = int(6 * k + 2);
+    }
+    for (size_t i = c; i < c + 5; i++)
+        daeVar[i].makeConstant();
+    daeVar[c + 5].makeIntegratedVariable();
+
+    const ADCGD& Q = U[c];
+    const ADCGD& p = U[c + 2];
+    ADCGD F_feed = U[c + 1];
+    ADCGD xFEthanol = U[c + 3];
+    ADCGD T_feed = U[c + 4];
+
+    std::vector<ADCGD> res(6 * nUnits);
+
+    for (size_t k = 0; k < nUnits; k++) {
+        const ADCGD& nEthanol = U[6 * k];
+        const ADCGD& nWater = U[6 * k + 1];
+        const ADCGD& T = U[6 * k + 2];
+        const ADCGD& yWater = U[6 * k + 3];
+        const ADCGD& yEthanol = U[6 * k + 4];
+        const ADCGD& FV = U[6 * k + 5];
+        const ADCGD& D__nEthanol__Dt_1 = U[d + 3 * k];
+        const ADCGD& D__nWater__Dt_1 = U[d + 3 * k + 1];
+        const ADCGD& D__T__Dt = U[d + 3 * k + 2];
+
+        ADCGD FNEthanol = xFEthanol * F_feed;
+        ADCGD n_lWater = nWater * 1000.;
+        ADCGD n_lEthanol = nEthanol * 1000.;
+        ADCGD m_lEthanol = n_lEthanol * 0.04606844;
+        ADCGD m_lWater = n_lWater * 0.0180152833;
+        ADCGD m = m_lEthanol + m_lWater;
+        ADCGD wEthanol = m_lEthanol / m;
+        ADCGD w_Water = 1 - wEthanol;
+        ADCGD rho = 1 / (w_Water / 983.159471259596 + wEthanol / 743.278841365274);
+        ADCGD V = m / rho;
+        ADCGD cWater = n_lWater / V;
+        ADCGD dh = V / 0.502654824574367;
+        ADCGD p_aux = p * 101325.;
+        ADCGD dp = 101325. - p_aux;
+        ADCGD v = sqrt((9.80665 * dh + dp / rho) * 2.);
+        ADCGD F_VL = v * 0.0005;
+        ADCGD FNLWater = cWater * F_VL;
+        ADCGD n = n_lEthanol + n_lWater;
+        ADCGD xWater = n_lWater / n;
+        ADCGD F_NL = FNLWater / xWater;
+        ADCGD FNLEthanol = F_NL - FNLWater;
+        ADCGD FNVWater = yWater * FV;
+        ADCGD FNVEthanol = FV - FNVWater;
+        ADCGD D__nEthanol__Dt = FNEthanol - FNLEthanol - FNVEthanol;
+        res[6 * k] = D__nEthanol__Dt_1 - (D__nEthanol__Dt * 0.001);
+
+        ADCGD FNFWater = F_feed - FNEthanol;
+        ADCGD D__nWater__Dt = FNFWater - FNLWater - FNVWater;
+        res[6 * k + 1] = D__nWater__Dt_1 - (D__nWater__Dt * 0.001);
+
+        ADCGD FMFEthanol = FNEthanol * 0.04606844;
+        ADCGD FMFWater = FNFWater * 0.0180152833;
+        ADCGD Tfeed = T_feed + 273.15;
+        ADCGD T_aux = T + 273.15;
+        ADCGD dQ_F = (FMFEthanol * 2898.42878374706 + FMFWater * 4186.92536027523) * (Tfeed - T_aux);
+        ADCGD dH_mVapEthanol = 50430. * pow(1 - T_aux / 514., 0.4989) * exp((0.4475 * T_aux) / 514.);
+        ADCGD T_r = T_aux / 647.;
+        ADCGD dH_mVapWater = 52053. * pow(1 - T_r, 0.3199 + -0.212 * T_r + 0.25795 * T_r * T_r);
+        ADCGD dH_mVap = yEthanol * dH_mVapEthanol + yWater * dH_mVapWater;
+        ADCGD dQ_vap = FV * dH_mVap;
+        ADCGD Q_1 = Q * 1000.;
+        ADCGD cp = wEthanol * 2898.42878374706 + w_Water * 4186.92536027523;
+        res[6 * k + 2] = D__T__Dt - (dQ_F - dQ_vap + Q_1) / (m * cp);
+
+        ADCGD pVapWater = 100000. * pow(10., 4.6543 - 1435.264 / (T_aux - 64.848));
+        ADCGD KWater = pVapWater / p_aux;
+        res[6 * k + 3] = yWater - xWater * KWater;
+
+        ADCGD xEthanol = 1 - xWater;
+        ADCGD pVapEthanol = exp(74.475 + -7164.3 / T_aux + -7.327 * log(T_aux) + 3.134e-06 * pow(T_aux, 2.));
+        ADCGD KEthanol = pVapEthanol / p_aux;
+        res[6 * k + 4] = yEthanol - xEthanol * KEthanol;
+
+        res[6 * k + 5] = yWater + yEthanol - 1;
+
+        // feed of the next unit
+        F_feed = F_NL;
+        xFEthanol = xEthanol;
+        T_feed = T;
+    }
+
+    return new ADFun<CGD>(U, res);
+}
+
+/**
+ * Reduces the index of the flash train and determines the elapsed time.
+ *
+ * @param augment the assignment algorithm (nullptr for the default one)
+ * @return the elapsed time in seconds
+ */
+double reduceIndex(size_t nUnits,
+                   AugmentPath<Base>* augment,
+                   size_t& structuralIndex) {
+    using namespace std::chrono;
+
+    std::vector<double> x = flashTrainValues(nUnits);
+    std::vector<DaeVarInfo> daeVar;
+    std::unique_ptr<ADFun<CGD> > fun(flashTrain(nUnits, daeVar, x));
+
+    std::vector<std::string> eqName; // empty
+
+    Pantelides<Base> pantelides(*fun, daeVar, eqName, x);
+    if (augment != nullptr)
+        pantelides.setAugmentPath(*augment);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> equationInfo;
+
+    steady_clock::time_point t0 = steady_clock::now();
+    std::unique_ptr<ADFun<CGD> > reducedFun = pantelides.reduceIndex(newDaeVar, equationInfo);
+    steady_clock::time_point t1 = steady_clock::now();
+
+    structuralIndex = pantelides.getStructuralIndex();
+
+    return duration<double>(t1 - t0).count();
+}
+
+}
+
+int main(int argc, char **argv) {
+    size_t nUnits = parseProgramArguments(1, argc, argv, 100);
+    size_t nRepeat = parseProgramArguments(2, argc, argv, 3);
+
+    std::cout << "flash units: " << nUnits << "\n"
+              << "equations: " << 6 * nUnits << "\n"
+              << "repetitions: " << nRepeat << std::endl;
+
+    double dfsTime = 0;
+    double hkTime = 0;
+    size_t dfsIndex = 0;
+    size_t hkIndex = 0;
+
+    for (size_t r = 0; r < nRepeat; ++r) {
+        dfsTime += reduceIndex(nUnits, nullptr, dfsIndex);
+
+        AugmentPathHopcroftKarp<Base> hk;
+        hkTime += reduceIndex(nUnits, &hk, hkIndex);
+    }
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "depth-first lookahead (s): " << dfsTime / nRepeat << "\n"
+              << "Hopcroft-Karp (s): " << hkTime / nRepeat << "\n"
+              << "structural index: " << dfsIndex << " / " << hkIndex << std::endl;
+
+    if (dfsIndex != hkIndex) {
+        std::cerr << "Different structural indexes!" << std::endl;
+        return 1;
+    }
+}
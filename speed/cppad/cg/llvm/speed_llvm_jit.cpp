@@ -0,0 +1,160 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Compares the throughput of sparse Jacobian evaluations of a model
+ * compiled into a dynamic library (GCC with -O3 -march=native) with the
+ * same model JIT compiled by LLVM using different options.
+ *
+ * The sources are generated only once (the compilation time of the dynamic
+ * library also includes the source generation).
+ *
+ * Usage: speed_llvm_jit [number of variables] [number of evaluations]
+ */
+#include <cppad/cg.hpp>
+#include <cppad/cg/model/llvm/llvm.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCG = AD<CGD>;
+
+namespace {
+
+size_t parseProgramArguments(int pos, int argc, char **argv, size_t defaultValue) {
+    if (argc > pos) {
+        std::istringstream is(argv[pos]);
+        size_t value;
+        is >> value;
+        return value;
+    }
+    return defaultValue;
+}
+
+std::unique_ptr<ADFun<CGD>> createModel(size_t n) {
+    std::vector<ADCG> x(n, 1.0);
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(n);
+    for (size_t i = 0; i < n; ++i) {
+        const ADCG& a = x[i];
+        const ADCG& b = x[(i + 1) % n];
+        const ADCG& c = x[(i + 7) % n];
+        y[i] = a * sin(b) + exp(-c * c) / (1.0 + a * a) - sqrt(1.0 + b * c * c);
+    }
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+/**
+ * @return the number of sparse Jacobian evaluations per second
+ */
+double benchmark(GenericModel<Base>& model,
+                 size_t n,
+                 size_t nEval) {
+    using namespace std::chrono;
+
+    std::vector<Base> x(n);
+    std::vector<Base> jac(model.JacobianSparsitySize());
+    for (size_t j = 0; j < n; ++j)
+        x[j] = 0.5 + 0.01 * j;
+
+    // warm up
+    model.SparseJacobian(x, jac);
+
+    steady_clock::time_point t0 = steady_clock::now();
+    for (size_t e = 0; e < nEval; ++e) {
+        x[e % n] += 1e-9;
+        model.SparseJacobian(x, jac);
+    }
+    duration<double> dt = steady_clock::now() - t0;
+
+    return nEval / dt.count();
+}
+
+void printResult(const std::string& name,
+                 double compileTime,
+                 double evalsPerSecond) {
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::fixed
+              << std::setw(14) << std::setprecision(3) << compileTime
+              << std::setw(18) << std::setprecision(0) << evalsPerSecond << std::endl;
+}
+
+}
+
+int main(int argc, char **argv) {
+    using namespace std::chrono;
+
+    size_t n = parseProgramArguments(1, argc, argv, 200);
+    size_t nEval = parseProgramArguments(2, argc, argv, 20000);
+
+    std::cout << "variables: " << n << "\n"
+              << "evaluations: " << nEval << "\n\n"
+              << std::left << std::setw(24) << "library"
+              << std::right << std::setw(14) << "compile (s)"
+              << std::setw(18) << "jacobians/s" << std::endl;
+
+    std::unique_ptr<ADFun<CGD>> fun = createModel(n);
+
+    ModelCSourceGen<Base> cSource(*fun, "model");
+    cSource.setCreateSparseJacobian(true);
+    ModelLibraryCSourceGen<Base> libSource(cSource);
+    libSource.setMultiThreading(MultiThreadingType::NONE);
+
+    /**
+     * dynamic library
+     */
+    {
+        GccCompiler<Base> compiler;
+        compiler.setCompileFlags({"-O3", "-march=native"});
+
+        DynamicModelLibraryProcessor<Base> p(libSource, "speed_llvm_jit_model");
+
+        steady_clock::time_point t0 = steady_clock::now();
+        std::unique_ptr<DynamicLib<Base>> lib = p.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<Base>> model = lib->model("model");
+        duration<double> dt = steady_clock::now() - t0;
+
+        printResult("gcc -O3 -march=native", dt.count(), benchmark(*model, n, nEval));
+    }
+
+    /**
+     * JIT
+     */
+    std::vector<std::pair<std::string, LlvmJitOptions>> configs;
+    configs.emplace_back("jit default", LlvmJitOptions());
+    for (unsigned int optLevel = 0; optLevel <= 3; ++optLevel) {
+        LlvmJitOptions o = LlvmJitOptions::aggressive();
+        o.setOptimizationLevel(optLevel);
+        configs.emplace_back("jit O" + std::to_string(optLevel) + " module host", o);
+    }
+
+    for (const auto& c : configs) {
+        LlvmModelLibraryProcessor<Base> p(libSource);
+        p.setJitOptions(c.second);
+
+        steady_clock::time_point t0 = steady_clock::now();
+        std::unique_ptr<LlvmModelLibrary<Base>> lib = p.create();
+        std::unique_ptr<GenericModel<Base>> model = lib->model("model");
+        duration<double> dt = steady_clock::now() - t0;
+
+        printResult(c.first, dt.count(), benchmark(*model, n, nEval));
+    }
+
+    llvm::llvm_shutdown();
+}
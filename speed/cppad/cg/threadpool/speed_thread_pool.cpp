@@ -0,0 +1,147 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Measures the time required by the pthread pool to execute many small jobs
+ * with different durations (similar to the jobs created for sparse
+ * Jacobians and Hessians) using each scheduling strategy.
+ *
+ * Usage: speed_thread_pool [number of jobs] [number of threads] [number of repetitions]
+ */
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <cppad/cg/model/threadpool/pthread_pool.h>
+
+namespace {
+
+size_t parseProgramArguments(int pos, int argc, char **argv, size_t defaultValue) {
+    if (argc > pos) {
+        std::istringstream is(argv[pos]);
+        size_t value;
+        is >> value;
+        return value;
+    }
+    return defaultValue;
+}
+
+struct JobArg {
+    size_t work;
+    double result;
+};
+
+/**
+ * A job whose duration is proportional to its amount of work
+ */
+void runJob(void* arg) {
+    JobArg* a = static_cast<JobArg*>(arg);
+    double v = 0;
+    for (size_t k = 0; k < a->work; ++k) {
+        v += std::sin(v + k);
+    }
+    a->result = v;
+}
+
+/**
+ * @return the average time (in seconds) to execute all jobs
+ */
+double benchmark(ScheduleStrategy strategy,
+                 std::vector<JobArg>& args,
+                 size_t nRepeat) {
+    using namespace std::chrono;
+
+    const int nJobs = int(args.size());
+    unsigned int nTimeMeas = cppadcg_thpool_get_n_time_meas();
+
+    std::vector<cppadcg_thpool_function_type> functions(nJobs, runJob);
+    std::vector<void*> jobArgs(nJobs);
+    std::vector<float> avgElapsed(nJobs, 0);
+    std::vector<float> elapsed(nJobs, 0);
+    std::vector<int> order(nJobs);
+    std::vector<int> job2Thread(nJobs, -1);
+    int lastElapsedChanged = 1;
+
+    for (int i = 0; i < nJobs; ++i) {
+        jobArgs[i] = &args[i];
+        order[i] = i;
+    }
+
+    cppadcg_thpool_set_scheduler_strategy(strategy);
+
+    duration<double> total(0);
+
+    // the first executions are used to determine the job durations
+    for (size_t r = 0; r < nTimeMeas + nRepeat; ++r) {
+        bool measure = r < nTimeMeas;
+
+        steady_clock::time_point t0 = steady_clock::now();
+
+        cppadcg_thpool_add_jobs(functions.data(), jobArgs.data(), avgElapsed.data(),
+                                measure ? elapsed.data() : nullptr,
+                                order.data(), job2Thread.data(), nJobs, lastElapsedChanged);
+        cppadcg_thpool_wait();
+
+        steady_clock::time_point t1 = steady_clock::now();
+
+        if (measure) {
+            cppadcg_thpool_update_order(avgElapsed.data(), (unsigned int) r, elapsed.data(), order.data(), nJobs);
+        } else {
+            lastElapsedChanged = 0;
+            total += t1 - t0;
+        }
+    }
+
+    return total.count() / nRepeat;
+}
+
+}
+
+int main(int argc, char **argv) {
+    size_t nJobs = parseProgramArguments(1, argc, argv, 2000);
+    size_t nThreads = parseProgramArguments(2, argc, argv, 4);
+    size_t nRepeat = parseProgramArguments(3, argc, argv, 200);
+
+    std::cout << "jobs: " << nJobs << "\n"
+              << "threads: " << nThreads << "\n"
+              << "repetitions: " << nRepeat << std::endl;
+
+    // small jobs with very different durations
+    std::vector<JobArg> args(nJobs);
+    for (size_t i = 0; i < nJobs; ++i) {
+        args[i].work = 20 + (i * 7919) % 400;
+        args[i].result = 0;
+    }
+
+    cppadcg_thpool_set_threads(int(nThreads));
+    cppadcg_thpool_set_n_time_meas(5);
+    cppadcg_thpool_prepare();
+
+    const std::pair<ScheduleStrategy, const char*> strategies[] = {{SCHED_STATIC, "static"},
+                                                                   {SCHED_DYNAMIC, "dynamic"},
+                                                                   {SCHED_GUIDED, "guided"},
+                                                                   {SCHED_WORK_STEALING, "work stealing"}};
+
+    std::cout << std::scientific << std::setprecision(4);
+    for (const auto& s : strategies) {
+        double t = benchmark(s.first, args, nRepeat);
+        std::cout << s.second << " (s): " << t << std::endl;
+    }
+
+    cppadcg_thpool_shutdown();
+}
@@ -17,6 +17,7 @@
 
 #include "CppADCGTest.hpp"
 #include "gccCompilerFlags.hpp"
+#include "modelSources.hpp"
 
 namespace CppAD {
 namespace cg {
@@ -37,6 +38,11 @@ protected:
     bool forwardOne = true;
     bool reverseOne = true;
     bool reverseTwo = true;
+    bool directExternalModelCalls = false;
+    // the source files generated for the outer model by testAtomicLibModelBridge()
+    std::map<std::string, std::string> _outerSources;
+    // the direct atomic functions of the outer model after the library was generated
+    std::map<std::string, std::string> _outerDirectAtomicFunctions;
 public:
 
     inline CppADCGDynamicAtomicNestedTest(const std::string& modelName,
@@ -630,8 +636,12 @@ private:
          * generate source code
          */
         ModelLibraryCSourceGen<double> compDynHelp(compHelp1, compHelp2);
-        std::string folder = std::string("nested_sources_atomiclibmodelbridge_") + (createOuterReverse2 ? "rev2_" : "dir_") + _modelName;
+        compDynHelp.setDirectExternalModelCalls(directExternalModelCalls);
+        std::string folder = std::string("nested_sources_atomiclibmodelbridge_") + (createOuterReverse2 ? "rev2_" : "dir_") +
+                (directExternalModelCalls ? "direct_" : "") + _modelName;
         SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(compDynHelp, folder);
+        _outerSources = getModelSources(compDynHelp, compHelp2);
+        _outerDirectAtomicFunctions = compHelp2.getDirectAtomicFunctions();
 
         /**
          * Create the dynamic library
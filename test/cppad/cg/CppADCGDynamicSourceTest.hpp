@@ -0,0 +1,118 @@
+#ifndef CPPAD_CG_TEST_CPPADCGDYNAMICSOURCETEST_INCLUDED
+#define CPPAD_CG_TEST_CPPADCGDYNAMICSOURCETEST_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+#include "modelSources.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Base class for the tests which compile a single model into a dynamic
+ * library (in SetUp()) so that it can be compared with the same model
+ * evaluated by CppAD
+ */
+class CppADCGDynamicSourceTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::unique_ptr<ADFun<double> > _funD;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicSourceTest(const std::vector<double>& x,
+                                    bool verbose = false,
+                                    bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model"),
+        x(x) {
+    }
+
+    /**
+     * The model used to generate the source code
+     */
+    virtual std::vector<ADCGD> model(const std::vector<ADCGD>& u) = 0;
+
+    /**
+     * The same model evaluated by CppAD
+     */
+    virtual std::vector<AD<double> > model(const std::vector<AD<double> >& u) = 0;
+
+    virtual void SetUp() {
+        _fun.reset(tape<CGD>());
+        _funD.reset(tape<double>());
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+        prepareSourceGen(compHelp);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+        prepareProcessor(p, compiler);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+    }
+
+    virtual void TearDown() {
+        _model.reset(nullptr);
+        _dynamicLib.reset(nullptr);
+        _fun.reset(nullptr);
+        _funD.reset(nullptr);
+    }
+
+protected:
+
+    /**
+     * Defines which functions are generated for the model
+     */
+    virtual void prepareSourceGen(ModelCSourceGen<double>& compHelp) = 0;
+
+    /**
+     * Allows changing how the dynamic library is created
+     */
+    virtual void prepareProcessor(DynamicModelLibraryProcessor<double>& p,
+                                  GccCompiler<double>& compiler) {
+    }
+
+    template<class T>
+    ADFun<T>* tape() {
+        std::vector<AD<T> > u(x.size());
+        for (size_t j = 0; j < u.size(); j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<AD<T> > Z = model(u);
+
+        return new ADFun<T>(u, Z);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,168 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGCommonSubexpressionTest : public CppADCGTest {
+protected:
+    using CGD = CppADCGTest::CGD;
+public:
+
+    inline CppADCGCommonSubexpressionTest(bool verbose = false,
+                                          bool printValues = false) :
+        CppADCGTest(verbose, printValues) {
+    }
+
+    std::string generate(bool cse) {
+        CodeHandler<double> handler;
+        handler.setEliminateCommonSubexpressions(cse);
+
+        std::vector<CGD> x(3);
+        handler.makeVariables(x);
+
+        // the same operations are created several times
+        std::vector<CGD> y(3);
+        y[0] = sin(x[0]) * (x[1] * x[2]);
+        y[1] = sin(x[0]) + x[2] * x[1];
+        y[2] = cos(x[1] * x[2]) / (sin(x[0]) + 2.0);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        if (verbose_) {
+            std::cout << code.str() << std::endl;
+        }
+
+        return code.str();
+    }
+
+    std::string generate(CodeHandler<double>& handler,
+                         std::vector<CGD>& y) {
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        if (verbose_) {
+            std::cout << code.str() << std::endl;
+        }
+
+        return code.str();
+    }
+
+    /**
+     * Evaluates the operation graph (after any changes made during the
+     * source code generation)
+     */
+    static std::vector<double> evaluate(CodeHandler<double>& handler,
+                                        const std::vector<CGD>& y,
+                                        const std::vector<double>& x) {
+        Evaluator<double, double, CGD> evaluator(handler);
+
+        std::vector<CGD> xNew(x.begin(), x.end());
+        std::vector<CGD> yNew = evaluator.evaluate(xNew, y);
+
+        std::vector<double> values(yNew.size());
+        for (size_t i = 0; i < yNew.size(); i++)
+            values[i] = yNew[i].getValue();
+        return values;
+    }
+
+    static size_t count(const std::string& text,
+                        const std::string& pattern) {
+        size_t n = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            n++;
+        }
+        return n;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGCommonSubexpressionTest, Disabled) {
+    std::string code = generate(false);
+
+    ASSERT_EQ(count(code, "sin("), 3u);
+    ASSERT_EQ(count(code, " * "), 4u);
+}
+
+TEST_F(CppADCGCommonSubexpressionTest, Enabled) {
+    std::string code = generate(true);
+
+    ASSERT_EQ(count(code, "sin("), 1u);
+    ASSERT_EQ(count(code, " * "), 2u); // x[1] * x[2] is computed once
+}
+
+TEST_F(CppADCGCommonSubexpressionTest, DuplicateDependents) {
+    CodeHandler<double> handler;
+    handler.setEliminateCommonSubexpressions(true);
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(3);
+    y[0] = x[0] * x[1];
+    y[1] = x[1] * x[0];
+    y[2] = x[0] * x[1] + 2.0;
+
+    std::string code = generate(handler, y);
+
+    ASSERT_EQ(count(code, " * "), 1u);
+    // the dependents must use the operation which is kept
+    ASSERT_EQ(y[0].getOperationNode(), y[1].getOperationNode());
+
+    std::vector<double> values = evaluate(handler, y, {2.0, 3.0});
+    ASSERT_EQ(values[0], 6.0);
+    ASSERT_EQ(values[1], 6.0);
+    ASSERT_EQ(values[2], 8.0);
+}
+
+TEST_F(CppADCGCommonSubexpressionTest, Parameters) {
+    CodeHandler<double> handler;
+    handler.setEliminateCommonSubexpressions(true);
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<CGD> y(4);
+    y[0] = x[0] / 0.0;
+    y[1] = x[0] / -0.0;
+    y[2] = x[1] + nan;
+    y[3] = x[1] + nan;
+
+    generate(handler, y);
+
+    // 0.0 and -0.0 are different parameters
+    ASSERT_NE(y[0].getOperationNode(), y[1].getOperationNode());
+    // identical NaNs are the same parameter
+    ASSERT_EQ(y[2].getOperationNode(), y[3].getOperationNode());
+
+    std::vector<double> values = evaluate(handler, y, {1.0, 1.0});
+    ASSERT_EQ(values[0], std::numeric_limits<double>::infinity());
+    ASSERT_EQ(values[1], -std::numeric_limits<double>::infinity());
+}
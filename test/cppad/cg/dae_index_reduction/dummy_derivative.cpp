@@ -74,6 +74,64 @@ TEST_F(IndexReductionTest, DummyDerivPendulum2D) {
     delete fun;
 }
 
+/**
+ * @test select the dummy derivatives using a sparse QR decomposition
+ */
+TEST_F(IndexReductionTest, DummyDerivPendulum2D_sparseQR) {
+    using namespace std;
+
+    std::vector<DaeVarInfo> daeVar;
+
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(5, 1.0);
+
+    x[0] = -0.994987; // x
+    x[1] = 0.1; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = x[0]; // dvxdt
+    x[10] = 9.80665 - x[1]; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setGenerateSemiExplicitDae(true);
+    dummyD.setReduceEquations(false);
+    dummyD.setSparseQRMinSize(1); // always use the sparse QR decomposition
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    // either x or y must become an algebraic variable
+    size_t algebraic = 0;
+    for (const DaeVarInfo& v : newDaeVar) {
+        if ((v.getName() == "x" || v.getName() == "y") && v.getDerivative() < 0) {
+            algebraic++;
+        }
+    }
+    ASSERT_EQ(size_t(1), algebraic);
+
+    delete fun;
+}
+
 /**
  * @test explicitly avoid using a variable as dummy derivative
  */
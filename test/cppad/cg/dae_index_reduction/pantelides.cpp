@@ -143,3 +143,45 @@ TEST_F(IndexReductionTest, PantelidesPendulum3D) {
 
     delete fun;
 }
+
+TEST_F(IndexReductionTest, PantelidesPendulum2DHopcroftKarp) {
+    using CGD = CG<double>;
+
+    std::vector<DaeVarInfo> daeVar;
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    AugmentPathHopcroftKarp<double> augment;
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    pantelides.setAugmentPath(augment);
+    pantelides.setVerbosity(Verbosity::High);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> equationInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = pantelides.reduceIndex(newDaeVar, equationInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    delete fun;
+}
@@ -65,3 +65,49 @@ TEST_F(IndexReductionTest, PantelidesFlash) {
 
     delete fun;
 }
+
+TEST_F(IndexReductionTest, PantelidesFlashHopcroftKarp) {
+    using CGD = CG<double>;
+
+    std::vector<double> x(15);
+    x[0] = 2.5;// nEthanol
+    x[1] = 6.4;// nWater
+    x[2] = 91;// T
+    x[3] = 0.53;// yWater
+    x[4] = 0.47;// yEthanol
+    x[5] = 6.7;// FV
+    x[6] = 500;// Q
+    x[7] = 10;// F_feed
+    x[8] = 1;// p
+    x[9] = 0.5;// xFEthanol
+    x[10] = 50;// T_feed
+
+    x[11] = 0;// time
+
+    x[12] = 0;// D__nEthanol__Dt
+    x[13] = 0;// D__nWater__Dt
+    x[14] = 0;// D__T__Dt
+
+    std::vector<DaeVarInfo> daeVar;
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Flash<CGD> (daeVar, x);
+
+    std::vector<std::string> eqName; // empty
+
+    AugmentPathHopcroftKarp<double> augment;
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    pantelides.setAugmentPath(augment);
+    pantelides.setVerbosity(Verbosity::Low);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> equationInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = pantelides.reduceIndex(newDaeVar, equationInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(2), pantelides.getStructuralIndex());
+
+    delete fun;
+}
@@ -0,0 +1,145 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGEvaluatorTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * A long chain of operations which would require a deep recursion
+ */
+std::vector<CGD> chainModel(const std::vector<CGD>& x,
+                            size_t n) {
+    std::vector<CGD> y(2);
+
+    CGD z = x[0];
+    for (size_t i = 0; i < n; i++) {
+        z = 0.5 * z + sin(x[1]) * 0.01;
+    }
+    y[0] = z;
+    y[1] = z * x[0] + x[1];
+
+    return y;
+}
+
+std::vector<double> chainModel(const std::vector<double>& x,
+                               size_t n) {
+    std::vector<double> y(2);
+
+    double z = x[0];
+    for (size_t i = 0; i < n; i++) {
+        z = 0.5 * z + std::sin(x[1]) * 0.01;
+    }
+    y[0] = z;
+    y[1] = z * x[0] + x[1];
+
+    return y;
+}
+
+} // namespace
+
+TEST_F(CppADCGEvaluatorTest, Iterative) {
+    ModelType model = [](const std::vector<CGD>& x) {
+        std::vector<CGD> y(3);
+        y[0] = x[0] * x[1] + exp(x[0]);
+        y[1] = CondExpLt(x[0], x[1], y[0], x[1] - y[0]);
+        y[2] = 2.0;
+        return y;
+    };
+
+    std::vector<double> testValues{0.5, 1.5};
+
+    CodeHandler<double> handlerOrig;
+    std::vector<CGD> xOrig(testValues.size());
+    handlerOrig.makeVariables(xOrig);
+    for (size_t j = 0; j < xOrig.size(); j++)
+        xOrig[j].setValue(testValues[j]);
+
+    const std::vector<CGD> yOrig = model(xOrig);
+
+    // CG<double>
+    {
+        CodeHandler<double> handlerNew;
+        std::vector<CGD> xNew(testValues.size());
+        handlerNew.makeVariables(xNew);
+        for (size_t j = 0; j < testValues.size(); j++)
+            xNew[j].setValue(testValues[j]);
+
+        Evaluator<Base, Base, CGD> evaluator(handlerOrig);
+        evaluator.setIterative(true);
+        ASSERT_TRUE(evaluator.isIterative());
+
+        std::vector<CGD> yNew = evaluator.evaluate(xNew, yOrig);
+
+        ASSERT_EQ(yNew.size(), yOrig.size());
+        for (size_t i = 0; i < yOrig.size(); i++) {
+            ASSERT_EQ(yNew[i].isVariable(), yOrig[i].isVariable());
+            ASSERT_EQ(yNew[i].getValue(), yOrig[i].getValue());
+        }
+    }
+
+    // AD<double>
+    {
+        std::vector<AD<Base> > xNew(testValues.size());
+        for (size_t j = 0; j < xNew.size(); j++)
+            xNew[j] = testValues[j];
+
+        CppAD::Independent(xNew);
+
+        Evaluator<Base, Base, AD<Base> > evaluator(handlerOrig);
+        evaluator.setIterative(true);
+        std::vector<AD<Base> > yNew = evaluator.evaluate(xNew, yOrig);
+
+        CppAD::ADFun<Base> fun;
+        fun.Dependent(yNew);
+
+        std::vector<Base> yBase = fun.Forward(0, testValues);
+
+        ASSERT_EQ(yBase.size(), yOrig.size());
+        for (size_t i = 0; i < yOrig.size(); i++) {
+            ASSERT_EQ(yBase[i], yOrig[i].getValue());
+        }
+    }
+}
+
+TEST_F(CppADCGEvaluatorTest, IterativeDeepChain) {
+    const size_t n = 200000;
+
+    CodeHandler<double> handlerOrig;
+    std::vector<CGD> xOrig(2);
+    handlerOrig.makeVariables(xOrig);
+
+    const std::vector<CGD> yOrig = chainModel(xOrig, n);
+
+    Evaluator<Base, Base, CGD> evaluator(handlerOrig);
+    evaluator.setIterative(true);
+
+    // the same evaluation order is reused for different independent variables
+    for (double x0 : {0.5, 2.0, -1.0}) {
+        std::vector<double> x{x0, 1.0 + x0};
+        std::vector<CGD> xNew{CGD(x[0]), CGD(x[1])};
+
+        std::vector<CGD> yNew = evaluator.evaluate(xNew, yOrig);
+        std::vector<double> yExpected = chainModel(x, n);
+
+        ASSERT_EQ(yNew.size(), yExpected.size());
+        for (size_t i = 0; i < yNew.size(); i++) {
+            ASSERT_TRUE(yNew[i].isParameter());
+            ASSERT_TRUE(nearEqual(yNew[i].getValue(), yExpected[i]));
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/cppadcg.hpp>
+#include <gtest/gtest.h>
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGTest, SparsityPatternIndexes) {
+    // unsorted and with a repeated element
+    std::vector<size_t> rows{2, 0, 2, 0, 2, 3};
+    std::vector<size_t> cols{1, 3, 0, 0, 1, 2};
+
+    SparsityPattern p(4, 5, rows, cols);
+
+    ASSERT_EQ(p.rows(), 4u);
+    ASSERT_EQ(p.columns(), 5u);
+    ASSERT_EQ(p.nnz(), 5u);
+    ASSERT_EQ(p.rowSize(1), 0u);
+
+    std::vector<std::set<size_t> > expected{{0, 3}, {}, {0, 1}, {2}};
+    ASSERT_TRUE(p.toSet() == expected);
+
+    ASSERT_TRUE(p.contains(2, 1));
+    ASSERT_FALSE(p.contains(2, 2));
+    ASSERT_FALSE(p.contains(1, 0));
+
+    std::vector<size_t> rows2, cols2;
+    generateSparsityIndexes(p, rows2, cols2);
+    ASSERT_TRUE(rows2 == (std::vector<size_t>{0, 0, 2, 2, 3}));
+    ASSERT_TRUE(cols2 == (std::vector<size_t>{0, 3, 0, 1, 2}));
+
+    std::vector<bool> b = p.toBool();
+    ASSERT_EQ(b.size(), 20u);
+    ASSERT_TRUE(b[0 * 5 + 3]);
+    ASSERT_FALSE(b[1 * 5 + 3]);
+}
+
+TEST_F(CppADCGTest, SparsityPatternSet) {
+    std::vector<std::set<size_t> > s{{1, 2, 70}, {}, {0, 65, 127, 128}};
+
+    SparsityPattern p = SparsityPattern::fromSet(s, 130);
+    ASSERT_TRUE(p.toSet() == s);
+    ASSERT_EQ(p.nnz(), 7u);
+
+    ArrayView<const size_t> r2 = p.row(2);
+    ASSERT_EQ(r2.size(), 4u);
+    ASSERT_EQ(r2[1], 65u);
+
+    // bitsets must not change the results
+    SparsityPattern pb = p;
+    pb.useBitsets();
+    ASSERT_TRUE(pb == p);
+    for (size_t i = 0; i < s.size(); i++) {
+        for (size_t j = 0; j < 130; j++) {
+            ASSERT_EQ(pb.contains(i, j), s[i].find(j) != s[i].end());
+            ASSERT_EQ(p.contains(i, j), s[i].find(j) != s[i].end());
+        }
+    }
+}
+
+TEST_F(CppADCGTest, SparsityPatternModel) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(3);
+    Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = x[0] * x[1];
+    y[1] = sin(x[2]) + x[0];
+
+    ADFun<CGD> fun(x, y);
+
+    std::vector<std::set<size_t> > jacSet = jacobianSparsitySet<std::vector<std::set<size_t> > >(fun);
+    ASSERT_TRUE(jacobianSparsityPattern(fun).toSet() == jacSet);
+
+    std::vector<std::set<size_t> > hessSet = hessianSparsitySet<std::vector<std::set<size_t> > >(fun);
+    SparsityPattern hess = hessianSparsityPattern(fun);
+    ASSERT_TRUE(hess.toSet() == hessSet);
+    ASSERT_TRUE(hess.contains(0, 1));
+    ASSERT_TRUE(hess.contains(2, 2));
+    ASSERT_FALSE(hess.contains(0, 0));
+}
+
+TEST_F(CppADCGTest, SparsityPatternModelForward) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    // more dependents than independents (forward mode)
+    std::vector<ADCG> x(2);
+    Independent(x);
+
+    std::vector<ADCG> y(3);
+    y[0] = x[0] * x[1];
+    y[1] = exp(x[1]);
+    y[2] = 2.0 * x[0];
+
+    ADFun<CGD> fun(x, y);
+
+    std::vector<std::set<size_t> > jacSet = jacobianSparsitySet<std::vector<std::set<size_t> > >(fun);
+    SparsityPattern jac = jacobianSparsityPattern(fun);
+    ASSERT_TRUE(jac.toSet() == jacSet);
+    ASSERT_EQ(jac.rows(), 3u);
+    ASSERT_EQ(jac.columns(), 2u);
+    ASSERT_EQ(jac.nnz(), 4u);
+}
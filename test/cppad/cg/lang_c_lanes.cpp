@@ -0,0 +1,124 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGOperationTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+template<class T>
+std::vector<T> model(const std::vector<T>& x) {
+    std::vector<T> y(3);
+    y[0] = sin(x[0]) * x[1] + 2.0;
+    y[1] = CondExpLt(x[0], x[1], pow(x[0], x[1]), exp(x[1]) - x[0]);
+    y[2] = sign(x[1] - 1.0) * abs(x[0]);
+    return y;
+}
+
+}
+
+TEST_F(CppADCGOperationTest, LanguageCLanes) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    const size_t n = 2;
+    const size_t m = 3;
+    const size_t lanes = 4;
+
+    /**
+     * tape the model
+     */
+    std::vector<ADCG> ax(n, 1.0);
+    Independent(ax);
+    ADFun<CGD> fun(ax, model(ax));
+
+    std::vector<AD<double> > adx(n, 1.0);
+    Independent(adx);
+    ADFun<double> funD(adx, model(adx));
+
+    /**
+     * generate and compile the source code
+     */
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    std::vector<CGD> y = fun.Forward(0, x);
+
+    LanguageCLanes<double> langC("double", lanes);
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    const std::string& t = langC.getLaneTypeName();
+    std::string source = langC.generateLaneTypeDefinition() +
+            "int model_lanes(" + t + " const* x, " + t + "* y) {\n" +
+            langC.generateTemporaryVariableDeclaration() +
+            code.str() +
+            "   return 0;\n"
+            "}\n";
+
+    if (verbose_) {
+        std::cout << std::endl << source << std::endl;
+    }
+
+    std::string library = "./tmp/lang_c_lanes.so";
+    compile(source, library);
+
+    void* libHandle = loadLibrary(library);
+
+    int (*fn)(const double*, double*) = nullptr;
+    try {
+        *(void **) (&fn) = getFunction(libHandle, "model_lanes");
+    } catch (const std::exception& ex) {
+        closeLibrary(libHandle);
+        throw;
+    }
+
+    /**
+     * evaluate 4 points with a single call
+     */
+    std::vector<double> xLanes(n * lanes);
+    for (size_t l = 0; l < lanes; l++) {
+        xLanes[0 * lanes + l] = 0.5 + 0.5 * l;
+        xLanes[1 * lanes + l] = 2.0 - 0.5 * l;
+    }
+    std::vector<double> yLanes(m * lanes);
+
+    (*fn)(&xLanes[0], &yLanes[0]);
+
+    closeLibrary(libHandle);
+
+    for (size_t l = 0; l < lanes; l++) {
+        std::vector<double> xl(n);
+        for (size_t j = 0; j < n; j++)
+            xl[j] = xLanes[j * lanes + l];
+
+        std::vector<double> yl = funD.Forward(0, xl);
+
+        for (size_t i = 0; i < m; i++) {
+            ASSERT_TRUE(nearEqual(yLanes[i * lanes + l], yl[i]));
+        }
+    }
+}
+
+TEST_F(CppADCGOperationTest, LanguageCLanesElementType) {
+    // the vector size depends on the emitted element type and not on Base
+    LanguageCLanes<double> langC("float", 8);
+
+    std::string source = langC.generateLaneTypeDefinition();
+    ASSERT_NE(source.find("vector_size(8 * sizeof(float))"), std::string::npos);
+}
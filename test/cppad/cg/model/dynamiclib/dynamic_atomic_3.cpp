@@ -99,6 +99,18 @@ TEST_F(CppADCGDynamicAtomicSmallerNestedTest, AtomicLibModelBridge) {
     this->testAtomicLibModelBridge(xOuter, xInner, xNorm, eqNorm, 1e-14, 1e-13);
 }
 
+TEST_F(CppADCGDynamicAtomicSmallerNestedTest, AtomicLibModelBridgeDirectCalls) {
+    this->directExternalModelCalls = true;
+    this->testAtomicLibModelBridge(xOuter, xInner, xNorm, eqNorm, 1e-14, 1e-13);
+
+    // the outer model calls the inner model without the atomic function callbacks
+    const std::string file = _modelName + "_outer_" + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO + ".c";
+    ASSERT_TRUE(sourceContains(_outerSources, file, _modelName + "_atomic_forward(")) << file;
+
+    // the user defined direct atomic functions are not changed by the library
+    ASSERT_TRUE(_outerDirectAtomicFunctions.empty());
+}
+
 TEST_F(CppADCGDynamicAtomicSmallerNestedTest, AtomicLibModelBridgeCustomRev2) {
     this->testAtomicLibModelBridgeCustom(xOuter, xInner, xNorm, eqNorm,
                                          jacInner, hessInner,
@@ -0,0 +1,162 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicBatchTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    const static size_t nPoints;
+    ADFun<CGD>* _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicBatchTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model"),
+        _fun(nullptr) {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = 1.0;
+
+        CppAD::Independent(u);
+
+        // dependent variable vector
+        std::vector<ADCG> Z(m);
+        Z[0] = u[0] * sin(u[1]) + 2.0;
+        Z[1] = exp(u[2]) / (u[1] + 3.0);
+
+        _fun = new ADFun<CGD>(u, Z);
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateBatchFunctions(true);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        ASSERT_TRUE(_model->isForwardZeroBatchAvailable());
+        ASSERT_TRUE(_model->isSparseJacobianBatchAvailable());
+    }
+
+    virtual void TearDown() {
+        _dynamicLib.reset(nullptr);
+        _model.reset(nullptr);
+        delete _fun;
+        _fun = nullptr;
+    }
+
+    /**
+     * Creates the independent variables for all points using a
+     * structure-of-arrays layout
+     */
+    inline std::vector<double> createPoints() const {
+        std::vector<double> x(n * nPoints);
+        for (size_t j = 0; j < n; j++) {
+            for (size_t p = 0; p < nPoints; p++) {
+                x[j * nPoints + p] = 0.5 + 0.1 * j + 0.25 * p;
+            }
+        }
+        return x;
+    }
+
+    inline std::vector<double> getPoint(const std::vector<double>& x,
+                                        size_t p) const {
+        std::vector<double> xp(n);
+        for (size_t j = 0; j < n; j++) {
+            xp[j] = x[j * nPoints + p];
+        }
+        return xp;
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicBatchTest::n = 3;
+const size_t CppADCGDynamicBatchTest::m = 2;
+const size_t CppADCGDynamicBatchTest::nPoints = 5;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicBatchTest, ForwardZeroBatch) {
+    std::vector<double> x = createPoints();
+    std::vector<double> y(m * nPoints);
+
+    _model->ForwardZeroBatch(nPoints, x, y);
+
+    for (size_t p = 0; p < nPoints; p++) {
+        std::vector<double> yp = _model->ForwardZero(getPoint(x, p));
+        for (size_t i = 0; i < m; i++) {
+            ASSERT_TRUE(nearEqual(y[i * nPoints + p], yp[i]));
+        }
+    }
+}
+
+TEST_F(CppADCGDynamicBatchTest, SparseJacobianBatch) {
+    std::vector<double> x = createPoints();
+
+    std::vector<double> jacp;
+    std::vector<size_t> rows, cols;
+    _model->SparseJacobian(getPoint(x, 0), jacp, rows, cols);
+    size_t nnz = jacp.size();
+
+    std::vector<double> jac(nnz * nPoints);
+    size_t const* row;
+    size_t const* col;
+    _model->SparseJacobianBatch(nPoints, x, jac, &row, &col);
+
+    for (size_t e = 0; e < nnz; e++) {
+        ASSERT_EQ(row[e], rows[e]);
+        ASSERT_EQ(col[e], cols[e]);
+    }
+
+    for (size_t p = 0; p < nPoints; p++) {
+        _model->SparseJacobian(getPoint(x, p), jacp, rows, cols);
+        for (size_t e = 0; e < nnz; e++) {
+            ASSERT_TRUE(nearEqual(jac[e * nPoints + p], jacp[e]));
+        }
+    }
+}
@@ -0,0 +1,183 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A compiler which counts the number of created libraries
+ */
+template<class Base>
+class CountingGccCompiler : public GccCompiler<Base> {
+public:
+    size_t builds = 0;
+
+    void buildDynamic(const std::string& library,
+                      JobTimer* timer = nullptr) override {
+        builds++;
+        GccCompiler<Base>::buildDynamic(library, timer);
+    }
+};
+
+class CppADCGDynamicCacheTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const std::string _cacheFolder;
+    const static size_t n;
+    const static size_t m;
+    std::unique_ptr<ADFun<CGD>> _fun;
+    std::unique_ptr<ModelCSourceGen<double>> _compHelp;
+    std::unique_ptr<ModelLibraryCSourceGen<double>> _compDynHelp;
+    CountingGccCompiler<double> _compiler;
+public:
+
+    inline CppADCGDynamicCacheTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model"),
+        _cacheFolder("cppadcg_cache_test") {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = 1.0;
+
+        CppAD::Independent(u);
+
+        // dependent variable vector
+        std::vector<ADCG> Z(m);
+        Z[0] = u[0] * u[1] * sin(u[2]);
+        Z[1] = exp(u[0]) + u[2] * u[2];
+
+        _fun.reset(new ADFun<CGD>(u, Z));
+
+        _compHelp.reset(new ModelCSourceGen<double>(*_fun, _modelName));
+        _compHelp->setCreateForwardZero(true);
+        _compHelp->setCreateSparseJacobian(true);
+
+        _compDynHelp.reset(new ModelLibraryCSourceGen<double>(*_compHelp));
+
+        prepareTestCompilerFlags(_compiler);
+
+        DynamicLibraryCache(_cacheFolder).clear();
+    }
+
+    virtual void TearDown() {
+        DynamicLibraryCache(_cacheFolder).clear();
+        _compDynHelp.reset();
+        _compHelp.reset();
+        _fun.reset();
+    }
+
+    std::unique_ptr<DynamicLib<double>> createLibrary(DynamicLibraryCache& cache,
+                                                      bool loadLib = true) {
+        DynamicModelLibraryProcessor<double> p(*_compDynHelp, "cppad_cg_cache_model");
+        p.setLibraryCache(cache);
+        return p.createDynamicLibrary(_compiler, loadLib);
+    }
+
+    size_t countCachedLibraries() const {
+        size_t count = 0;
+        for (const std::string& f : system::listFiles(_cacheFolder)) {
+            if (f.compare(0, 8, "cppadcg_") == 0)
+                count++;
+        }
+        return count;
+    }
+
+    void testModel(DynamicLib<double>& lib) {
+        std::unique_ptr<GenericModel<double>> model = lib.model(_modelName);
+        ASSERT_TRUE(model != nullptr);
+
+        std::vector<double> x{0.5, 1.5, 0.3};
+        std::vector<double> y = model->ForwardZero(x);
+        std::vector<double> yOrig{x[0] * x[1] * std::sin(x[2]), std::exp(x[0]) + x[2] * x[2]};
+        ASSERT_TRUE(compareValues(y, yOrig));
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicCacheTest::n = 3;
+const size_t CppADCGDynamicCacheTest::m = 2;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicCacheTest, Hit) {
+    DynamicLibraryCache cache(_cacheFolder);
+
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary(cache);
+    ASSERT_EQ(_compiler.builds, 1u);
+    ASSERT_EQ(countCachedLibraries(), 1u);
+    testModel(*lib);
+    lib.reset();
+
+    // the same sources and compiler options: no compilation
+    lib = createLibrary(cache);
+    ASSERT_EQ(_compiler.builds, 1u);
+    ASSERT_EQ(countCachedLibraries(), 1u);
+    testModel(*lib);
+    lib.reset();
+
+    // the cached library is copied to the library path
+    std::string libName = "cppad_cg_cache_model" + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+    std::remove(libName.c_str());
+    lib = createLibrary(cache, false);
+    ASSERT_TRUE(lib == nullptr);
+    ASSERT_EQ(_compiler.builds, 1u);
+    ASSERT_TRUE(system::isFile(libName));
+}
+
+TEST_F(CppADCGDynamicCacheTest, CompilerOptions) {
+    DynamicLibraryCache cache(_cacheFolder);
+
+    createLibrary(cache);
+    ASSERT_EQ(_compiler.builds, 1u);
+
+    // different compiler options must create a new library
+    _compiler.addCompileFlag("-DCPPADCG_CACHE_TEST");
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary(cache);
+    ASSERT_EQ(_compiler.builds, 2u);
+    ASSERT_EQ(countCachedLibraries(), 2u);
+    testModel(*lib);
+}
+
+TEST_F(CppADCGDynamicCacheTest, Eviction) {
+    // only enough space for one library
+    DynamicLibraryCache cache(_cacheFolder, 1);
+
+    createLibrary(cache);
+    ASSERT_EQ(countCachedLibraries(), 1u);
+
+    _compiler.addCompileFlag("-DCPPADCG_CACHE_TEST");
+    createLibrary(cache);
+    ASSERT_EQ(_compiler.builds, 2u);
+    ASSERT_EQ(countCachedLibraries(), 1u); // the oldest library was removed
+
+    // the most recent library is still in the cache
+    createLibrary(cache);
+    ASSERT_EQ(_compiler.builds, 2u);
+}
@@ -156,3 +156,33 @@ TEST_F(CppADCGDynamicForRevTest2, SparseHessian) {
 
     ASSERT_TRUE(compareValues(hessCG, hessOrig));
 }
+
+TEST_F(CppADCGDynamicForRevTest2, CachedSparsity) {
+    using std::vector;
+
+    vector<size_t> rows, cols;
+    _model->JacobianSparsity(rows, cols);
+
+    ArrayView<const size_t> jacRows = _model->JacobianSparsityRows();
+    ArrayView<const size_t> jacCols = _model->JacobianSparsityCols();
+    ASSERT_EQ(vector<size_t>(jacRows.begin(), jacRows.end()), rows);
+    ASSERT_EQ(vector<size_t>(jacCols.begin(), jacCols.end()), cols);
+
+    // values written directly into a buffer owned by the caller
+    vector<double> jac(jacRows.size());
+    size_t const* row;
+    size_t const* col;
+    _model->SparseJacobian(x, jac, &row, &col);
+    ASSERT_EQ(row, jacRows.data());
+    ASSERT_EQ(col, jacCols.data());
+
+    vector<double> jacValues;
+    _model->SparseJacobian(x, jacValues, rows, cols);
+    ASSERT_TRUE(compareValues(jac, jacValues));
+
+    _model->HessianSparsity(rows, cols);
+    ArrayView<const size_t> hessRows = _model->HessianSparsityRows();
+    ArrayView<const size_t> hessCols = _model->HessianSparsityCols();
+    ASSERT_EQ(vector<size_t>(hessRows.begin(), hessRows.end()), rows);
+    ASSERT_EQ(vector<size_t>(hessCols.begin(), hessCols.end()), cols);
+}
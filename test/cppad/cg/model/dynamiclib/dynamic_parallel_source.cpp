@@ -0,0 +1,232 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicSourceTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Tests the directional functions whose source code is generated by
+ * several threads
+ */
+class CppADCGDynamicParallelSourceTest : public CppADCGDynamicSourceTest {
+protected:
+    const static size_t n;
+    const static size_t m;
+public:
+
+    inline CppADCGDynamicParallelSourceTest(bool verbose = false, bool printValues = false) :
+        CppADCGDynamicSourceTest({0.5, 1.5, 2.0, -1.0, 0.8}, verbose, printValues) {
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& u) override {
+        return equations(u);
+    }
+
+    std::vector<AD<double> > model(const std::vector<AD<double> >& u) override {
+        return equations(u);
+    }
+
+protected:
+
+    void prepareSourceGen(ModelCSourceGen<double>& compHelp) override {
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateReverseOne(true);
+        compHelp.setCreateReverseTwo(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setSparseJacobianReuse1stOrderPasses(true);
+        compHelp.setSparseHessianReusesRev2(true);
+        compHelp.setMaxParallelJobs(3);
+    }
+
+    /**
+     * Generates the source code of the directional functions of a model
+     * (without compiling it)
+     *
+     * @param fun the model
+     * @param maxJobs the maximum number of threads generating source code
+     */
+    std::map<std::string, std::string> generateDirectionalSources(ADFun<CGD>& fun,
+                                                                  size_t maxJobs) {
+        ModelCSourceGen<double> compHelp(fun, _modelName);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateReverseOne(true);
+        compHelp.setCreateReverseTwo(true);
+        compHelp.setMaxParallelJobs(maxJobs);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        return getModelSources(compDynHelp, compHelp);
+    }
+
+    /**
+     * A model with more directions than source generation jobs
+     */
+    template<class T>
+    static std::vector<AD<T> > equations(const std::vector<AD<T> >& u) {
+        AD<T> e = exp(u[0] * u[1]);
+        AD<T> s = sin(u[1] / u[2]);
+
+        std::vector<AD<T> > Z(m);
+        Z[0] = e * s + u[2];
+        Z[1] = e * u[2] * u[2] - s;
+        Z[2] = log(e + s * s) * u[0];
+        Z[3] = u[3] * u[3] * u[4] + cos(u[2]);
+        Z[4] = u[4] / (1.0 + u[3] * u[3]);
+
+        return Z;
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicParallelSourceTest::n = 5;
+const size_t CppADCGDynamicParallelSourceTest::m = 5;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicParallelSourceTest, ForwardOne) {
+    ASSERT_TRUE(_model->isSparseForwardOneAvailable());
+
+    _funD->Forward(0, x);
+
+    vector<double> dy(m);
+    for (size_t j = 0; j < n; j++) {
+        vector<double> dx(n, 0.0);
+        dx[j] = 1.0;
+        vector<double> dyOrig = _funD->Forward(1, dx);
+
+        size_t idx[1] = {j};
+        double tx1[1] = {1.0};
+        _model->ForwardOne(x, 1, idx, tx1, dy);
+
+        ASSERT_TRUE(compareValues(dy, dyOrig));
+    }
+}
+
+TEST_F(CppADCGDynamicParallelSourceTest, ReverseOne) {
+    ASSERT_TRUE(_model->isSparseReverseOneAvailable());
+
+    _funD->Forward(0, x);
+
+    size_t idx[] = {0, 2, 4};
+    double py[] = {1.0, -2.0, 0.5};
+
+    vector<double> w(m, 0.0);
+    w[0] = py[0];
+    w[2] = py[1];
+    w[4] = py[2];
+    vector<double> pxOrig = _funD->Reverse(1, w);
+
+    vector<double> px(n);
+    _model->ReverseOne(x, px, 3, idx, py);
+
+    ASSERT_TRUE(compareValues(px, pxOrig));
+}
+
+TEST_F(CppADCGDynamicParallelSourceTest, ReverseTwo) {
+    ASSERT_TRUE(_model->isSparseReverseTwoAvailable());
+
+    vector<double> w{1.0, 0.5, -2.0, 1.5, -0.5};
+
+    _funD->Forward(0, x);
+
+    vector<double> px2(n);
+    for (size_t j = 0; j < n; j++) {
+        vector<double> dx(n, 0.0);
+        dx[j] = 1.0;
+        _funD->Forward(1, dx);
+        vector<double> pxOrig = _funD->Reverse(2, w);
+
+        size_t idx[1] = {j};
+        double tx1[1] = {1.0};
+        _model->ReverseTwo(x, 1, idx, tx1, px2, w);
+
+        for (size_t k = 0; k < n; k++) {
+            ASSERT_TRUE(nearEqual(px2[k], pxOrig[k * 2 + 1]));
+        }
+    }
+}
+
+TEST_F(CppADCGDynamicParallelSourceTest, SparseJacobian) {
+    vector<double> jacOrig = _funD->Jacobian(x);
+    vector<double> jacCG = _model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
+
+TEST_F(CppADCGDynamicParallelSourceTest, SparseHessian) {
+    vector<double> w{1.0, 0.5, -2.0, 1.5, -0.5};
+
+    vector<double> hessOrig = _funD->Hessian(x, w);
+    vector<double> hessCG = _model->SparseHessian(x, w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
+
+TEST_F(CppADCGDynamicParallelSourceTest, DeterministicSources) {
+    map<string, string> sources1 = generateDirectionalSources(*_fun, 1);
+    map<string, string> sources3 = generateDirectionalSources(*_fun, 3);
+    map<string, string> sources3Again = generateDirectionalSources(*_fun, 3);
+
+    ASSERT_FALSE(sources1.empty());
+    ASSERT_EQ(sources1, sources3);
+    ASSERT_EQ(sources3, sources3Again);
+}
+
+TEST_F(CppADCGDynamicParallelSourceTest, DeterministicSourcesWithAtomics) {
+    /**
+     * an atomic function used by the model
+     */
+    vector<ADCGD> ua{x[0], x[1]};
+    CppAD::Independent(ua);
+    vector<ADCGD> za{exp(ua[0] * ua[1]), ua[0] / ua[1]};
+    ADFun<CGD> funAtomic(ua, za);
+
+    CGAtomicFunBridge<double> atomic("atomic_model", funAtomic, true);
+
+    vector<ADCGD> u(n);
+    for (size_t j = 0; j < n; j++)
+        u[j] = x[j];
+    CppAD::Independent(u);
+
+    vector<ADCGD> a{u[0], u[1]};
+    vector<ADCGD> e(2);
+    atomic(a, e);
+
+    vector<ADCGD> Z(m);
+    Z[0] = e[0] * u[2];
+    Z[1] = e[1] - u[3];
+    Z[2] = e[0] * e[1];
+    Z[3] = u[3] * u[3] * u[4];
+    Z[4] = e[1] * u[4];
+    ADFun<CGD> fun(u, Z);
+
+    map<string, string> sources1 = generateDirectionalSources(fun, 1);
+    map<string, string> sources3 = generateDirectionalSources(fun, 3);
+    map<string, string> sources3Again = generateDirectionalSources(fun, 3);
+
+    ASSERT_FALSE(sources1.empty());
+    ASSERT_EQ(sources1, sources3);
+    ASSERT_EQ(sources3, sources3Again);
+}
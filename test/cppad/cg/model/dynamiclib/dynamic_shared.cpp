@@ -0,0 +1,163 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicSourceTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Tests the directional functions which share the values of the zero
+ * order sweep
+ */
+class CppADCGDynamicSharedTest : public CppADCGDynamicSourceTest {
+protected:
+    const static size_t n;
+    const static size_t m;
+public:
+
+    inline CppADCGDynamicSharedTest(bool verbose = false, bool printValues = false) :
+        CppADCGDynamicSourceTest({0.5, 1.5, 2.0}, verbose, printValues) {
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& u) override {
+        return equations(u);
+    }
+
+    std::vector<AD<double> > model(const std::vector<AD<double> >& u) override {
+        return equations(u);
+    }
+
+protected:
+
+    void prepareSourceGen(ModelCSourceGen<double>& compHelp) override {
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateReverseOne(true);
+        compHelp.setCreateReverseTwo(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setSparseJacobianReuse1stOrderPasses(true);
+        compHelp.setSparseHessianReusesRev2(true);
+        compHelp.setShareZeroOrderSweep(true);
+    }
+
+    /**
+     * A model where all the equations depend on the same expensive
+     * operations
+     */
+    template<class T>
+    static std::vector<AD<T> > equations(const std::vector<AD<T> >& u) {
+        AD<T> e = exp(u[0] * u[1]);
+        AD<T> s = sin(u[1] / u[2]);
+
+        std::vector<AD<T> > Z(m);
+        Z[0] = e * s + u[2];
+        Z[1] = e * u[2] * u[2] - s;
+        Z[2] = log(e + s * s) * u[0];
+
+        return Z;
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicSharedTest::n = 3;
+const size_t CppADCGDynamicSharedTest::m = 3;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicSharedTest, ForwardOne) {
+    ASSERT_TRUE(_model->isSparseForwardOneAvailable());
+
+    _funD->Forward(0, x);
+
+    vector<double> dy(m);
+    for (size_t j = 0; j < n; j++) {
+        vector<double> dx(n, 0.0);
+        dx[j] = 1.0;
+        vector<double> dyOrig = _funD->Forward(1, dx);
+
+        size_t idx[1] = {j};
+        double tx1[1] = {1.0};
+        _model->ForwardOne(x, 1, idx, tx1, dy);
+
+        ASSERT_TRUE(compareValues(dy, dyOrig));
+    }
+}
+
+TEST_F(CppADCGDynamicSharedTest, ReverseOne) {
+    ASSERT_TRUE(_model->isSparseReverseOneAvailable());
+
+    _funD->Forward(0, x);
+
+    size_t idx[] = {0, 2};
+    double py[] = {1.0, -2.0};
+
+    vector<double> w(m, 0.0);
+    w[0] = py[0];
+    w[2] = py[1];
+    vector<double> pxOrig = _funD->Reverse(1, w);
+
+    vector<double> px(n);
+    _model->ReverseOne(x, px, 2, idx, py);
+
+    ASSERT_TRUE(compareValues(px, pxOrig));
+}
+
+TEST_F(CppADCGDynamicSharedTest, ReverseTwo) {
+    ASSERT_TRUE(_model->isSparseReverseTwoAvailable());
+
+    vector<double> w{1.0, 0.5, -2.0};
+
+    _funD->Forward(0, x);
+
+    vector<double> px2(n);
+    for (size_t j = 0; j < n; j++) {
+        vector<double> dx(n, 0.0);
+        dx[j] = 1.0;
+        _funD->Forward(1, dx);
+        vector<double> pxOrig = _funD->Reverse(2, w);
+
+        size_t idx[1] = {j};
+        double tx1[1] = {1.0};
+        _model->ReverseTwo(x, 1, idx, tx1, px2, w);
+
+        for (size_t k = 0; k < n; k++) {
+            ASSERT_TRUE(nearEqual(px2[k], pxOrig[k * 2 + 1]));
+        }
+    }
+}
+
+TEST_F(CppADCGDynamicSharedTest, SparseJacobian) {
+    vector<double> jacOrig = _funD->Jacobian(x);
+    vector<double> jacCG = _model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
+
+TEST_F(CppADCGDynamicSharedTest, SparseHessian) {
+    vector<double> w{1.0, 0.5, -2.0};
+
+    vector<double> hessOrig = _funD->Hessian(x, w);
+    vector<double> hessCG = _model->SparseHessian(x, w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
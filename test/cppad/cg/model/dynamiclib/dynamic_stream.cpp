@@ -0,0 +1,186 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicSourceTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Tests a dynamic library whose source files are compiled while the
+ * remaining source files are still being generated
+ */
+class CppADCGDynamicStreamTest : public CppADCGDynamicSourceTest {
+protected:
+    const static size_t n;
+    const static size_t m;
+public:
+
+    inline CppADCGDynamicStreamTest(bool verbose = false, bool printValues = false) :
+        CppADCGDynamicSourceTest({0.5, 1.5, 2.0, -1.0}, verbose, printValues) {
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& u) override {
+        return equations(u);
+    }
+
+    std::vector<AD<double> > model(const std::vector<AD<double> >& u) override {
+        return equations(u);
+    }
+
+protected:
+
+    void prepareSourceGen(ModelCSourceGen<double>& compHelp) override {
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateForwardOne(true);
+        compHelp.setCreateReverseOne(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+        compHelp.setMaxAssignmentsPerFunc(4); // several source files per function
+        compHelp.setMaxParallelJobs(2);
+    }
+
+    void prepareProcessor(DynamicModelLibraryProcessor<double>& p,
+                          GccCompiler<double>& compiler) override {
+        compiler.setMaxParallelJobs(2);
+        p.setStreamSources(true);
+    }
+
+    template<class T>
+    static std::vector<AD<T> > equations(const std::vector<AD<T> >& u) {
+        AD<T> e = exp(u[0] * u[1]);
+        AD<T> s = sin(u[1] / u[2]);
+
+        std::vector<AD<T> > Z(m);
+        Z[0] = e * s + u[2] * u[3];
+        Z[1] = e * u[2] * u[2] - s;
+        Z[2] = log(e + s * s) * u[0] + cos(u[3]);
+
+        return Z;
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicStreamTest::n = 4;
+const size_t CppADCGDynamicStreamTest::m = 3;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicStreamTest, ForwardZero) {
+    vector<double> yOrig = _funD->Forward(0, x);
+    vector<double> y = _model->ForwardZero(x);
+
+    ASSERT_TRUE(compareValues(y, yOrig));
+}
+
+TEST_F(CppADCGDynamicStreamTest, ReverseOne) {
+    ASSERT_TRUE(_model->isSparseReverseOneAvailable());
+
+    _funD->Forward(0, x);
+
+    size_t idx[] = {0, 2};
+    double py[] = {1.0, -2.0};
+
+    vector<double> w(m, 0.0);
+    w[0] = py[0];
+    w[2] = py[1];
+    vector<double> pxOrig = _funD->Reverse(1, w);
+
+    vector<double> px(n);
+    _model->ReverseOne(x, px, 2, idx, py);
+
+    ASSERT_TRUE(compareValues(px, pxOrig));
+}
+
+TEST_F(CppADCGDynamicStreamTest, SparseJacobian) {
+    vector<double> jacOrig = _funD->Jacobian(x);
+    vector<double> jacCG = _model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
+
+TEST_F(CppADCGDynamicStreamTest, SparseHessian) {
+    vector<double> w{1.0, 0.5, -2.0};
+
+    vector<double> hessOrig = _funD->Hessian(x, w);
+    vector<double> hessCG = _model->SparseHessian(x, w);
+
+    ASSERT_TRUE(compareValues(hessCG, hessOrig));
+}
+
+TEST_F(CppADCGDynamicStreamTest, SourcesUnavailable) {
+    ModelCSourceGen<double> compHelp(*_fun, _modelName);
+    compHelp.setCreateForwardZero(true);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, "cppad_cg_model_streamed");
+    p.setStreamSources(true);
+    p.createDynamicLibrary(compiler, false);
+
+    // the source files were only provided to the compiler
+    ASSERT_THROW(getModelSources(compDynHelp, compHelp), CGException);
+}
+
+TEST_F(CppADCGDynamicStreamTest, DirectExternalModelCalls) {
+    // an outer model which uses the model as an atomic function
+    CGAtomicFunBridge<double> atomic(_modelName, *_fun, true);
+
+    vector<ADCGD> u(n);
+    for (size_t j = 0; j < n; j++)
+        u[j] = x[j];
+    CppAD::Independent(u);
+
+    vector<ADCGD> y(m);
+    atomic(u, y);
+
+    vector<ADCGD> z{y[0] * y[1] + y[2]};
+    ADFun<CGD> funOuter(u, z);
+
+    ModelCSourceGen<double> compHelp(*_fun, _modelName);
+    compHelp.setCreateForwardZero(true);
+
+    ModelCSourceGen<double> compHelpOuter(funOuter, _modelName + "_outer");
+    compHelpOuter.setCreateForwardZero(true);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp, compHelpOuter);
+    compDynHelp.setDirectExternalModelCalls(true);
+
+    DynamicModelLibraryProcessor<double> p(compDynHelp, "cppad_cg_model_streamed_direct");
+    p.setStreamSources(true);
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(_modelName);
+    std::unique_ptr<GenericModel<double>> modelOuter = dynamicLib->model(_modelName + "_outer");
+    modelOuter->addExternalModel(*model);
+
+    vector<double> yOrig = _funD->Forward(0, x);
+    vector<double> zOrig{yOrig[0] * yOrig[1] + yOrig[2]};
+    vector<double> zCG = modelOuter->ForwardZero(x);
+
+    ASSERT_TRUE(compareValues(zCG, zOrig));
+}
@@ -0,0 +1,158 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <thread>
+
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicWorkspaceTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    ADFun<CGD>* _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicWorkspaceTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model"),
+        _fun(nullptr) {
+    }
+
+    virtual void SetUp() {
+        using ADCG = AD<CGD>;
+
+        // independent variables
+        std::vector<ADCG> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = 1.0;
+
+        CppAD::Independent(u);
+
+        // dependent variable vector
+        std::vector<ADCG> Z(m);
+        Z[0] = u[0] * u[1] * sin(u[2]);
+        Z[1] = exp(u[0]) + u[2] * u[2];
+
+        _fun = new ADFun<CGD>(u, Z);
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateSparseJacobian(true);
+        compHelp.setCreateSparseHessian(true);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _dynamicLib->setThreadPoolDisabled(true);
+        _model = _dynamicLib->model(_modelName);
+    }
+
+    virtual void TearDown() {
+        _dynamicLib.reset(nullptr);
+        _model.reset(nullptr);
+        delete _fun;
+        _fun = nullptr;
+    }
+
+    static std::vector<double> point(size_t k) {
+        return std::vector<double>{0.5 + 0.1 * k, 1.5 - 0.2 * k, 0.3 * k};
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGDynamicWorkspaceTest::n = 3;
+const size_t CppADCGDynamicWorkspaceTest::m = 2;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicWorkspaceTest, SingleThread) {
+    const GenericModel<double>& model = *_model;
+    GenericModelWorkspace<double> work = model.createWorkspace();
+
+    std::vector<double> x = point(1);
+    std::vector<double> w{1.0, 2.0};
+
+    std::vector<double> y(m);
+    model.ForwardZero(work, x, y);
+    ASSERT_TRUE(compareValues(y, _model->ForwardZero(x)));
+
+    std::vector<double> jac(m * n);
+    model.SparseJacobian(work, x, jac);
+    ASSERT_TRUE(compareValues(jac, _model->SparseJacobian(x)));
+
+    std::vector<double> hess(n * n);
+    model.SparseHessian(work, x, w, hess);
+    ASSERT_TRUE(compareValues(hess, _model->SparseHessian(x, w)));
+}
+
+TEST_F(CppADCGDynamicWorkspaceTest, MultiThread) {
+    const size_t nThreads = 4;
+    const size_t nRepeat = 1000;
+
+    // expected values determined with the non-reentrant methods
+    std::vector<std::vector<double> > yExpected(nThreads);
+    std::vector<std::vector<double> > jacExpected(nThreads);
+    for (size_t t = 0; t < nThreads; t++) {
+        yExpected[t] = _model->ForwardZero(point(t));
+        jacExpected[t] = _model->SparseJacobian(point(t));
+    }
+
+    const GenericModel<double>& model = *_model;
+    std::vector<std::vector<double> > y(nThreads, std::vector<double>(m));
+    std::vector<std::vector<double> > jac(nThreads, std::vector<double>(m * n));
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; t++) {
+        threads.emplace_back([&, t]() {
+            GenericModelWorkspace<double> work = model.createWorkspace();
+            std::vector<double> x = point(t);
+            for (size_t r = 0; r < nRepeat; r++) {
+                model.ForwardZero(work, x, y[t]);
+                model.SparseJacobian(work, x, jac[t]);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    for (size_t t = 0; t < nThreads; t++) {
+        ASSERT_TRUE(compareValues(y[t], yExpected[t]));
+        ASSERT_TRUE(compareValues(jac[t], jacExpected[t]));
+    }
+}
@@ -0,0 +1,192 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGInterpretedTest : public CppADCGTest {
+protected:
+    const static size_t n;
+    const static size_t m;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::unique_ptr<ADFun<double> > _funD;
+    std::unique_ptr<InterpretedGenericModel<double> > _model;
+public:
+
+    inline CppADCGInterpretedTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues) {
+    }
+
+    virtual void SetUp() {
+        _fun.reset(tape<CGD>());
+        _funD.reset(tape<double>());
+
+        _model.reset(new InterpretedGenericModel<double>(*_fun, "model"));
+    }
+
+    virtual void TearDown() {
+        _model.reset(nullptr);
+        _fun.reset(nullptr);
+        _funD.reset(nullptr);
+    }
+
+    template<class T>
+    static ADFun<T>* tape() {
+        std::vector<AD<T> > u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = 1.0;
+
+        CppAD::Independent(u);
+
+        std::vector<AD<T> > Z(m);
+        Z[0] = u[0] * u[1] * sin(u[2]) + 2.0;
+        Z[1] = exp(u[0]) + u[2] * u[2] / u[1];
+        Z[2] = CondExpLt(u[0], u[1], pow(u[1], 3), log(u[0]) - u[2]);
+        Z[3] = 3.0; // a constant
+        Z[4] = u[3] * sqrt(u[1]) - 2.0 * u[0];
+
+        return new ADFun<T>(u, Z);
+    }
+
+    static std::vector<double> point(size_t k) {
+        return std::vector<double>{0.5 + 0.1 * k, 1.5 - 0.2 * k, 0.3 * k, 2.0};
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGInterpretedTest::n = 4;
+const size_t CppADCGInterpretedTest::m = 5;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGInterpretedTest, ForwardZero) {
+    GenericModel<double>& model = *_model;
+
+    ASSERT_TRUE(model.isForwardZeroAvailable());
+    ASSERT_FALSE(model.isForwardOneAvailable());
+
+    for (size_t k = 0; k < 4; k++) {
+        std::vector<double> x = point(k);
+        ASSERT_TRUE(compareValues(model.ForwardZero(x), _funD->Forward(0, x)));
+    }
+}
+
+TEST_F(CppADCGInterpretedTest, ForwardZeroBatch) {
+    GenericModel<double>& model = *_model;
+
+    const size_t nPoints = 3;
+    std::vector<double> x(n * nPoints);
+    for (size_t p = 0; p < nPoints; p++) {
+        std::vector<double> xp = point(p);
+        for (size_t j = 0; j < n; j++)
+            x[j * nPoints + p] = xp[j];
+    }
+
+    std::vector<double> y(m * nPoints);
+    model.ForwardZeroBatch(nPoints, x, y);
+
+    for (size_t p = 0; p < nPoints; p++) {
+        std::vector<double> yExpected = _funD->Forward(0, point(p));
+        for (size_t i = 0; i < m; i++)
+            ASSERT_TRUE(nearEqual(y[i * nPoints + p], yExpected[i]));
+    }
+}
+
+TEST_F(CppADCGInterpretedTest, Jacobian) {
+    GenericModel<double>& model = *_model;
+
+    ASSERT_TRUE(model.isSparseJacobianAvailable());
+
+    for (size_t k = 0; k < 4; k++) {
+        std::vector<double> x = point(k);
+        std::vector<double> jacExpected = _funD->Jacobian(x);
+
+        ASSERT_TRUE(compareValues(model.SparseJacobian(x), jacExpected));
+
+        std::vector<double> jac;
+        std::vector<size_t> row, col;
+        model.SparseJacobian(x, jac, row, col);
+        ASSERT_EQ(jac.size(), row.size());
+        for (size_t e = 0; e < jac.size(); e++) {
+            ASSERT_TRUE(nearEqual(jac[e], jacExpected[row[e] * n + col[e]]));
+        }
+    }
+
+    // the constant equation is not in the sparsity pattern
+    std::vector<std::set<size_t> > sparsity = model.JacobianSparsitySet();
+    ASSERT_TRUE(sparsity[3].empty());
+}
+
+TEST_F(CppADCGInterpretedTest, Hessian) {
+    GenericModel<double>& model = *_model;
+
+    ASSERT_TRUE(model.isSparseHessianAvailable());
+
+    std::vector<double> w{1.0, 2.0, 0.5, 1.0, -1.0};
+
+    for (size_t k = 0; k < 4; k++) {
+        std::vector<double> x = point(k);
+        std::vector<double> hessExpected = _funD->Hessian(x, w);
+
+        ASSERT_TRUE(compareValues(model.SparseHessian(x, w), hessExpected));
+
+        std::vector<double> hess;
+        std::vector<size_t> row, col;
+        model.SparseHessian(x, w, hess, row, col);
+        ASSERT_EQ(hess.size(), row.size());
+        for (size_t e = 0; e < hess.size(); e++) {
+            ASSERT_TRUE(nearEqual(hess[e], hessExpected[row[e] * n + col[e]]));
+        }
+    }
+}
+
+TEST_F(CppADCGInterpretedTest, Workspace) {
+    const GenericModel<double>& model = *_model;
+    GenericModelWorkspace<double> work = model.createWorkspace();
+
+    std::vector<double> x = point(1);
+    std::vector<double> w{1.0, 2.0, 0.5, 1.0, -1.0};
+
+    std::vector<double> y(m);
+    model.ForwardZero(work, x, y);
+    ASSERT_TRUE(compareValues(y, _funD->Forward(0, x)));
+
+    std::vector<double> jac(m * n);
+    model.SparseJacobian(work, x, jac);
+    ASSERT_TRUE(compareValues(jac, _funD->Jacobian(x)));
+
+    std::vector<double> hess(n * n);
+    model.SparseHessian(work, x, w, hess);
+    ASSERT_TRUE(compareValues(hess, _funD->Hessian(x, w)));
+}
+
+TEST_F(CppADCGInterpretedTest, Program) {
+    const BytecodeProgram<double>& zero = _model->getForwardZeroProgram();
+
+    ASSERT_EQ(zero.getInputSize(), n);
+    ASSERT_EQ(zero.getOutputSize(), m);
+
+    const BytecodeProgram<double>& hess = _model->getSparseHessianProgram();
+    ASSERT_EQ(hess.getInputSizes().size(), 2u);
+    ASSERT_EQ(hess.getInputSize(), n + m);
+}
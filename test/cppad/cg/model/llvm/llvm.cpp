@@ -132,3 +132,134 @@ TEST_F(LlvmModelTest, llvm_externalCompiler) {
     model.reset(nullptr); // must be freed before llvm_shutdown()
     llvmModelLib.reset(nullptr); // must be freed before llvm_shutdown()
 }
+
+#if LLVM_VERSION_MAJOR >= 5
+TEST_F(LlvmModelTest, llvm_jitOptions) {
+    std::vector<double> x(3);
+    x[0] = -1;
+    x[1] = 2;
+    x[2] = 3;
+
+    std::vector<AD<CG<double> > > u(3);
+
+    std::unique_ptr<CppAD::ADFun<CG<Base> > > fun(modelFunc<CG<Base> >(u));
+
+    ModelCSourceGen<double> compHelp(*fun.get(), "mySmallModel");
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateJacobian(true);
+    compHelp.setCreateHessian(true);
+    compHelp.setCreateSparseJacobian(true);
+    compHelp.setCreateSparseHessian(true);
+    compHelp.setCreateForwardOne(true);
+    compHelp.setMultiThreading(false);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+    compDynHelp.setVerbose(this->verbose_);
+    compDynHelp.setMultiThreading(MultiThreadingType::NONE);
+
+    for (size_t k = 0; k < 8; ++k) {
+        unsigned int optLevel = k % 4;
+        bool lazy = k >= 4; // functions only compiled when called
+
+        LlvmJitOptions options = LlvmJitOptions::aggressive();
+        options.setOptimizationLevel(optLevel);
+        options.setLazyCompilation(lazy);
+
+        LlvmModelLibraryProcessor<double> p(compDynHelp);
+        p.setJitOptions(options);
+
+        std::unique_ptr<LlvmModelLibrary<Base> > llvmModelLib = p.create();
+        std::unique_ptr<GenericModel<Base> > model = llvmModelLib->model("mySmallModel");
+        ASSERT_TRUE(model.get() != nullptr);
+
+        this->testModelResults(*llvmModelLib, *model, *fun.get(), x);
+
+        model.reset(nullptr); // must be freed before llvm_shutdown()
+        llvmModelLib.reset(nullptr); // must be freed before llvm_shutdown()
+    }
+}
+
+TEST_F(LlvmModelTest, llvm_objectCache) {
+    std::vector<double> x(3);
+    x[0] = -1;
+    x[1] = 2;
+    x[2] = 3;
+
+    std::vector<AD<CG<double> > > u(3);
+
+    std::unique_ptr<CppAD::ADFun<CG<Base> > > fun(modelFunc<CG<Base> >(u));
+
+    ModelCSourceGen<double> compHelp(*fun.get(), "mySmallModel");
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateJacobian(true);
+    compHelp.setCreateHessian(true);
+    compHelp.setCreateSparseJacobian(true);
+    compHelp.setCreateSparseHessian(true);
+    compHelp.setCreateForwardOne(true);
+    compHelp.setMultiThreading(false);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+    compDynHelp.setVerbose(this->verbose_);
+    compDynHelp.setMultiThreading(MultiThreadingType::NONE);
+
+    LlvmObjectCache cache("cppadcg_llvm_object_cache");
+    cache.clear();
+
+    // the first library is compiled and the second is loaded from the cache
+    for (size_t i = 0; i < 2; ++i) {
+        LlvmModelLibraryProcessor<double> p(compDynHelp);
+        p.setObjectCache(cache);
+
+        std::unique_ptr<LlvmModelLibrary<Base> > llvmModelLib = p.create();
+        ASSERT_EQ(system::listFiles(cache.getFolder()).size(), 1u);
+
+        std::unique_ptr<GenericModel<Base> > model = llvmModelLib->model("mySmallModel");
+        ASSERT_TRUE(model.get() != nullptr);
+
+        this->testModelResults(*llvmModelLib, *model, *fun.get(), x);
+
+        model.reset(nullptr); // must be freed before llvm_shutdown()
+        llvmModelLib.reset(nullptr); // must be freed before llvm_shutdown()
+    }
+
+    cache.clear();
+}
+
+TEST_F(LlvmModelTest, llvm_parallelJobs) {
+    std::vector<double> x(3);
+    x[0] = -1;
+    x[1] = 2;
+    x[2] = 3;
+
+    std::vector<AD<CG<double> > > u(3);
+
+    std::unique_ptr<CppAD::ADFun<CG<Base> > > fun(modelFunc<CG<Base> >(u));
+
+    ModelCSourceGen<double> compHelp(*fun.get(), "mySmallModel");
+    compHelp.setCreateForwardZero(true);
+    compHelp.setCreateJacobian(true);
+    compHelp.setCreateHessian(true);
+    compHelp.setCreateSparseJacobian(true);
+    compHelp.setCreateSparseHessian(true);
+    compHelp.setCreateForwardOne(true);
+    compHelp.setMultiThreading(false);
+
+    ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+    compDynHelp.setVerbose(this->verbose_);
+    compDynHelp.setMultiThreading(MultiThreadingType::NONE);
+
+    for (size_t nJobs : {1, 2, 4}) {
+        LlvmModelLibraryProcessor<double> p(compDynHelp);
+        p.setMaxParallelJobs(nJobs);
+
+        std::unique_ptr<LlvmModelLibrary<Base> > llvmModelLib = p.create();
+        std::unique_ptr<GenericModel<Base> > model = llvmModelLib->model("mySmallModel");
+        ASSERT_TRUE(model.get() != nullptr);
+
+        this->testModelResults(*llvmModelLib, *model, *fun.get(), x);
+
+        model.reset(nullptr); // must be freed before llvm_shutdown()
+        llvmModelLib.reset(nullptr); // must be freed before llvm_shutdown()
+    }
+}
+#endif
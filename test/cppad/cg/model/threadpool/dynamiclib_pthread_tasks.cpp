@@ -0,0 +1,158 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+#include "modelSources.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Tests the zero order forward and dense Jacobian functions which are
+ * split into tasks evaluated by the thread pool
+ */
+class CppADCGPThreadTasksTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    const static size_t n;
+    const static size_t m;
+    std::vector<double> x;
+    std::unique_ptr<ADFun<CGD> > _fun;
+    std::unique_ptr<ADFun<double> > _funD;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+    std::map<std::string, std::string> _sources;
+public:
+
+    inline CppADCGPThreadTasksTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model"),
+        x{0.5, 1.5, 2.0, -1.0, 0.8, 1.2} {
+    }
+
+    virtual void SetUp() {
+        _fun.reset(tape<CGD>(x));
+        _funD.reset(tape<double>(x));
+
+        /**
+         * Create the dynamic library
+         * (generate and compile source code)
+         */
+        ModelCSourceGen<double> compHelp(*_fun, _modelName);
+
+        compHelp.setCreateForwardZero(true);
+        compHelp.setCreateJacobian(true);
+        compHelp.setParallelTasks(4);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+
+        ModelLibraryCSourceGen<double> compDynHelp(compHelp);
+        compDynHelp.setMultiThreading(MultiThreadingType::PTHREADS);
+
+        DynamicModelLibraryProcessor<double> p(compDynHelp);
+
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _dynamicLib->setThreadNumber(3);
+        _model = _dynamicLib->model(_modelName);
+
+        _sources = getModelSources(compDynHelp, compHelp);
+    }
+
+    virtual void TearDown() {
+        _model.reset(nullptr);
+        _dynamicLib.reset(nullptr);
+        _fun.reset(nullptr);
+        _funD.reset(nullptr);
+    }
+
+    /**
+     * A model with several independent chains of operations
+     */
+    template<class T>
+    static ADFun<T>* tape(const std::vector<double>& x) {
+        std::vector<AD<T> > u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<AD<T> > Z(m);
+        for (size_t i = 0; i < m; i++) {
+            AD<T> a = u[i] * u[(i + 1) % n];
+            AD<T> b = exp(a) + sin(u[i]);
+            AD<T> c = cos(b * a) - u[(i + 2) % n] / (1.0 + a * a);
+            Z[i] = log(1.0 + b * b) * c + a;
+        }
+
+        return new ADFun<T>(u, Z);
+    }
+};
+
+/**
+ * static data
+ */
+const size_t CppADCGPThreadTasksTest::n = 6;
+const size_t CppADCGPThreadTasksTest::m = 6;
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGPThreadTasksTest, TaskGraph) {
+    // the functions must have been partitioned into tasks evaluated by the thread pool
+    for (const std::string& file : {"model_forward_zero.c", "model_jacobian.c"}) {
+        ASSERT_TRUE(sourceContains(_sources, file, "cppadcg_thpool_run_task_graph(")) << file;
+        // temporary variable IDs are not reused across tasks
+        ASSERT_TRUE(sourceContains(_sources, file, "malloc(")) << file;
+    }
+}
+
+TEST_F(CppADCGPThreadTasksTest, ForwardZero) {
+    ASSERT_TRUE(_model->isForwardZeroAvailable());
+
+    vector<double> yOrig = _funD->Forward(0, x);
+
+    for (size_t k = 0; k < 100; k++) {
+        vector<double> y = _model->ForwardZero(x);
+        ASSERT_TRUE(compareValues(y, yOrig));
+    }
+}
+
+TEST_F(CppADCGPThreadTasksTest, Jacobian) {
+    ASSERT_TRUE(_model->isJacobianAvailable());
+
+    vector<double> jacOrig = _funD->Jacobian(x);
+
+    for (size_t k = 0; k < 100; k++) {
+        vector<double> jacCG = _model->Jacobian(x);
+        ASSERT_TRUE(compareValues(jacCG, jacOrig));
+    }
+}
+
+TEST_F(CppADCGPThreadTasksTest, Disabled) {
+    _dynamicLib->setThreadPoolDisabled(true);
+
+    vector<double> yOrig = _funD->Forward(0, x);
+    vector<double> y = _model->ForwardZero(x);
+    ASSERT_TRUE(compareValues(y, yOrig));
+
+    vector<double> jacOrig = _funD->Jacobian(x);
+    vector<double> jacCG = _model->Jacobian(x);
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+}
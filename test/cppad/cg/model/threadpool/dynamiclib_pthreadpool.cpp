@@ -109,6 +109,18 @@ TEST_F(CppADCGThreadPoolTest, StaticFullVars) {
     this->testDynamicFull(u, x, 1000);
 }
 
+TEST_F(CppADCGThreadPoolTest, WorkStealingFullVars) {
+    this->_multithreadDisabled = false;
+    this->_multithreadScheduler = ThreadPoolScheduleStrategy::WORK_STEALING;
+
+    this->_reverseOne = true;
+    this->_reverseTwo = true;
+    this->_denseJacobian = false;
+    this->_denseHessian = false;
+
+    this->testDynamicFull(u, x, 1000);
+}
+
 TEST_F(CppADCGThreadPoolTest, DynamicCustomElements) {
     this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
 
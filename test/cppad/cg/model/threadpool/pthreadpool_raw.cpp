@@ -251,4 +251,36 @@ TEST_F(PThreadPoolTest, StaticJac) {
     pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun); // reuse previous work group schedule
 
     ASSERT_TRUE(compareValues(jac, out0));
-}
\ No newline at end of file
+}
+
+TEST_F(PThreadPoolTest, WorkStealingJac) {
+    cppadcg_thpool_set_scheduler_strategy(SCHED_WORK_STEALING);
+
+    pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun); // no elapsed time measurements
+
+    pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun); // uses the elapsed time measurements
+
+    ASSERT_TRUE(compareValues(jac, out0));
+}
+
+TEST_F(PThreadPoolTest, AffinityJac) {
+    cppadcg_thpool_set_scheduler_strategy(SCHED_DYNAMIC);
+
+    cppadcg_thpool_set_affinity(AFFINITY_COMPACT, nullptr, 0);
+    ASSERT_EQ(cppadcg_thpool_get_affinity(), AFFINITY_COMPACT);
+
+    pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun); // threads pinned when created
+
+    ASSERT_TRUE(compareValues(jac, out0));
+
+    int cpus[] = {0};
+    cppadcg_thpool_set_affinity(AFFINITY_EXPLICIT, cpus, 1); // existing threads are pinned again
+    ASSERT_EQ(cppadcg_thpool_get_affinity(), AFFINITY_EXPLICIT);
+
+    pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun);
+
+    ASSERT_TRUE(compareValues(jac, out0));
+
+    cppadcg_thpool_set_affinity(AFFINITY_NONE, nullptr, 0);
+    ASSERT_EQ(cppadcg_thpool_get_affinity(), AFFINITY_NONE);
+}
@@ -0,0 +1,235 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGStrengthReductionTest : public CppADCGTest {
+protected:
+    using CGD = CppADCGTest::CGD;
+public:
+
+    inline CppADCGStrengthReductionTest(bool verbose = false,
+                                        bool printValues = false) :
+        CppADCGTest(verbose, printValues) {
+    }
+
+    std::string generate(bool reduce,
+                         bool strict) {
+        CodeHandler<double> handler;
+        handler.setReduceOperationStrength(reduce);
+        handler.setStrictFloatingPoint(strict);
+
+        std::vector<CGD> x(2);
+        handler.makeVariables(x);
+
+        std::vector<CGD> y(6);
+        y[0] = pow(x[0], 2.0);
+        y[1] = pow(x[1], 3.0);
+        y[2] = x[0] / 4.0;
+        y[3] = x[1] / 3.0;
+        y[4] = pow(x[0], 0.5);
+        y[5] = exp(x[0]) * exp(x[1]);
+
+        return generate(handler, y);
+    }
+
+    std::string generate(CodeHandler<double>& handler,
+                         std::vector<CGD>& y) {
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        if (verbose_) {
+            std::cout << code.str() << std::endl;
+        }
+
+        return code.str();
+    }
+
+    /**
+     * Evaluates the operation graph (after any changes made during the
+     * source code generation)
+     */
+    static std::vector<double> evaluate(CodeHandler<double>& handler,
+                                        const std::vector<CGD>& y,
+                                        const std::vector<double>& x) {
+        Evaluator<double, double, CGD> evaluator(handler);
+
+        std::vector<CGD> xNew(x.begin(), x.end());
+        std::vector<CGD> yNew = evaluator.evaluate(xNew, y);
+
+        std::vector<double> values(yNew.size());
+        for (size_t i = 0; i < yNew.size(); i++)
+            values[i] = yNew[i].getValue();
+        return values;
+    }
+
+    template<class T>
+    static std::vector<T> model(const std::vector<T>& x) {
+        using std::pow;
+        using std::exp;
+
+        std::vector<T> y(9);
+        y[0] = pow(x[0], 2.0);
+        y[1] = pow(x[1], 3.0);
+        y[2] = x[0] / 4.0;
+        y[3] = x[1] / 3.0;
+        y[4] = pow(x[0], 0.5);
+        y[5] = exp(x[0]) * exp(x[1]);
+        y[6] = exp(x[0]) / exp(x[1]);
+        y[7] = pow(x[1], -1.0);
+        y[8] = pow(x[0], -3.0);
+        return y;
+    }
+
+    /**
+     * Evaluates model() after the source code generation
+     */
+    std::vector<double> evaluateModel(bool strict,
+                                      const std::vector<double>& x) {
+        CodeHandler<double> handler;
+        handler.setReduceOperationStrength(true);
+        handler.setStrictFloatingPoint(strict);
+
+        std::vector<CGD> xv(x.size());
+        handler.makeVariables(xv);
+
+        std::vector<CGD> y = model(xv);
+        generate(handler, y);
+
+        return evaluate(handler, y, x);
+    }
+
+    /**
+     * Whether or not two values are exactly the same (including the sign
+     * of zeros and infinities)
+     */
+    static bool identical(double a,
+                          double b) {
+        if (std::isnan(a) || std::isnan(b))
+            return std::isnan(a) && std::isnan(b);
+        return a == b && std::signbit(a) == std::signbit(b);
+    }
+
+    static size_t count(const std::string& text,
+                        const std::string& pattern) {
+        size_t n = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            n++;
+        }
+        return n;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGStrengthReductionTest, Disabled) {
+    std::string code = generate(false, true);
+
+    ASSERT_EQ(count(code, "pow("), 3u);
+    ASSERT_EQ(count(code, " / "), 2u);
+    ASSERT_EQ(count(code, "sqrt("), 0u);
+    ASSERT_EQ(count(code, "exp("), 2u);
+}
+
+TEST_F(CppADCGStrengthReductionTest, Strict) {
+    std::string code = generate(true, true);
+
+    ASSERT_EQ(count(code, "pow("), 2u); // only pow(x, 2) is replaced
+    ASSERT_EQ(count(code, " / "), 1u); // only the division by 4 is replaced
+    ASSERT_EQ(count(code, "sqrt("), 0u);
+    ASSERT_EQ(count(code, "exp("), 2u);
+}
+
+TEST_F(CppADCGStrengthReductionTest, Relaxed) {
+    std::string code = generate(true, false);
+
+    ASSERT_EQ(count(code, "pow("), 0u);
+    ASSERT_EQ(count(code, " / "), 0u);
+    ASSERT_EQ(count(code, "sqrt("), 1u);
+    ASSERT_EQ(count(code, "exp("), 1u);
+}
+
+TEST_F(CppADCGStrengthReductionTest, StrictValues) {
+    std::vector<std::vector<double> > points{{0.7, 1.3},
+                                            {2.5, 0.0},
+                                            {3.0, -0.0},
+                                            {-1.5, -2.0},
+                                            {1e-310, 1e300}}; // subnormal and large values
+
+    for (const std::vector<double>& x : points) {
+        std::vector<double> yOrig = model(x);
+        std::vector<double> y = evaluateModel(true, x);
+
+        ASSERT_EQ(y.size(), yOrig.size());
+        for (size_t i = 0; i < y.size(); i++) {
+            ASSERT_TRUE(identical(y[i], yOrig[i])) << "y[" << i << "] = " << y[i] << " != " << yOrig[i];
+        }
+    }
+}
+
+TEST_F(CppADCGStrengthReductionTest, RelaxedValues) {
+    std::vector<std::vector<double> > points{{0.7, 1.3},
+                                            {2.5, 0.5},
+                                            {3.0, -2.0}};
+
+    for (const std::vector<double>& x : points) {
+        std::vector<double> yOrig = model(x);
+        std::vector<double> y = evaluateModel(false, x);
+
+        ASSERT_EQ(y.size(), yOrig.size());
+        for (size_t i = 0; i < y.size(); i++) {
+            ASSERT_TRUE(nearEqual(y[i], yOrig[i])) << "y[" << i << "] = " << y[i] << " != " << yOrig[i];
+        }
+    }
+}
+
+/**
+ * The same operations are used by functions generated separately with the
+ * same handler (e.g. the directions of the sparse forward mode)
+ */
+TEST_F(CppADCGStrengthReductionTest, SharedOperations) {
+    CodeHandler<double> handler;
+    handler.setReduceOperationStrength(true);
+    handler.setStrictFloatingPoint(false);
+
+    std::vector<CGD> x(3);
+    handler.makeVariables(x);
+
+    CGD e0 = exp(x[0]);
+    CGD e1 = exp(x[1]);
+
+    std::vector<CGD> y0{e0 * e1};
+    std::string code0 = generate(handler, y0);
+    ASSERT_EQ(count(code0, "exp("), 1u);
+
+    std::vector<CGD> y1{e0 * x[2]};
+    generate(handler, y1);
+
+    std::vector<CGD> y{y0[0], y1[0]};
+    std::vector<double> xv{0.3, -0.8, 1.7};
+    std::vector<double> yv = evaluate(handler, y, xv);
+
+    ASSERT_TRUE(nearEqual(yv[0], std::exp(xv[0]) * std::exp(xv[1])));
+    ASSERT_TRUE(nearEqual(yv[1], std::exp(xv[0]) * xv[2]));
+}
@@ -0,0 +1,62 @@
+#ifndef CPPAD_CG_TEST_MODELSOURCES_INCLUDED
+#define CPPAD_CG_TEST_MODELSOURCES_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Provides access to the source files generated for the models of a
+ * library so that tests can inspect them.
+ */
+template<class Base>
+class ModelSourcesProcessor : public ModelLibraryProcessor<Base> {
+public:
+
+    inline explicit ModelSourcesProcessor(ModelLibraryCSourceGen<Base>& modelLibGen) :
+        ModelLibraryProcessor<Base>(modelLibGen) {
+    }
+
+    inline const std::map<std::string, std::string>& getModelSources(ModelCSourceGen<Base>& model) {
+        return this->getSources(model);
+    }
+};
+
+/**
+ * Provides the source files generated for a model
+ * (they are generated if they have not been created yet).
+ */
+template<class Base>
+std::map<std::string, std::string> getModelSources(ModelLibraryCSourceGen<Base>& modelLibGen,
+                                                   ModelCSourceGen<Base>& model) {
+    ModelSourcesProcessor<Base> p(modelLibGen);
+    return p.getModelSources(model);
+}
+
+/**
+ * Determines whether a generated source file contains some text.
+ */
+inline bool sourceContains(const std::map<std::string, std::string>& sources,
+                           const std::string& file,
+                           const std::string& text) {
+    auto it = sources.find(file);
+    return it != sources.end() && it->second.find(text) != std::string::npos;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif